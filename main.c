@@ -45,6 +45,33 @@
 #include "cy_pdl.h"
 #include "cybsp.h"
 #include "cy_retarget_io.h"
+#include "calendar.h"
+#include "rtc_dst_config.h"
+#include "buffer_arena.h"
+#include "stack_monitor.h"
+#include "world_clock.h"
+#include "rtc_timebase.h"
+#include "rtc_ticker.h"
+#include "rtc_snapshot.h"
+#include "rtc_mirror.h"
+#include "schedule.h"
+#include "backup_write.h"
+#include "cycle_counter.h"
+#include "stopwatch.h"
+#include "binary_command.h"
+#include "event_store.h"
+#include "business_calendar.h"
+#include "solar.h"
+#include "posix_time.h"
+#include "time_format.h"
+#include "timestamp_codec.h"
+#include "energy_profile.h"
+#include "ilo_check.h"
+#include "protothread.h"
+#include "app.h"
+#if defined(COMPONENT_FREERTOS)
+#include "rtos_port.h"
+#endif
 #include "string.h"
 #include "time.h"
 #include <inttypes.h>
@@ -54,17 +81,40 @@
 *******************************************************************************/
 #define UART_TIMEOUT_MS (10u)      /* in milliseconds */
 #define INPUT_TIMEOUT_MS (120000u) /* in milliseconds */
+#define FRAME_TIMEOUT_MS (100u)    /* between two bytes of a binary frame */
 
-#define STRING_BUFFER_SIZE (80)
+#if defined(COMPONENT_FREERTOS)
+/* The RTC interrupt notifies the time service task through the kernel API */
+#define RTC_INTR_PRIORITY (RTOS_PORT_ISR_PRIORITY)
+#else
+#define RTC_INTR_PRIORITY (0u)
+#endif
+
+#define STRING_BUFFER_SIZE (BUFFER_ARENA_BLOCK_SIZE)
+
+/* 1: the clock is printed straight from the BCD RTC registers, 0: from the
+   calendar ticker through the date render cache */
+#ifndef DISPLAY_RAW_BCD
+#define DISPLAY_RAW_BCD (0)
+#endif
 
 /* Available commands */
 #define RTC_CMD_SET_DATE_TIME ('1')
 #define RTC_CMD_CONFIG_DST ('2')
+#define RTC_CMD_SHOW_STATUS ('3')
+#define RTC_CMD_WORLD_CLOCK ('4')
+#define RTC_CMD_STOPWATCH ('5')
 
 #define RTC_CMD_ENABLE_DST ('1')
 #define RTC_CMD_DISABLE_DST ('2')
 #define RTC_CMD_QUIT_CONFIG_DST ('3')
 
+#define STOPWATCH_CMD_START_STOP ('s')
+#define STOPWATCH_CMD_LAP ('l')
+#define STOPWATCH_CMD_RESET ('r')
+#define STOPWATCH_CMD_COUNTDOWN ('c')
+#define STOPWATCH_CMD_QUIT ('q')
+
 #define FIXED_DST_FORMAT ('1')
 #define RELATIVE_DST_FORMAT ('2')
 
@@ -75,68 +125,147 @@
 /* Structure tm stores years since 1900 */
 #define TM_YEAR_BASE (1900u)
 
-/* Maximum value of seconds and minutes */
-#define MAX_SEC_OR_MIN (60u)
-
-/* Maximum value of hours definition */
-#define MAX_HOURS_24H (23UL)
-
-/* Month per year definition */
-#define MONTHS_PER_YEAR (12U)
-
-/* Days per week definition */
-#define DAYS_PER_WEEK (7u)
-
-/* Days in month */
-#define DAYS_IN_JANUARY (31U)   /* Number of days in January */
-#define DAYS_IN_FEBRUARY (28U)  /* Number of days in February */
-#define DAYS_IN_MARCH (31U)     /* Number of days in March */
-#define DAYS_IN_APRIL (30U)     /* Number of days in April */
-#define DAYS_IN_MAY (31U)       /* Number of days in May */
-#define DAYS_IN_JUNE (30U)      /* Number of days in June */
-#define DAYS_IN_JULY (31U)      /* Number of days in July */
-#define DAYS_IN_AUGUST (31U)    /* Number of days in August */
-#define DAYS_IN_SEPTEMBER (30U) /* Number of days in September */
-#define DAYS_IN_OCTOBER (31U)   /* Number of days in October */
-#define DAYS_IN_NOVEMBER (30U)  /* Number of days in November */
-#define DAYS_IN_DECEMBER (31U)  /* Number of days in December */
-
 /* Flags to indicate the if the entered time is valid */
 #define DST_DISABLED_FLAG (0)
 #define DST_VALID_START_TIME_FLAG (1)
 #define DST_VALID_END_TIME_FLAG (2)
 #define DST_ENABLED_FLAG (3)
 
-/* Macro to validate seconds parameter */
-#define IS_SEC_VALID(sec) ((sec) <= MAX_SEC_OR_MIN)
+/* Handlers whose peak stack usage is tracked. The main loop entry also holds
+   the interrupts taken outside the handlers. */
+#define HANDLER_MAIN_LOOP (0u)
+#define HANDLER_SET_TIME (1u)
+#define HANDLER_CONFIG_DST (2u)
+#define HANDLER_SHOW_STATUS (3u)
+#define HANDLER_STOPWATCH (4u)
+#define HANDLER_COUNT (5u)
+
+/* Stopwatch and countdown driven from the console menu */
+#define MENU_TIMER_NAME ("console")
+#define SECONDS_PER_MINUTE (60u)
+#define SECONDS_PER_HOUR (3600u)
+#define SECONDS_PER_DAY (86400u)
+#define US_PER_MS (1000u)
+
+/* Resumes of a probe protothread timed by the status command */
+#define PROBE_RESUMES (16u)
+
+/* Stream of the second tick timestamps, about 9 bits per tick: 4 KiB hold
+   about an hour. Read with BINARY_COMMAND_TIMESTAMPS. */
+#ifndef TICK_LOG_BYTES
+#define TICK_LOG_BYTES (4096u)
+#endif
+/* Stream bytes returned per command, after the stream length */
+#define TICK_LOG_CHUNK (BINARY_COMMAND_MAX_PAYLOAD - 1u - 4u)
 
-/* Macro to validate minutes parameters */
-#define IS_MIN_VALID(min) ((min) <= MAX_SEC_OR_MIN)
-
-/* Macro to validate hour parameter */
-#define IS_HOUR_VALID(hour) ((hour) <= MAX_HOURS_24H)
-
-/* Macro to validate month parameter */
-#define IS_MONTH_VALID(month) (((month) > 0U) && ((month) <= MONTHS_PER_YEAR))
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct console_session console_session_t;
 
-/* Macro to validate the year value */
-#define IS_YEAR_VALID(year) ((year) > 0U)
+/* Console flow run as a protothread on the session */
+typedef char (*console_flow_t)(console_session_t *session);
 
-/* Checks whether the year passed through the parameter is leap or not */
-#define IS_LEAP_YEAR(year) \
-(((0U == (year % 4UL)) && (0U != (year % 100UL))) || (0U == (year % 400UL)))
+/* Console input flow in progress. The main loop resumes the flow on every
+   pass and hands it the byte read from the UART, so the scheduler reports and
+   binary frames are served while the user types; the clock line is not
+   redrawn over the echo. The state that has to survive a wait is kept
+   here. */
+struct console_session
+{
+    protothread_t pt;
+    protothread_t input;
+    console_flow_t flow;
+    uint32_t handler;
+    char *buffer;
+    uint32_t length;
+    uint32_t space_count;
+    uint64_t deadline_us;
+    bool has_byte;
+    bool timed_out;
+    uint8_t byte;
+    uint8_t key;
+    uint8_t fmt;
+};
 
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
 static uint32_t century_data = 2000;
 static cy_stc_rtc_config_t current_time;
-/* Variables used to store DST start and end time information */
-static cy_stc_rtc_dst_t dst_time;
+/* Display line, checked out for the lifetime of the application */
+static char *display_buffer;
+/* Variables used to store DST start and end time information. The initial
+   rule is generated from design.modus at build time. */
+static cy_stc_rtc_dst_t dst_time = RTC_DST_CONFIG_INIT;
+/* true while dst_time is the generated rule, whose dates are in the flash
+   table of calendar_get_dst_transition() */
+static bool dst_rule_generated = true;
+/* Set by the DST alarm so that the main loop requeues the next edge from the
+   flash table over the one the PDL derived from the rule */
+static volatile bool dst_requeue = false;
+static uint32_t dst_data_flag = DST_DISABLED_FLAG;
+/* DST state of the RTC: set from the edge the DST alarm is queued for and
+   toggled at each transition. Unlike Cy_RTC_GetDstStatus(), it tells the
+   hour repeated after the DST stop from its first run. */
+static volatile bool dst_active = false;
+/* true while the multi-zone world clock replaces the single-line display */
+static bool world_clock_mode = false;
+/* Set-time or DST flow waiting for console input */
+static console_session_t console_session;
+/* Calendar events started since the main loop last reported them */
+static volatile uint32_t started_events = 0;
+static volatile event_handle_t last_started_event = EVENT_STORE_INVALID;
+/* Solar events reached since the main loop last reported them, one bit each */
+static volatile uint32_t solar_events_reached = 0;
+static const char *const solar_event_names[SOLAR_EVENTS] =
+{
+    "Dawn",
+    "Sunrise",
+    "Sunset",
+    "Dusk",
+};
+#if (SCHEDULE_ENABLE)
+/* Runs of each task of the schedule table */
+static volatile uint32_t schedule_task_runs[SCHEDULE_TASK_COUNT];
+#endif
+/* Cycle count at the last RTC interrupt, until the display catches up */
+static volatile uint32_t rtc_isr_cycles;
+static volatile bool rtc_isr_seen = false;
+/* Cycles from an RTC interrupt to the following display refresh */
+static uint32_t wake_latency_last;
+static uint32_t wake_latency_max;
+/* Calendar ticker resyncs with the RTC registers, and their cycles */
+static uint32_t ticker_syncs;
+static uint64_t ticker_sync_cycles;
+/* Clock text, with its date fields kept for the day */
+static time_format_cache_t clock_cache;
+/* Cycles taken by the clock renders that reused or rewrote the date */
+static uint64_t clock_hit_cycles;
+static uint64_t clock_miss_cycles;
+/* Timestamps of the second ticks, delta-of-delta coded, and the cycles of
+   the appends */
+static uint8_t tick_log_buffer[TICK_LOG_BYTES];
+static timestamp_codec_t tick_log;
+static uint64_t tick_log_cycles;
+static uint32_t tick_log_max;
+/* Peak stack usage of each handler, in bytes; measured on the main stack,
+   so only in the super-loop build (see STACK_MONITOR_ENABLE) */
+static uint32_t handler_stack_peak[HANDLER_COUNT];
+#if (STACK_MONITOR_ENABLE)
+static const char *const handler_names[HANDLER_COUNT] =
+{
+    "Main loop",
+    "Set time",
+    "Configure DST",
+    "Show status",
+    "Stopwatch",
+};
+#endif
 const cy_stc_sysint_t IRQ_CFG_RTC_ALARM2 =
 {
     .intrSrc = ((NvicMux3_IRQn << 16) | srss_interrupt_backup_IRQn),
-    .intrPriority = 0u,
+    .intrPriority = RTC_INTR_PRIORITY,
 };
 
 /*******************************************************************************
@@ -144,15 +273,49 @@ const cy_stc_sysint_t IRQ_CFG_RTC_ALARM2 =
 *******************************************************************************/
 static void handle_error(void);
 static void rtc_isr(void);
-static void construct_time_format(struct tm *time);
-static void set_new_time(uint32_t timeout_ms);
-static bool validate_date_time(uint32_t sec, uint32_t min, uint32_t hour,
-                               uint32_t mday, uint32_t month, uint32_t year);
-static void set_dst_feature(uint32_t timeout_ms);
+static void on_calendar_event(event_handle_t handle, const event_t *event);
+static void on_solar_event(solar_event_t event);
+#if (SCHEDULE_ENABLE)
+static void schedule_task_10ms(void);
+static void schedule_task_100ms(void);
+static void schedule_task_1s(void);
+#endif
+static void construct_time_format(const rtc_snapshot_t *snapshot,
+                                  struct tm *time);
+static void take_snapshot(rtc_snapshot_t *snapshot);
+static bool queue_dst_alarm(void);
+static bool queue_dst_edge(void);
+static bool dst_table_status(const calendar_dst_transition_t *transition);
+static void sync_ticker(void);
+static void print_alarm(const char *name, const cy_stc_rtc_alarm_t *alarm);
+static void format_rtc_bcd(char *dst);
+static void log_tick(void);
+static binary_command_status_t tick_log_command(const uint8_t *payload,
+                                                uint32_t length,
+                                                uint8_t *response,
+                                                uint32_t *response_length);
+#if !(DISPLAY_RAW_BCD)
+static void render_clock(void);
+#endif
+static void start_console_flow(console_session_t *session,
+                               console_flow_t flow, uint32_t handler);
+static void run_console_flow(console_session_t *session);
+static char set_new_time(console_session_t *session);
+static char set_dst_feature(console_session_t *session);
+static bool parse_dst_rule(const console_session_t *session,
+                           cy_stc_rtc_dst_format_t *rule);
+static char read_key(console_session_t *session);
+static char read_line(console_session_t *session);
+static bool next_input(console_session_t *session, uint8_t *value);
+static void show_status(void);
+static char probe_thread(protothread_t *pt);
+static void run_stopwatch(uint32_t timeout_ms);
+static void print_duration(uint64_t duration_us);
+static bool parse_countdown_ms(const char *text, uint64_t *duration_ms);
+static void print_commands(void);
 static cy_rslt_t fetch_time_data(char *buffer,
                                  uint32_t timeout_ms,
                                  uint32_t *space_count);
-static uint32_t get_week_of_month(uint32_t day, uint32_t month, uint32_t year);
 static cy_en_scb_uart_status_t get_character(CySCB_Type * base,
                                              uint8_t *value,
                                              uint32_t timeout);
@@ -165,9 +328,10 @@ static cy_en_scb_uart_status_t get_character(CySCB_Type * base,
 ********************************************************************************
 * Summary:
 *   This function:
-*  - Initializes the device and board peripherals
-*  - Initializes RTC
-*  - The loop checks for the user command and process the commands
+*  - Initializes the device, the board peripherals and RTC
+*  - The loop refreshes the display and checks for the user command
+*  The RTOS port provides its own main() that runs the same steps from the
+*  time service task.
 *
 * Parameters :
 *  void
@@ -176,12 +340,48 @@ static cy_en_scb_uart_status_t get_character(CySCB_Type * base,
 *  int
 *
 *******************************************************************************/
+#if !defined(COMPONENT_FREERTOS)
 int main(void)
 {
-    cy_rslt_t rslt;
     uint8_t cmd;
-    char buffer[STRING_BUFFER_SIZE];
-    struct tm date_time;
+
+    app_init();
+
+    for (;;)
+    {
+        app_refresh();
+
+        /* Check if any command is input */
+        if (CY_SCB_UART_BAD_PARAM != get_character(UART_HW, &cmd,
+                                                   UART_TIMEOUT_MS))
+        {
+            app_input(&cmd);
+        }
+        else
+        {
+            app_input(NULL);
+        }
+    }
+}
+#endif
+
+/*******************************************************************************
+* Function Name: app_init
+********************************************************************************
+* Summary:
+*  Initializes the device and board peripherals, the debug UART, RTC and the
+*  time base, and prints the commands.
+*
+* Parameters :
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_init(void)
+{
+    cy_rslt_t rslt;
 
     /* Initialize the device and board peripherals */
     rslt = cybsp_init();
@@ -190,6 +390,16 @@ int main(void)
         handle_error();
     }
 
+    /* Paint the unused stack for high-water-mark tracking */
+    stack_monitor_init();
+
+    /* The display line buffer stays checked out for good */
+    display_buffer = buffer_arena_checkout();
+    if (NULL == display_buffer)
+    {
+        handle_error();
+    }
+
     /* Initialize retarget-io to use the debug UART port */
     Cy_SCB_UART_Init(UART_HW, &UART_config, NULL);
     Cy_SCB_UART_Enable(UART_HW);
@@ -206,10 +416,6 @@ int main(void)
     /* Enable global interrupts */
     __enable_irq();
 
-    /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    printf("\x1b[2J\x1b[;H");
-    printf("****************** PDL: RTC Basics ******************\r\n\n");
-
     /* Set RTC clock source */
     Cy_RTC_SelectClockSource(CY_RTC_CLK_SELECT_ILO);
 
@@ -230,6 +436,14 @@ int main(void)
         handle_error();
     }
 
+#if !defined(NDEBUG)
+    /* Check the compile-time calendar tables against the PDL results */
+    if (!calendar_self_test())
+    {
+        handle_error();
+    }
+#endif
+
     /* Clear reset reason */
     Cy_SysLib_ClearResetReason();
 
@@ -239,43 +453,252 @@ int main(void)
     IRQn_Type irqn = Cy_SysInt_GetNvicConnection(srss_interrupt_backup_IRQn);
     NVIC_EnableIRQ(irqn);
 
-    /* Display available commands */
-    printf("Available commands \r\n");
-    printf("1 : Set new time and date\r\n");
-    printf("2 : Configure DST feature\r\n\n");
+#if (RTC_DST_BOOT_ENABLE)
+    /* Arm the DST rule from the configuration; no input is needed */
+    rtc_snapshot_t snapshot;
+    take_snapshot(&snapshot);
+    if (!queue_dst_alarm())
+    {
+        handle_error();
+    }
+    dst_data_flag = DST_ENABLED_FLAG;
+    world_clock_set_local_dst_active(dst_active);
+    world_clock_set_local_dst(&dst_time);
+#endif
 
+    /* Measure the ILO so that the first RTC seconds are not nominal */
+    if (ilo_check_run())
+    {
+        rtc_timebase_seed(ilo_check_get_result()->cycles_per_second);
+    }
+    else
+    {
+        printf("ILO out of range, RTC seconds are not reliable\r\n");
+    }
 
-    for (;;)
+    /* The DST alarm and the second tick are committed in one write window */
+    rtc_timebase_start(century_data);
+    if (!backup_write_flush())
+    {
+        handle_error();
+    }
+#if (RTC_MIRROR_DMA)
+    if (!rtc_mirror_init())
+    {
+        handle_error();
+    }
+#endif
+#if (SCHEDULE_ENABLE)
+    /* Same priority as the RTC interrupt, which re-aligns the table */
+    static const schedule_task_t schedule_tasks[SCHEDULE_TASK_COUNT] =
+    {
+        [SCHEDULE_TASK_10MS] = schedule_task_10ms,
+        [SCHEDULE_TASK_100MS] = schedule_task_100ms,
+        [SCHEDULE_TASK_1S] = schedule_task_1s,
+    };
+    if (!schedule_start(schedule_tasks, RTC_INTR_PRIORITY))
+    {
+        handle_error();
+    }
+#endif
+    posix_time_sync();
+    sync_ticker();
+
+#if defined(__NEWLIB__) && !defined(NDEBUG)
+    /* Check the time conversions against the PDL, with the boot DST rule */
+    if (!posix_time_self_test())
     {
-        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        handle_error();
+    }
+#endif
+    stopwatch_register_commands();
+    timestamp_codec_init(&tick_log, tick_log_buffer, sizeof(tick_log_buffer));
+    (void)binary_command_register(BINARY_COMMAND_TIMESTAMPS,
+                                  tick_log_command);
+    event_store_init(on_calendar_event);
+    event_store_register_commands();
+    solar_init(on_solar_event);
+
+    print_commands();
+}
+
+/*******************************************************************************
+* Function Name: app_refresh
+********************************************************************************
+* Summary:
+*  Redraws the current time and prints the countdowns, calendar events and
+*  solar events reported by the RTC interrupt.
+*
+* Parameters :
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_refresh(void)
+{
+    struct tm date_time;
 
-        /* Get current time */
-        Cy_RTC_GetDateAndTime(&current_time);
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
 
-        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    /* Get current time, advanced by the RTC interrupt since the last sync */
+    if (!rtc_ticker_read(&current_time, &date_time))
+    {
+        sync_ticker();
+        (void)rtc_ticker_read(&current_time, &date_time);
+    }
+
+    /* Time from the RTC interrupt to this refresh */
+    if (rtc_isr_seen)
+    {
+        rtc_isr_seen = false;
+        wake_latency_last = cycle_counter_read() - rtc_isr_cycles;
+        if (wake_latency_last > wake_latency_max)
+        {
+            wake_latency_max = wake_latency_last;
+        }
+    }
 
-        /* Construct cy_stc_rtc_config_t to struct tm format */
-        construct_time_format(&date_time);
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
 
+    if (world_clock_mode)
+    {
+        /* All zones are rendered from the single read above */
+        uint32_t stage_start = energy_profile_start();
+        world_clock_refresh(&current_time, century_data);
+        energy_profile_record(ENERGY_STAGE_DISPLAY, stage_start);
+    }
+    else if (NULL == console_session.flow)
+    {
         /* Print current time */
-        strftime(buffer, sizeof(buffer), "%c", &date_time);
-        printf("\r%s", buffer);
-        memset(buffer, '\0', sizeof(buffer));
+        uint32_t stage_start = energy_profile_start();
+#if (DISPLAY_RAW_BCD)
+        format_rtc_bcd(display_buffer);
+        printf("\r%s", display_buffer);
+        memset(display_buffer, '\0', STRING_BUFFER_SIZE);
+#else
+        render_clock();
+        printf("\r%s", clock_cache.text);
+#endif
+        energy_profile_record(ENERGY_STAGE_DISPLAY, stage_start);
+    }
 
-        /* Check if any command is input */
-        rslt = get_character(UART_HW, &cmd, UART_TIMEOUT_MS);
-        if (CY_SCB_UART_BAD_PARAM != rslt)
+    char expired_name[STOPWATCH_NAME_LEN];
+    if (STOPWATCH_INVALID != countdown_take_expired(expired_name))
+    {
+        printf("\r\n[Countdown] %s expired\r\n", expired_name);
+    }
+
+    /* Take the reports of the RTC interrupt */
+    savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t events = started_events;
+    uint32_t solar_events = solar_events_reached;
+    started_events = 0u;
+    solar_events_reached = 0u;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    if (0u != events)
+    {
+        printf("\r\n[Event] %" PRIu32 " started, last %u\r\n",
+               events, (unsigned int)last_started_event);
+    }
+
+    /* The PDL queued the next DST edge from the rule, take it from the table.
+       dst_active is not recomputed: the hour after the stop edge repeats. */
+    if (dst_requeue)
+    {
+        dst_requeue = false;
+        if (!queue_dst_edge() || !backup_write_flush())
         {
-            if (RTC_CMD_SET_DATE_TIME == cmd)
-            {
-                printf("\r[Command] : Set new time\r\n");
-                set_new_time(INPUT_TIMEOUT_MS);
-            }
-            else if (RTC_CMD_CONFIG_DST == cmd)
-            {
-                printf("\r[Command] : Configure DST feature\r\n");
-                set_dst_feature(INPUT_TIMEOUT_MS);
-            }
+            printf("\r\n[DST] next transition not queued\r\n");
+        }
+    }
+
+    /* Recomputes the sunrise and sunset times once per day */
+    solar_update(rtc_timebase_seconds());
+    for (uint32_t i = 0; i < SOLAR_EVENTS; i++)
+    {
+        if (0u != (solar_events & (1UL << i)))
+        {
+            printf("\r\n[Solar] %s\r\n", solar_event_names[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: app_input
+********************************************************************************
+* Summary:
+*  Hands a byte read from the debug UART to the binary frame receiver, the
+*  console flow in progress or the command menu. Also called without a byte,
+*  so that the receiver and the console flow can check their timeouts.
+*
+* Parameters :
+*  const uint8_t *byte : Byte read from the UART, NULL if none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_input(const uint8_t *byte)
+{
+    bool received = (NULL != byte);
+
+    /* Binary frames are served first, also while a console flow runs */
+    if (binary_command_receive(UART_HW, byte, FRAME_TIMEOUT_MS))
+    {
+        received = false;
+    }
+
+    if (NULL != console_session.flow)
+    {
+        console_session.has_byte = received;
+        console_session.byte = received ? *byte : 0u;
+        run_console_flow(&console_session);
+    }
+    else if (received && world_clock_mode)
+    {
+        /* Any key leaves the world clock */
+        world_clock_mode = false;
+        print_commands();
+    }
+    else if (received)
+    {
+        if (RTC_CMD_SET_DATE_TIME == *byte)
+        {
+            printf("\r[Command] : Set new time\r\n");
+            start_console_flow(&console_session, set_new_time,
+                               HANDLER_SET_TIME);
+        }
+        else if (RTC_CMD_CONFIG_DST == *byte)
+        {
+            printf("\r[Command] : Configure DST feature\r\n");
+            start_console_flow(&console_session, set_dst_feature,
+                               HANDLER_CONFIG_DST);
+        }
+        else if (RTC_CMD_SHOW_STATUS == *byte)
+        {
+            printf("\r[Command] : Show status\r\n");
+            /* The main loop and the interrupts between handlers are scanned
+               here, not at each refresh: the stack was repainted by the
+               last handler exit */
+            stack_monitor_exit(&handler_stack_peak[HANDLER_MAIN_LOOP]);
+            stack_monitor_enter();
+            show_status();
+            stack_monitor_exit(&handler_stack_peak[HANDLER_SHOW_STATUS]);
+        }
+        else if (RTC_CMD_WORLD_CLOCK == *byte)
+        {
+            world_clock_mode = true;
+            world_clock_start();
+        }
+        else if (RTC_CMD_STOPWATCH == *byte)
+        {
+            printf("\r[Command] : Stopwatch and countdown\r\n");
+            stack_monitor_enter();
+            run_stopwatch(INPUT_TIMEOUT_MS);
+            stack_monitor_exit(&handler_stack_peak[HANDLER_STOPWATCH]);
         }
     }
 }
@@ -316,326 +739,1705 @@ static void handle_error(void)
 *******************************************************************************/
 static void rtc_isr(void)
 {
+    uint32_t status = Cy_RTC_GetInterruptStatusMasked();
+
+#if (SCHEDULE_ENABLE)
+    /* First, so that the PDL handler does not add to the phase error */
+    if (0u != (status & CY_RTC_INTR_ALARM1))
+    {
+        schedule_align();
+    }
+#endif
+
+    rtc_isr_cycles = cycle_counter_read();
+    rtc_isr_seen = true;
+
     Cy_RTC_Interrupt(&dst_time, true);
+
+    if (0u != (status & CY_RTC_INTR_ALARM1))
+    {
+        rtc_ticker_advance();
+        log_tick();
+#if (RTC_MIRROR_DMA)
+        /* After the PDL handler, so the mirror has any DST change */
+        rtc_mirror_trigger();
+#endif
+    }
+
+    /* A DST transition moved the clock */
+    if (0u != (status & CY_RTC_INTR_ALARM2))
+    {
+        uint32_t stage_start = energy_profile_start();
+        dst_active = !dst_active;
+        world_clock_set_local_dst_active(dst_active);
+        dst_requeue = dst_rule_generated;
+        world_clock_invalidate();
+        rtc_timebase_resync(century_data);
+        sync_ticker();
+        event_store_rearm();
+        solar_invalidate();
+        energy_profile_record(ENERGY_STAGE_DST, stage_start);
+    }
+
+#if defined(COMPONENT_FREERTOS)
+    /* Wake the time service task to refresh the display */
+    rtos_port_notify_from_isr(RTOS_PORT_EVENT_RTC);
+#endif
 }
 
 /*******************************************************************************
-* Function Name: construct_time_format
+* Function Name: on_calendar_event
 ********************************************************************************
 * Summary:
-*  This functions constructs cy_stc_rtc_config_t to struct tm format.
+*  Event store callback, runs in the RTC interrupt. The main loop reports the
+*  events.
 *
-* Parameter:
-*  struct tm *time : time with struct tm format
+* Parameters:
+*  event_handle_t handle : Handle of the event
+*  const event_t *event  : The occurrence that started
 *
 * Return:
 *  void
+*
 *******************************************************************************/
-static void construct_time_format(struct tm *time)
+static void on_calendar_event(event_handle_t handle, const event_t *event)
 {
-    static const uint16_t CUMULATIVE_DAYS[] = {0, 31, 59, 90, 120, 151,
-                                               181, 212, 243, 273, 304, 334};
-    time->tm_sec = current_time.sec;
-    time->tm_min = current_time.min;
-    time->tm_hour = current_time.hour;
-    time->tm_mday = current_time.date;
-    time->tm_mon = (current_time.month - 1u);
-    time->tm_year = (current_time.year + century_data - TM_YEAR_BASE);
-    time->tm_wday = (current_time.dayOfWeek - 1u);
-    time->tm_yday = CUMULATIVE_DAYS[time->tm_mon] + (current_time.date - 1) +
-        (((current_time.month) >= 3 &&
-         (Cy_RTC_IsLeapYear(current_time.year + century_data) ? 1u : 0u)));
-    time->tm_isdst = -1;
+    CY_UNUSED_PARAMETER(event);
+
+    last_started_event = handle;
+    started_events++;
 }
 
 /*******************************************************************************
-* Function Name: set_dst_feature
+* Function Name: on_solar_event
 ********************************************************************************
 * Summary:
-*  This functions takes the user input ,sets the dst start/end date and time,
-*  and then enables the DST feature.
+*  Solar scheduler callback, runs in the RTC interrupt. The main loop reports
+*  the event.
 *
-* Parameter:
-*  uint32_t timeout_ms : Maximum allowed time (in milliseconds) for the
-*  function
+* Parameters:
+*  solar_event_t event : Event reached
 *
 * Return:
 *  void
+*
 *******************************************************************************/
-static void set_dst_feature(uint32_t timeout_ms)
+static void on_solar_event(solar_event_t event)
 {
-    cy_rslt_t rslt;
-    uint8_t dst_cmd;
-    char dst_start_buffer[STRING_BUFFER_SIZE] = {0};
-    char dst_end_buffer[STRING_BUFFER_SIZE] = {0};
-    uint32_t space_count = 0;
-    static uint32_t dst_data_flag = 0;
-
-    /* Variables used to store date and time information */
-    uint32_t mday = 0, month = 0, year = 0, sec = 0, min = 0, hour = 0;
-    uint8_t fmt = 0;
-    if (DST_ENABLED_FLAG == dst_data_flag)
-    {
-        Cy_RTC_GetDateAndTime(&current_time);
-
-        if (Cy_RTC_GetDstStatus(&dst_time, &current_time))
-        {
-            printf("\rCurrent DST Status :: Active\r\n\n");
-        }
-        else
-        {
-            printf("\rCurrent DST Status :: Inactive\r\n\n");
-        }
-    }
-    else
-    {
-        printf("\rCurrent DST Status :: Disabled\r\n\n");
-    }
-
-    /* Display available commands */
-    printf("Available DST commands \r\n");
-    printf("1 : Enable DST feature\r\n");
-    printf("2 : Disable DST feature\r\n");
-    printf("3 : Quit DST Configuration\r\n\n");
-
-    /* Get user input via UART */
-    rslt = get_character(UART_HW, &dst_cmd, timeout_ms);
-
-    if (rslt != CY_SCB_UART_BAD_PARAM)
-    {
-        if (RTC_CMD_ENABLE_DST == dst_cmd)
-        {
-            /* Get DST start time information */
-            printf("Enter DST format \r\n");
-            printf("1 : Fixed DST format\r\n");
-            printf("2 : Relative DST format\r\n\n");
-
-            /* Get user input via UART */
-            rslt = get_character(UART_HW, &fmt, timeout_ms);
-            if (rslt != CY_SCB_UART_BAD_PARAM)
-            {
-                printf("Enter DST start time in \"HH dd mm yyyy\" format\r\n");
-                rslt = fetch_time_data(dst_start_buffer, timeout_ms,
-                                                        &space_count);
-                if (rslt != CY_SCB_UART_BAD_PARAM)
-                {
-                    if (space_count != MIN_SPACE_KEY_COUNT_DST_TIME)
-                    {
-                        printf("\rInvalid values! Please enter "
-                               "the values in specified format\r\n");
-                    }
-                    else
-                    {
-                        sscanf(dst_start_buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "",
-                               &hour, &mday, &month, &year);
-
-                        if ((validate_date_time(sec, min, hour,
-                                                mday, month, year))&&
-                                               ((fmt == FIXED_DST_FORMAT) ||
-                                                (fmt == RELATIVE_DST_FORMAT)))
-                        {
-                            dst_time.startDst.format =
-                            (fmt == FIXED_DST_FORMAT) ? CY_RTC_DST_FIXED :
-                                                        CY_RTC_DST_RELATIVE;
-                            dst_time.startDst.hour = hour;
-                            dst_time.startDst.month = month;
-                            dst_time.startDst.dayOfWeek =
-                            (fmt == FIXED_DST_FORMAT) ?
-                            1 : Cy_RTC_ConvertDayOfWeek(mday, month, year);
-                            dst_time.startDst.dayOfMonth =
-                            (fmt == FIXED_DST_FORMAT) ? mday : 1;
-                            dst_time.startDst.weekOfMonth =
-                            (fmt == FIXED_DST_FORMAT) ?
-                            1 : get_week_of_month(mday, month, year);
-                            /* Update flag value to indicate that a valid
-                               DST start time information has been received*/
-                            dst_data_flag = DST_VALID_START_TIME_FLAG;
-                        }
-                        else
-                        {
-                            printf("\rInvalid values! Please enter "
-                                   "the values in specified format\r\n");
-                        }
-                    }
-                }
-                else
-                {
-                    printf("\rTimeout \r\n");
-                }
-
-                if (DST_VALID_START_TIME_FLAG == dst_data_flag)
-                {
-                    /* Get DST end time information,
-                    iff a valid DST start time information is received */
-                    printf("Enter DST end time "
-                    " in \"HH dd mm yyyy\" format\r\n");
-                    rslt = fetch_time_data(dst_end_buffer, timeout_ms,
-                                            &space_count);
-                    if (rslt != CY_SCB_UART_BAD_PARAM)
-                    {
-                        if (space_count != MIN_SPACE_KEY_COUNT_DST_TIME)
-                        {
-                            printf("\rInvalid values! Please"
-                            "enter the values in specified format\r\n");
-                        }
-                        else
-                        {
-                            sscanf(dst_end_buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "",
-                                   &hour, &mday, &month, &year);
-
-                            if ((validate_date_time(sec, min, hour,
-                                                    mday, month, year))&&
-                                                ((fmt == FIXED_DST_FORMAT) ||
-                                                 (fmt == RELATIVE_DST_FORMAT)))
-                            {
-                                dst_time.stopDst.format =
-                                      (fmt == FIXED_DST_FORMAT)?
-                                       CY_RTC_DST_FIXED : CY_RTC_DST_RELATIVE;
-                                dst_time.stopDst.hour = hour;
-                                dst_time.stopDst.month = month;
-                                dst_time.stopDst.dayOfWeek =
-                                (fmt == FIXED_DST_FORMAT) ?
-                                1 : Cy_RTC_ConvertDayOfWeek(mday, month, year);
-                                dst_time.stopDst.dayOfMonth =
-                                (fmt == FIXED_DST_FORMAT) ? mday : 1;
-                                dst_time.stopDst.weekOfMonth =
-                                (fmt == FIXED_DST_FORMAT) ?
-                                1 : get_week_of_month(mday, month, year);
-                                /* Update flag value to indicate that a valid
-                                 DST end time information has been recieved*/
-                                dst_data_flag = DST_VALID_END_TIME_FLAG;
-                            }
-                            else
-                            {
-                                printf("\rInvalid values! Please enter the "
-                                       " values in specified format\r\n");
-                            }
-                        }
-                    }
-                    else
-                    {
-                        printf("\rTimeout \r\n");
-                    }
-                }
-
-                if (DST_VALID_END_TIME_FLAG == dst_data_flag)
-                {
-                    /* set new DST time */
-                    Cy_RTC_GetDateAndTime(&current_time);
-                    rslt = Cy_RTC_EnableDstTime(&dst_time, &current_time);
-
-                    if (CY_RSLT_SUCCESS == rslt)
-                    {
-                        dst_data_flag = DST_ENABLED_FLAG;
-                        printf("\rDST time updated\r\n\n");
-                    }
-                    else
-                    {
-                        handle_error();
-                    }
-                }
-            }
-            else
-            {
-                printf("\rTimeout \r\n");
-            }
-        }
-        else if (RTC_CMD_DISABLE_DST == dst_cmd)
-        {
-            /* reset dst_time */
-            dst_time.stopDst.format = CY_RTC_DST_FIXED;
-            dst_time.stopDst.hour = 0;
-            dst_time.stopDst.month = 1;
-            dst_time.stopDst.dayOfWeek = 1;
-            dst_time.stopDst.dayOfMonth = 1;
-            dst_time.stopDst.weekOfMonth = 1;
-            dst_time.startDst = dst_time.stopDst;
-
-            /* set DST-disabled time */
-            Cy_RTC_GetDateAndTime(&current_time);
-            rslt = Cy_RTC_EnableDstTime(&dst_time, &current_time);
-
-            if (CY_RSLT_SUCCESS == rslt)
-            {
-                dst_data_flag = DST_DISABLED_FLAG;
-                printf("\rDST feature disabled\r\n\n");
-            }
-            else
-            {
-                handle_error();
-            }
-        }
-        else if (RTC_CMD_QUIT_CONFIG_DST == dst_cmd)
-        {
-            printf("\rExit from DST Configuration \r\n\n");
-        }
-    }
-    else
-    {
-        printf("\rTimeout \r\n");
-    }
+    solar_events_reached |= 1UL << event;
 }
 
+#if (SCHEDULE_ENABLE)
 /*******************************************************************************
-* Function Name: set_new_time
+* Function Name: schedule_task_10ms
 ********************************************************************************
 * Summary:
-*  This functions takes the user input and sets the new date and time.
+*  10 ms task of the schedule table. The tasks run from the counter
+*  interrupt at their offsets within the RTC second. They count their runs;
+*  the product work goes here.
 *
-* Parameter:
-*  uint32_t timeout_ms : Maximum allowed time (in milliseconds) for the
-*  function
+* Parameters:
+*  void
 *
-* Return :
+* Return:
 *  void
+*
 *******************************************************************************/
-static void set_new_time(uint32_t timeout_ms)
+static void schedule_task_10ms(void)
 {
-    cy_rslt_t rslt;
-    char buffer[STRING_BUFFER_SIZE] = {0};
-    uint32_t space_count = 0;
+    schedule_task_runs[SCHEDULE_TASK_10MS]++;
+}
+
+/*******************************************************************************
+* Function Name: schedule_task_100ms
+********************************************************************************
+* Summary:
+*  100 ms task of the schedule table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void schedule_task_100ms(void)
+{
+    schedule_task_runs[SCHEDULE_TASK_100MS]++;
+}
+
+/*******************************************************************************
+* Function Name: schedule_task_1s
+********************************************************************************
+* Summary:
+*  1 s task of the schedule table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void schedule_task_1s(void)
+{
+    schedule_task_runs[SCHEDULE_TASK_1S]++;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: construct_time_format
+********************************************************************************
+* Summary:
+*  This functions constructs the date and time of an RTC snapshot to struct
+*  tm format.
+*
+* Parameter:
+*  const rtc_snapshot_t *snapshot : RTC snapshot with the DST status
+*  struct tm *time                : time with struct tm format
+*
+* Return:
+*  void
+*******************************************************************************/
+static void construct_time_format(const rtc_snapshot_t *snapshot,
+                                  struct tm *time)
+{
+    const cy_stc_rtc_config_t *rtc = &snapshot->date_time;
+
+    time->tm_sec = rtc->sec;
+    time->tm_min = rtc->min;
+    time->tm_hour = rtc->hour;
+    time->tm_mday = rtc->date;
+    time->tm_mon = (rtc->month - 1u);
+    time->tm_year = (rtc->year + century_data - TM_YEAR_BASE);
+    time->tm_wday = (rtc->dayOfWeek - 1u);
+    time->tm_yday = calendar_day_of_year(rtc->date, rtc->month,
+                                         rtc->year + century_data);
+    time->tm_isdst = snapshot->dst_active ? 1 : 0;
+}
+
+/*******************************************************************************
+* Function Name: take_snapshot
+********************************************************************************
+* Summary:
+*  Takes an RTC snapshot with the DST status of the rule in effect, and
+*  copies its date and time to current_time.
+*
+* Parameters:
+*  rtc_snapshot_t *snapshot : Receives the snapshot
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void take_snapshot(rtc_snapshot_t *snapshot)
+{
+    rtc_snapshot_take(snapshot, (DST_ENABLED_FLAG == dst_data_flag) ?
+                                &dst_time : NULL);
+    current_time = snapshot->date_time;
+}
+
+/*******************************************************************************
+* Function Name: queue_dst_alarm
+********************************************************************************
+* Summary:
+*  Queues the DST alarm for dst_time, as Cy_RTC_EnableDstTime() programs it:
+*  the stop edge while DST is active at current_time, the start edge
+*  otherwise, and sets dst_active to match. The generated rule takes its
+*  dates from the flash table; a rule keyed in on the console is resolved at
+*  run time by the PDL. The alarm is committed by the next
+*  backup_write_flush().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool : false if the DST edge is not valid
+*
+*******************************************************************************/
+static bool queue_dst_alarm(void)
+{
+    uint32_t year = current_time.year + century_data;
+    const calendar_dst_transition_t *transition = dst_rule_generated ?
+        calendar_get_dst_transition(year) : NULL;
+
+    dst_active = (NULL == transition) ?
+                 Cy_RTC_GetDstStatus(&dst_time, &current_time) :
+                 dst_table_status(transition);
+
+    return queue_dst_edge();
+}
+
+/*******************************************************************************
+* Function Name: queue_dst_edge
+********************************************************************************
+* Summary:
+*  Queues the DST alarm for the edge that ends the current dst_active state.
+*  The generated rule takes the day from the flash table of the current year,
+*  a rule keyed in on the console is resolved by backup_write_dst_alarm().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool : false if the DST edge is not valid
+*
+*******************************************************************************/
+static bool queue_dst_edge(void)
+{
+    uint32_t year = current_time.year + century_data;
+    const calendar_dst_transition_t *transition = dst_rule_generated ?
+        calendar_get_dst_transition(year) : NULL;
+    const cy_stc_rtc_dst_format_t *edge = dst_active ? &dst_time.stopDst :
+                                                       &dst_time.startDst;
+
+    if (NULL == transition)
+    {
+        return backup_write_dst_alarm(edge, year);
+    }
+
+    return backup_write_dst_alarm_on(edge, dst_active ? transition->stop_mday :
+                                                        transition->start_mday,
+                                     year);
+}
+
+/*******************************************************************************
+* Function Name: dst_table_status
+********************************************************************************
+* Summary:
+*  Tells whether DST is in effect at current_time from the resolved dates of
+*  the year, comparing month, day and hour as Cy_RTC_GetDstStatus() does,
+*  also for a rule whose DST period spans the new year. The RTC runs in
+*  24-hour mode.
+*
+* Parameters:
+*  const calendar_dst_transition_t *transition : Dates of the current year
+*
+* Return:
+*  bool : true if DST is in effect
+*
+*******************************************************************************/
+static bool dst_table_status(const calendar_dst_transition_t *transition)
+{
+    uint32_t now = (current_time.month << 16u) | (current_time.date << 8u) |
+                   current_time.hour;
+    uint32_t start = ((uint32_t)transition->start_month << 16u) |
+                     ((uint32_t)transition->start_mday << 8u) |
+                     transition->start_hour;
+    uint32_t stop = ((uint32_t)transition->stop_month << 16u) |
+                    ((uint32_t)transition->stop_mday << 8u) |
+                    transition->stop_hour;
+
+    return (start < stop) ? ((now >= start) && (now < stop)) :
+                            ((now >= start) || (now < stop));
+}
+
+/*******************************************************************************
+* Function Name: sync_ticker
+********************************************************************************
+* Summary:
+*  Takes an RTC snapshot and hands its date and time, with its struct tm, to
+*  the calendar ticker. The ALARM1 pending status is sampled before and after
+*  the snapshot; if a second edge fell in between, it is not known whether
+*  the snapshot holds it, so the snapshot is taken again. Called at boot,
+*  when the time is set or a DST transition moved the clock, and when the
+*  ticker asks for its periodic resync.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sync_ticker(void)
+{
+    rtc_snapshot_t snapshot;
+    struct tm date_time;
+    uint32_t start = cycle_counter_read();
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t pending;
+
+    /* Edges are a second apart, so this repeats at most once */
+    do
+    {
+        pending = Cy_RTC_GetInterruptStatus() & CY_RTC_INTR_ALARM1;
+        take_snapshot(&snapshot);
+    } while (pending != (Cy_RTC_GetInterruptStatus() & CY_RTC_INTR_ALARM1));
+
+    construct_time_format(&snapshot, &date_time);
+    rtc_ticker_sync(&snapshot.date_time, &date_time, 0u != pending);
+
+    ticker_syncs++;
+    ticker_sync_cycles += cycle_counter_read() - start;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: format_rtc_bcd
+********************************************************************************
+* Summary:
+*  Reads the RTC time and date registers once and writes the "%c" text from
+*  their BCD digits, without the binary conversion of Cy_RTC_GetDateAndTime().
+*  With RTC_MIRROR_DMA, the registers are taken from the RAM mirror.
+*
+* Parameters:
+*  char *dst : TIME_FORMAT_C_LEN + 1 byte buffer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void format_rtc_bcd(char *dst)
+{
+#if (RTC_MIRROR_DMA)
+    /* Copied by the DataWire at the last RTC second, no handshake needed */
+    rtc_mirror_sample_t sample;
+    if (rtc_mirror_read(&sample))
+    {
+        time_format_c_bcd(dst, sample.rtc_time, sample.rtc_date, century_data);
+        return;
+    }
+#endif
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    /* Copies the RTC counters into RTC_TIME and RTC_DATE */
+    Cy_RTC_SyncFromRtc();
+    uint32_t rtc_time = BACKUP_RTC_TIME;
+    uint32_t rtc_date = BACKUP_RTC_DATE;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    time_format_c_bcd(dst, rtc_time, rtc_date, century_data);
+}
+
+/*******************************************************************************
+* Function Name: log_tick
+********************************************************************************
+* Summary:
+*  Appends the time of the second tick to the tick log, from the RTC
+*  interrupt, and counts the cycles of the append. Ticks that do not fit are
+*  counted as dropped by the codec.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void log_tick(void)
+{
+    uint64_t now_us = rtc_timebase_now_us();
+    uint32_t start = cycle_counter_read();
+
+    (void)timestamp_codec_append(&tick_log, now_us);
+
+    uint32_t cycles = cycle_counter_read() - start;
+    tick_log_cycles += cycles;
+    if (cycles > tick_log_max)
+    {
+        tick_log_max = cycles;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tick_log_command
+********************************************************************************
+* Summary:
+*  Binary command handler that reads the tick log. Payload: offset (LE32);
+*  response: complete bytes of the stream (LE32), then up to TICK_LOG_CHUNK
+*  stream bytes from the offset. The bytes are decoded by tools/ts_codec.c;
+*  the stream has no end marker while the log is running.
+*
+* Parameters:
+*  const uint8_t *payload    : Request payload
+*  uint32_t length           : Payload length
+*  uint8_t *response         : Response data
+*  uint32_t *response_length : Number of response bytes
+*
+* Return:
+*  Command status
+*
+*******************************************************************************/
+static binary_command_status_t tick_log_command(const uint8_t *payload,
+                                                uint32_t length,
+                                                uint8_t *response,
+                                                uint32_t *response_length)
+{
+    if (4u != length)
+    {
+        return BINARY_COMMAND_BAD_LENGTH;
+    }
+
+    /* Bytes below used are not written again, so they are copied while the
+       RTC interrupt appends */
+    uint32_t used = tick_log.used;
+    uint32_t offset = (uint32_t)payload[0] | ((uint32_t)payload[1] << 8u) |
+                      ((uint32_t)payload[2] << 16u) |
+                      ((uint32_t)payload[3] << 24u);
+    if (offset > used)
+    {
+        return BINARY_COMMAND_FAILED;
+    }
+
+    uint32_t chunk = used - offset;
+    if (chunk > TICK_LOG_CHUNK)
+    {
+        chunk = TICK_LOG_CHUNK;
+    }
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        response[i] = (uint8_t)(used >> (8u * i));
+    }
+    memcpy(&response[4], &tick_log_buffer[offset], chunk);
+    *response_length = 4u + chunk;
+
+    return BINARY_COMMAND_OK;
+}
+
+#if !(DISPLAY_RAW_BCD)
+/*******************************************************************************
+* Function Name: render_clock
+********************************************************************************
+* Summary:
+*  Renders current_time into the clock cache. The date fields are only
+*  written on a new day; the rest of the day, only "HH:MM:SS" is formatted.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void render_clock(void)
+{
+    calendar_date_time_t date_time =
+    {
+        .year = current_time.year + century_data,
+        .month = current_time.month,
+        .mday = current_time.date,
+        .hour = current_time.hour,
+        .min = current_time.min,
+        .sec = current_time.sec,
+        .wday = current_time.dayOfWeek,
+    };
+
+    uint32_t start = cycle_counter_read();
+    bool hit = time_format_cache_render(&clock_cache, &date_time);
+    uint32_t cycles = cycle_counter_read() - start;
+
+    if (hit)
+    {
+        clock_hit_cycles += cycles;
+    }
+    else
+    {
+        clock_miss_cycles += cycles;
+    }
+}
+#endif
+
+/*******************************************************************************
+* Function Name: start_console_flow
+********************************************************************************
+* Summary:
+*  Starts a console flow on the session and runs it up to its first wait.
+*
+* Parameter:
+*  console_session_t *session : Idle console session
+*  console_flow_t flow        : Flow to run
+*  uint32_t handler           : Index of the flow in handler_stack_peak
+*
+* Return:
+*  void
+*******************************************************************************/
+static void start_console_flow(console_session_t *session,
+                               console_flow_t flow, uint32_t handler)
+{
+    session->buffer = buffer_arena_checkout();
+    if (NULL == session->buffer)
+    {
+        handle_error();
+    }
+
+    PT_INIT(&session->pt);
+    session->flow = flow;
+    session->handler = handler;
+    session->has_byte = false;
+
+    run_console_flow(session);
+}
+
+/*******************************************************************************
+* Function Name: run_console_flow
+********************************************************************************
+* Summary:
+*  Resumes the flow of the session with the byte handed over by the main loop.
+*  The session becomes idle when the flow finishes.
+*
+* Parameter:
+*  console_session_t *session : Session with a flow in progress
+*
+* Return:
+*  void
+*******************************************************************************/
+static void run_console_flow(console_session_t *session)
+{
+    stack_monitor_enter();
+    char state = session->flow(session);
+    stack_monitor_exit(&handler_stack_peak[session->handler]);
+
+    /* A byte the flow did not wait for is dropped */
+    session->has_byte = false;
+
+    if (!PT_SCHEDULE(state))
+    {
+        buffer_arena_return(session->buffer);
+        session->buffer = NULL;
+        session->flow = NULL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: set_dst_feature
+********************************************************************************
+* Summary:
+*  This protothread takes the user input, sets the dst start/end date and time,
+*  and then enables the DST feature.
+*
+* Parameter:
+*  console_session_t *session : Session the flow runs on
+*
+* Return:
+*  PT_WAITING while waiting for input, PT_EXITED or PT_ENDED when done
+*******************************************************************************/
+static char set_dst_feature(console_session_t *session)
+{
+    cy_rslt_t rslt;
+    rtc_snapshot_t snapshot;
+
+    PT_BEGIN(&session->pt);
+
+    if (DST_ENABLED_FLAG == dst_data_flag)
+    {
+        take_snapshot(&snapshot);
+
+        if (snapshot.dst_active)
+        {
+            printf("\rCurrent DST Status :: Active\r\n\n");
+        }
+        else
+        {
+            printf("\rCurrent DST Status :: Inactive\r\n\n");
+        }
+    }
+    else
+    {
+        printf("\rCurrent DST Status :: Disabled\r\n\n");
+    }
+
+    /* Display available commands */
+    printf("Available DST commands \r\n");
+    printf("1 : Enable DST feature\r\n");
+    printf("2 : Disable DST feature\r\n");
+    printf("3 : Quit DST Configuration\r\n\n");
+
+    /* Get user input via UART */
+    PT_SPAWN(&session->pt, &session->input, read_key(session));
+
+    if (session->timed_out)
+    {
+        printf("\rTimeout \r\n");
+    }
+    else if (RTC_CMD_ENABLE_DST == session->key)
+    {
+        /* Get DST start time information */
+        printf("Enter DST format \r\n");
+        printf("1 : Fixed DST format\r\n");
+        printf("2 : Relative DST format\r\n\n");
+
+        /* Get user input via UART */
+        PT_SPAWN(&session->pt, &session->input, read_key(session));
+        if (session->timed_out)
+        {
+            printf("\rTimeout \r\n");
+            PT_EXIT(&session->pt);
+        }
+        session->fmt = session->key;
+
+        printf("Enter DST start time in \"HH dd mm yyyy\" format\r\n");
+        PT_SPAWN(&session->pt, &session->input, read_line(session));
+        if (parse_dst_rule(session, &dst_time.startDst))
+        {
+            /* Update flag value to indicate that a valid
+               DST start time information has been received*/
+            dst_data_flag = DST_VALID_START_TIME_FLAG;
+        }
+
+        if (DST_VALID_START_TIME_FLAG == dst_data_flag)
+        {
+            /* Get DST end time information,
+            iff a valid DST start time information is received */
+            printf("Enter DST end time "
+            " in \"HH dd mm yyyy\" format\r\n");
+            PT_SPAWN(&session->pt, &session->input, read_line(session));
+            if (parse_dst_rule(session, &dst_time.stopDst))
+            {
+                /* Update flag value to indicate that a valid
+                 DST end time information has been recieved*/
+                dst_data_flag = DST_VALID_END_TIME_FLAG;
+            }
+        }
+
+        if (DST_VALID_END_TIME_FLAG == dst_data_flag)
+        {
+            /* set new DST time */
+            dst_rule_generated = false;
+            take_snapshot(&snapshot);
+            rslt = CY_RTC_BAD_PARAM;
+            if (queue_dst_alarm())
+            {
+                /* One write window for the DST alarm and the second tick */
+                rtc_timebase_start(century_data);
+                rslt = backup_write_flush() ? CY_RTC_SUCCESS : CY_RTC_TIMEOUT;
+            }
+
+            if (CY_RSLT_SUCCESS == rslt)
+            {
+                dst_data_flag = DST_ENABLED_FLAG;
+                world_clock_set_local_dst_active(dst_active);
+                world_clock_set_local_dst(&dst_time);
+                time_format_cache_invalidate(&clock_cache);
+                solar_invalidate();
+                posix_time_sync();
+                sync_ticker();
+                printf("\rDST time updated\r\n\n");
+            }
+            else
+            {
+                handle_error();
+            }
+        }
+    }
+    else if (RTC_CMD_DISABLE_DST == session->key)
+    {
+        /* reset dst_time */
+        dst_time.stopDst.format = CY_RTC_DST_FIXED;
+        dst_time.stopDst.hour = 0;
+        dst_time.stopDst.month = 1;
+        dst_time.stopDst.dayOfWeek = 1;
+        dst_time.stopDst.dayOfMonth = 1;
+        dst_time.stopDst.weekOfMonth = 1;
+        dst_time.startDst = dst_time.stopDst;
+        dst_rule_generated = false;
+
+        /* set DST-disabled time */
+        take_snapshot(&snapshot);
+        rslt = CY_RTC_BAD_PARAM;
+        if (queue_dst_alarm())
+        {
+            /* One write window for the DST alarm and the second tick */
+            rtc_timebase_start(century_data);
+            rslt = backup_write_flush() ? CY_RTC_SUCCESS : CY_RTC_TIMEOUT;
+        }
+
+        if (CY_RSLT_SUCCESS == rslt)
+        {
+            dst_data_flag = DST_DISABLED_FLAG;
+            world_clock_set_local_dst_active(false);
+            world_clock_set_local_dst(NULL);
+            time_format_cache_invalidate(&clock_cache);
+            solar_invalidate();
+            posix_time_sync();
+            sync_ticker();
+            printf("\rDST feature disabled\r\n\n");
+        }
+        else
+        {
+            handle_error();
+        }
+    }
+    else if (RTC_CMD_QUIT_CONFIG_DST == session->key)
+    {
+        printf("\rExit from DST Configuration \r\n\n");
+    }
+
+    PT_END(&session->pt);
+}
+
+/*******************************************************************************
+* Function Name: parse_dst_rule
+********************************************************************************
+* Summary:
+*  Parses a DST start or end time read by read_line() in the format chosen
+*  earlier in the session, and fills the rule.
+*
+* Parameter:
+*  const console_session_t *session : Session holding the line and format
+*  cy_stc_rtc_dst_format_t *rule    : DST start or end rule to fill
+*
+* Return:
+*  true if the rule was filled, false on a timeout or invalid values
+*******************************************************************************/
+static bool parse_dst_rule(const console_session_t *session,
+                           cy_stc_rtc_dst_format_t *rule)
+{
+    /* Variables used to store date and time information */
+    uint32_t mday = 0, month = 0, year = 0, hour = 0;
+    uint8_t fmt = session->fmt;
+
+    if (session->timed_out)
+    {
+        printf("\rTimeout \r\n");
+        return false;
+    }
+
+    if (session->space_count != MIN_SPACE_KEY_COUNT_DST_TIME)
+    {
+        printf("\rInvalid values! Please enter "
+               "the values in specified format\r\n");
+        return false;
+    }
+
+    uint32_t stage_start = energy_profile_start();
+    sscanf(session->buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "",
+           &hour, &mday, &month, &year);
+    bool valid = calendar_validate_date_time(0u, 0u, hour, mday, month, year) &&
+                 ((fmt == FIXED_DST_FORMAT) || (fmt == RELATIVE_DST_FORMAT));
+    energy_profile_record(ENERGY_STAGE_PARSE, stage_start);
+
+    if (!valid)
+    {
+        printf("\rInvalid values! Please enter "
+               "the values in specified format\r\n");
+        return false;
+    }
+
+    rule->format = (fmt == FIXED_DST_FORMAT) ? CY_RTC_DST_FIXED :
+                                               CY_RTC_DST_RELATIVE;
+    rule->hour = hour;
+    rule->month = month;
+    rule->dayOfWeek = (fmt == FIXED_DST_FORMAT) ?
+                      1 : calendar_day_of_week(mday, month, year);
+    rule->dayOfMonth = (fmt == FIXED_DST_FORMAT) ? mday : 1;
+    rule->weekOfMonth = (fmt == FIXED_DST_FORMAT) ?
+                        1 : calendar_week_of_month(mday, month, year);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: set_new_time
+********************************************************************************
+* Summary:
+*  This protothread takes the user input and sets the new date and time.
+*
+* Parameter:
+*  console_session_t *session : Session the flow runs on
+*
+* Return :
+*  PT_WAITING while waiting for input, PT_ENDED when done
+*******************************************************************************/
+static char set_new_time(console_session_t *session)
+{
+    cy_rslt_t rslt;
+
+    /* Variables used to store date and time information */
+    uint32_t mday, month, year, sec, min, hour;
+
+    PT_BEGIN(&session->pt);
+
+    printf("\rEnter time in \"HH MM SS dd mm yyyy\" format \r\n");
+    PT_SPAWN(&session->pt, &session->input, read_line(session));
+    if (!session->timed_out)
+    {
+        if (session->space_count != MIN_SPACE_KEY_COUNT_NEW_TIME)
+        {
+            printf("\rInvalid values! Please enter the"
+                    "values in specified format\r\n");
+        }
+        else
+        {
+            uint32_t stage_start = energy_profile_start();
+            sscanf(session->buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "",
+                   &hour, &min, &sec,
+                   &mday, &month, &year);
+            bool valid = calendar_validate_date_time(sec, min, hour,
+                                                     mday, month, year);
+            energy_profile_record(ENERGY_STAGE_PARSE, stage_start);
+
+            if (valid)
+            {
+                backup_write_date_time(sec, min, hour, mday, month, year);
+                rslt = backup_write_flush() ? CY_RTC_SUCCESS : CY_RTC_TIMEOUT;
+
+                century_data = ((year / 100) * 100);
+
+                if (CY_RTC_SUCCESS == rslt)
+                {
+                    /* The DST alarm is not requeued; take the state of the
+                       new time */
+                    rtc_snapshot_t snapshot;
+                    take_snapshot(&snapshot);
+                    dst_active = snapshot.dst_active;
+                    world_clock_set_local_dst_active(dst_active);
+                    world_clock_invalidate();
+                    time_format_cache_invalidate(&clock_cache);
+                    rtc_timebase_resync(century_data);
+                    event_store_rearm();
+                    solar_invalidate();
+                    posix_time_sync();
+                    sync_ticker();
+                    printf("\rRTC time updated\r\n\n");
+                }
+            }
+            else
+            {
+                printf("\rInvalid values! Please enter the values in specified"
+                       " format\r\n");
+            }
+        }
+    }
+    else
+    {
+        printf("\rTimeout \r\n");
+    }
+
+    PT_END(&session->pt);
+}
+
+/*******************************************************************************
+* Function Name: show_status
+********************************************************************************
+* Summary:
+*  Prints the stack size, the peak stack usage of each command handler and the
+*  usage of the buffer arena. The RTOS build shows the headroom of the time
+*  service task stack, which the handlers run on, instead.
+*
+* Parameter:
+*  void
+*
+* Return :
+*  void
+*******************************************************************************/
+static void show_status(void)
+{
+    buffer_arena_stats_t arena_stats;
+#if (STACK_MONITOR_ENABLE)
+    uint32_t stack_size = stack_monitor_size();
+    uint32_t stack_peak = 0;
+
+    printf("\rStack size          : %" PRIu32 " bytes\r\n", stack_size);
+    for (uint32_t i = 0; i < HANDLER_COUNT; i++)
+    {
+        printf("  %-18s: %" PRIu32 " bytes peak\r\n",
+               handler_names[i], handler_stack_peak[i]);
+        if (handler_stack_peak[i] > stack_peak)
+        {
+            stack_peak = handler_stack_peak[i];
+        }
+    }
+    printf("Stack headroom      : %" PRIu32 " bytes\r\n",
+           stack_size - stack_peak);
+#else
+    rtos_port_stats_t task_stats;
+    rtos_port_get_stats(&task_stats);
+    printf("\rStack headroom      : %" PRIu32 " bytes of the time task\r\n",
+           task_stats.stack_free);
+#endif
+
+    buffer_arena_get_stats(&arena_stats);
+    printf("Buffer arena        : %" PRIu32 "/%u in use, %" PRIu32
+           " peak, %" PRIu32 " failed\r\n\n",
+           arena_stats.in_use, BUFFER_ARENA_BLOCKS,
+           arena_stats.peak_in_use, arena_stats.failed_checkouts);
+
+    /* Cost of one interpolated timestamp, as seen by the stopwatches */
+    uint32_t start = cycle_counter_read();
+    (void)rtc_timebase_monotonic_us();
+    uint32_t read_cycles = cycle_counter_read() - start;
+    printf("Timestamp read      : %" PRIu32 " cycles, %" PRIu32
+           " cycles per RTC second\r\n",
+           read_cycles, rtc_timebase_cycles_per_second());
+
+    /* Per RTC second: an advance, plus a share of the resyncs */
+    rtc_ticker_stats_t ticker;
+    rtc_ticker_get_stats(&ticker);
+    uint32_t advance_avg = (0u == ticker.advances) ? 0u :
+        (uint32_t)(ticker.advance_cycles / ticker.advances);
+    uint32_t sync_avg = (0u == ticker_syncs) ? 0u :
+        (uint32_t)(ticker_sync_cycles / ticker_syncs);
+    uint32_t amortised = (0u == ticker.advances) ? 0u :
+        (uint32_t)((ticker.advance_cycles + ticker_sync_cycles) /
+                   ticker.advances);
+    printf("Calendar ticker     : advance %" PRIu32 " cycles (max %" PRIu32
+           "), resync %" PRIu32 " cycles, %" PRIu32 " cycles per second "
+           "amortised, %" PRIu32 " resyncs, %" PRIu32 " corrected\r\n",
+           advance_avg, ticker.advance_max, sync_avg, amortised,
+           ticker.syncs, ticker.corrections);
+
+    /* Clock text through the binary fields and strftime(), against the BCD
+       registers expanded to digits */
+    char clock_text[TIME_FORMAT_C_LEN + 1u];
+    struct tm clock_tm;
+    rtc_snapshot_t snapshot;
+    start = cycle_counter_read();
+    take_snapshot(&snapshot);
+    uint32_t read_rtc_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    construct_time_format(&snapshot, &clock_tm);
+    uint32_t convert_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    strftime(clock_text, sizeof(clock_text), "%c", &clock_tm);
+    uint32_t strftime_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    format_rtc_bcd(clock_text);
+    uint32_t bcd_cycles = cycle_counter_read() - start;
+    printf("Clock text          : read %" PRIu32 " + struct tm %" PRIu32
+           " + strftime %" PRIu32 " cycles, raw BCD %" PRIu32 " cycles%s\r\n",
+           read_rtc_cycles, convert_cycles, strftime_cycles, bcd_cycles,
+           DISPLAY_RAW_BCD ? " (in use)" : "");
+
+    /* One read-sync per snapshot instead of one per PDL getter */
+    rtc_snapshot_stats_t snapshot_stats;
+    rtc_snapshot_get_stats(&snapshot_stats);
+    uint32_t handshake_avg = (0u == snapshot_stats.snapshots) ? 0u :
+        (uint32_t)(snapshot_stats.handshake_cycles / snapshot_stats.snapshots);
+    uint32_t saved = snapshot_stats.snapshots *
+                     (RTC_SNAPSHOT_PDL_HANDSHAKES - 1u);
+    printf("RTC snapshot        : %" PRIu32 " taken, read-sync %" PRIu32
+           " cycles (max %" PRIu32 "), %" PRIu32 " handshakes and %" PRIu32
+           " cycles saved\r\n", snapshot_stats.snapshots, handshake_avg,
+           snapshot_stats.handshake_max, saved, saved * handshake_avg);
+    print_alarm("ALARM1", &snapshot.alarm1);
+    print_alarm("ALARM2", &snapshot.alarm2);
+    printf("  Interrupts: mask 0x%02" PRIX32 ", pending 0x%02" PRIX32
+           ", DST %s\r\n", snapshot.intr_mask, snapshot.intr_status,
+           (DST_ENABLED_FLAG != dst_data_flag) ? "disabled" :
+           (snapshot.dst_active ? "active" : "inactive"));
+
+#if (RTC_MIRROR_DMA)
+    /* RAM mirror kept by the DataWire, against the read-sync handshake */
+    rtc_mirror_stats_t mirror_stats;
+    rtc_mirror_sample_t mirror_sample = { 0u };
+    uint32_t mirror_start = cycle_counter_read();
+    bool mirror_ok = rtc_mirror_read(&mirror_sample);
+    uint32_t mirror_cycles = cycle_counter_read() - mirror_start;
+    rtc_mirror_get_stats(&mirror_stats);
+    printf("RTC mirror          : generation %" PRIu32 "%s, read %" PRIu32
+           " cycles, %" PRIu32 " triggers, %" PRIu32 " skipped, %" PRIu32
+           " of %" PRIu32 " reads failed\r\n", mirror_sample.generation,
+           mirror_ok ? "" : " (not read)", mirror_cycles,
+           mirror_stats.triggers, mirror_stats.skipped,
+           mirror_stats.failures, mirror_stats.reads);
+#endif
+
+#if (SCHEDULE_ENABLE)
+    /* Schedule table: jitter and overruns per task, and the worst slot */
+    static const char *const schedule_task_names[SCHEDULE_TASK_COUNT] =
+    {
+        "10 ms", "100 ms", "1 s",
+    };
+    schedule_stats_t schedule_stats;
+    uint32_t slots;
+    const schedule_entry_t *table = schedule_table_get(&slots);
+    schedule_get_stats(&schedule_stats);
+    printf("Schedule table      : %" PRIu32 " slots, %" PRIu32 " seconds, "
+           "last second %" PRIu32 " ticks, %" PRIu32 " missed, %" PRIu32
+           " overruns\r\n", slots, schedule_stats.seconds,
+           schedule_stats.second_ticks, schedule_stats.missed,
+           schedule_stats.overruns);
+    uint32_t worst_slot = 0u;
+    uint32_t worst_jitter = 0u;
+    for (uint32_t task = 0u; task < SCHEDULE_TASK_COUNT; task++)
+    {
+        schedule_slot_stats_t slot_stats;
+        uint32_t runs = 0u;
+        uint64_t jitter_sum = 0u;
+        uint32_t jitter_max = 0u;
+        uint32_t duration_max = 0u;
+        uint32_t overruns = 0u;
+        for (uint32_t slot = 0u; slot < slots; slot++)
+        {
+            if (task != table[slot].task)
+            {
+                continue;
+            }
+            schedule_get_slot_stats(slot, &slot_stats);
+            runs += slot_stats.runs;
+            jitter_sum += slot_stats.jitter_sum;
+            overruns += slot_stats.overruns;
+            if (slot_stats.jitter_max > jitter_max)
+            {
+                jitter_max = slot_stats.jitter_max;
+            }
+            if (slot_stats.duration_max > duration_max)
+            {
+                duration_max = slot_stats.duration_max;
+            }
+            if (slot_stats.jitter_max > worst_jitter)
+            {
+                worst_jitter = slot_stats.jitter_max;
+                worst_slot = slot;
+            }
+        }
+        printf("  %-6s : %" PRIu32 " runs (%" PRIu32 " counted), jitter avg %"
+               PRIu32 " max %" PRIu32 ", duration max %" PRIu32 " ticks, %"
+               PRIu32 " overruns\r\n", schedule_task_names[task], runs,
+               schedule_task_runs[task],
+               (0u == runs) ? 0u : (uint32_t)(jitter_sum / runs), jitter_max,
+               duration_max, overruns);
+    }
+    printf("  Worst slot %" PRIu32 " at %" PRIu32 " us, jitter %" PRIu32
+           " ticks\r\n", worst_slot, table[worst_slot].offset_us,
+           worst_jitter);
+#endif
+
+    /* Write-sync windows per configuration change, queued against the PDL
+       setters, which open one window each */
+    backup_write_stats_t write_stats;
+    backup_write_get_stats(&write_stats);
+    uint32_t flushes = (0u == write_stats.flushes) ? 1u : write_stats.flushes;
+    printf("Backup writes       : %" PRIu32 " changes, %" PRIu32 " windows"
+           " (PDL setters %" PRIu32 "), %" PRIu32 ".%02" PRIu32 " vs %" PRIu32
+           ".%02" PRIu32 " per change\r\n", write_stats.flushes,
+           write_stats.windows, write_stats.setter_windows,
+           write_stats.windows / flushes,
+           ((write_stats.windows % flushes) * 100u) / flushes,
+           write_stats.setter_windows / flushes,
+           ((write_stats.setter_windows % flushes) * 100u) / flushes);
+    printf("  %" PRIu32 " writes, %" PRIu32 " coalesced, wait %" PRIu32
+           " cycles per change, %" PRIu32 " timeouts\r\n", write_stats.writes,
+           write_stats.coalesced,
+           (uint32_t)(write_stats.wait_cycles / flushes),
+           write_stats.timeouts);
+
+    /* Date render cache of the clock display */
+    uint32_t renders = clock_cache.hits + clock_cache.misses;
+    uint32_t hit_permille = (0u == renders) ? 0u :
+        (uint32_t)(((uint64_t)clock_cache.hits * 1000u) / renders);
+    printf("Date render cache   : %" PRIu32 " hits, %" PRIu32 " misses (%"
+           PRIu32 ".%" PRIu32 "%%), hit %" PRIu32 " cycles, miss %" PRIu32
+           " cycles\r\n", clock_cache.hits, clock_cache.misses,
+           hit_permille / 10u, hit_permille % 10u,
+           (0u == clock_cache.hits) ? 0u :
+               (uint32_t)(clock_hit_cycles / clock_cache.hits),
+           (0u == clock_cache.misses) ? 0u :
+               (uint32_t)(clock_miss_cycles / clock_cache.misses));
+
+    /* Delta-of-delta tick log, copied out of the RTC interrupt's way */
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t log_count = tick_log.count;
+    uint32_t log_dropped = tick_log.dropped;
+    uint64_t log_bits = timestamp_codec_bits(&tick_log);
+    uint64_t log_cycles = tick_log_cycles;
+    uint32_t log_max = tick_log_max;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    uint32_t bits_x100 = (0u == log_count) ? 0u :
+                         (uint32_t)((log_bits * 100u) / log_count);
+    printf("Tick log            : %" PRIu32 " timestamps, %" PRIu32 ".%02"
+           PRIu32 " bits each, %" PRIu32 " of %" PRIu32 " bytes, %" PRIu32
+           " dropped\r\n", log_count, bits_x100 / 100u, bits_x100 % 100u,
+           (uint32_t)((log_bits + 7u) / 8u), (uint32_t)TICK_LOG_BYTES,
+           log_dropped);
+    printf("  append %" PRIu32 " cycles avg, %" PRIu32 " max\r\n",
+           (0u == (log_count + log_dropped)) ? 0u :
+               (uint32_t)(log_cycles / (log_count + log_dropped)), log_max);
+
+    /* Boot estimate of the RTC second against the one measured since */
+    const ilo_check_result_t *ilo = ilo_check_get_result();
+    int64_t measured_cps = (int64_t)rtc_timebase_cycles_per_second();
+    int32_t ilo_error_ppm = (int32_t)((((int64_t)ilo->cycles_per_second -
+                                        measured_cps) * 1000000) /
+                                      measured_cps);
+    printf("ILO boot check      : %" PRIu32 " Hz%s, %" PRIu32 " us, +/-%"
+           PRIu32 " ppm resolution, %" PRId32 " ppm vs RTC second\r\n",
+           ilo->ilo_hz, ilo->valid ? "" : " (rejected)",
+           ilo->duration_cycles / (SystemCoreClock / 1000000u),
+           ilo->resolution_ppm, ilo_error_ppm);
+
+    /* Context switch of a protothread that yields at once, called through a
+       pointer like the console flows */
+    protothread_t probe_pt;
+    char (*volatile resume)(protothread_t *pt) = probe_thread;
+    PT_INIT(&probe_pt);
+    start = cycle_counter_read();
+    for (uint32_t i = 0; i < PROBE_RESUMES; i++)
+    {
+        (void)resume(&probe_pt);
+    }
+    uint32_t resume_cycles = (cycle_counter_read() - start) / PROBE_RESUMES;
+    printf("Protothread resume  : %" PRIu32 " cycles\r\n", resume_cycles);
+
+#if defined(__NEWLIB__)
+    /* POSIX time calls made by linked libraries */
+    struct timeval tv;
+    struct timespec ts;
+    start = cycle_counter_read();
+    (void)time(NULL);
+    uint32_t time_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)gettimeofday(&tv, NULL);
+    uint32_t gettimeofday_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    uint32_t clock_gettime_cycles = cycle_counter_read() - start;
+    printf("POSIX time          : time %" PRIu32 ", gettimeofday %" PRIu32
+           ", clock_gettime %" PRIu32 " cycles\r\n",
+           time_cycles, gettimeofday_cycles, clock_gettime_cycles);
+
+    struct tm tm_probe;
+    time_t now = (time_t)tv.tv_sec;
+    start = cycle_counter_read();
+    (void)gmtime_r(&now, &tm_probe);
+    uint32_t gmtime_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)localtime_r(&now, &tm_probe);
+    uint32_t localtime_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)mktime(&tm_probe);
+    uint32_t mktime_cycles = cycle_counter_read() - start;
+    printf("  gmtime_r %" PRIu32 ", localtime_r %" PRIu32 ", mktime %" PRIu32
+           " cycles\r\n", gmtime_cycles, localtime_cycles, mktime_cycles);
+#endif
+
+    /* Time from an RTC interrupt until its display refresh runs */
+    printf("Wake latency        : %" PRIu32 " cycles last, %" PRIu32
+           " max\r\n", wake_latency_last, wake_latency_max);
+#if defined(COMPONENT_FREERTOS)
+    rtos_port_stats_t rtos_stats;
+    rtos_port_get_stats(&rtos_stats);
+    uint64_t uptime_us = rtc_timebase_monotonic_us();
+    uint32_t residency = (0u == uptime_us) ? 0u :
+        (uint32_t)((rtos_stats.sleep_us * 1000u) / uptime_us);
+    printf("Idle residency      : %" PRIu32 ".%" PRIu32 "%% asleep, %" PRIu32
+           " sleeps, task stack %" PRIu32 " bytes free\r\n",
+           residency / 10u, residency % 10u, rtos_stats.sleeps,
+           rtos_stats.stack_free);
+#else
+    /* The super-loop polls the UART and never sleeps */
+    printf("Idle residency      : 0.0%% asleep\r\n");
+#endif
+    energy_profile_print();
+
+    /* Event store operations, with a probe event after every stored one */
+    event_t probe = { UINT32_MAX - 1u, UINT32_MAX, EVENT_STORE_ONCE };
+    start = cycle_counter_read();
+    event_handle_t handle = event_store_insert(&probe);
+    uint32_t insert_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)event_store_next_after(rtc_timebase_seconds(), NULL);
+    uint32_t next_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)event_store_delete(handle);
+    uint32_t delete_cycles = cycle_counter_read() - start;
+    printf("Event store         : %" PRIu32 "/%u events, insert %" PRIu32
+           ", next %" PRIu32 ", delete %" PRIu32 " cycles\r\n",
+           event_store_count(), EVENT_STORE_CAPACITY,
+           insert_cycles, next_cycles, delete_cycles);
+
+    /* Business-day queries on today; the first call builds the year */
+    uint32_t today = calendar_days_from_epoch(current_time.date,
+                                              current_time.month,
+                                              current_time.year + century_data);
+    start = cycle_counter_read();
+    bool working = business_calendar_is_working_day(today);
+    uint32_t build_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)business_calendar_is_working_day(today);
+    uint32_t is_working_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    (void)business_calendar_next_working_day(today);
+    uint32_t next_working_cycles = cycle_counter_read() - start;
+    start = cycle_counter_read();
+    uint32_t working_days = business_calendar_working_days_between(
+        calendar_days_from_epoch(1u, 1u, current_time.year + century_data),
+        today);
+    uint32_t between_cycles = cycle_counter_read() - start;
+    printf("Business days       : today %s, %" PRIu32 " worked this year\r\n",
+           working ? "working" : "off", working_days);
+    printf("  first query %" PRIu32 ", is working %" PRIu32 ", next %" PRIu32
+           ", between %" PRIu32 " cycles\r\n", build_cycles,
+           is_working_cycles, next_working_cycles, between_cycles);
+
+    /* Weekly alarm schedule, looked up in the compile-time alarm table */
+    uint32_t second_of_week =
+        ((current_time.dayOfWeek - CY_RTC_SUNDAY) * SECONDS_PER_DAY) +
+        (current_time.hour * SECONDS_PER_HOUR) +
+        (current_time.min * SECONDS_PER_MINUTE) + current_time.sec;
+    start = cycle_counter_read();
+    uint32_t next_alarm = calendar_next_alarm(second_of_week);
+    uint32_t next_alarm_cycles = cycle_counter_read() - start;
+    if (CALENDAR_NO_ALARM != next_alarm)
+    {
+        printf("Alarm schedule      : next in %" PRIu32 " d %02" PRIu32 ":%02"
+               PRIu32 ":%02" PRIu32 ", lookup %" PRIu32 " cycles\r\n",
+               next_alarm / SECONDS_PER_DAY,
+               (next_alarm % SECONDS_PER_DAY) / SECONDS_PER_HOUR,
+               (next_alarm % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE,
+               next_alarm % SECONDS_PER_MINUTE, next_alarm_cycles);
+    }
+
+    /* Today's solar events in RTC local time */
+    const solar_day_t *solar_day = solar_get_day();
+    printf("Solar events        :");
+    for (uint32_t i = 0; i < SOLAR_EVENTS; i++)
+    {
+        if (SOLAR_NO_EVENT == solar_day->time[i])
+        {
+            printf(" %s --:--", solar_event_names[i]);
+        }
+        else
+        {
+            uint32_t second_of_day = solar_day->time[i] % SECONDS_PER_DAY;
+            printf(" %s %02" PRIu32 ":%02" PRIu32, solar_event_names[i],
+                   second_of_day / SECONDS_PER_HOUR,
+                   (second_of_day % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+        }
+    }
+    printf("\r\n  daily recompute %" PRIu32 " cycles", solar_recompute_cycles());
+#if !defined(NDEBUG)
+    printf(", max error vs double %" PRIu32 " s",
+           solar_max_error(current_time.year + century_data));
+#endif
+    printf("\r\n\n");
+}
+
+/*******************************************************************************
+* Function Name: print_alarm
+********************************************************************************
+* Summary:
+*  Prints the configuration of an RTC alarm from a snapshot: the fields it
+*  matches, or "every second" when no field is enabled.
+*
+* Parameters:
+*  const char *name                : Alarm name
+*  const cy_stc_rtc_alarm_t *alarm : Alarm configuration
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_alarm(const char *name, const cy_stc_rtc_alarm_t *alarm)
+{
+    bool any = false;
 
-    /* Variables used to store date and time information */
-    uint32_t mday, month, year, sec, min, hour;
+    printf("  %s: %s", name,
+           (CY_RTC_ALARM_ENABLE == alarm->almEn) ? "on" : "off");
+    if (CY_RTC_ALARM_ENABLE == alarm->monthEn)
+    {
+        printf(", month %" PRIu32, alarm->month);
+        any = true;
+    }
+    if (CY_RTC_ALARM_ENABLE == alarm->dateEn)
+    {
+        printf(", date %" PRIu32, alarm->date);
+        any = true;
+    }
+    if (CY_RTC_ALARM_ENABLE == alarm->dayOfWeekEn)
+    {
+        printf(", weekday %" PRIu32, alarm->dayOfWeek);
+        any = true;
+    }
+    if (CY_RTC_ALARM_ENABLE == alarm->hourEn)
+    {
+        printf(", hour %" PRIu32, alarm->hour);
+        any = true;
+    }
+    if (CY_RTC_ALARM_ENABLE == alarm->minEn)
+    {
+        printf(", min %" PRIu32, alarm->min);
+        any = true;
+    }
+    if (CY_RTC_ALARM_ENABLE == alarm->secEn)
+    {
+        printf(", sec %" PRIu32, alarm->sec);
+        any = true;
+    }
+    printf("%s\r\n", any ? "" : ", every second");
+}
 
-    printf("\rEnter time in \"HH MM SS dd mm yyyy\" format \r\n");
-    rslt = fetch_time_data(buffer, timeout_ms, &space_count);
-    if (rslt != CY_SCB_UART_BAD_PARAM)
+/*******************************************************************************
+* Function Name: probe_thread
+********************************************************************************
+* Summary:
+*  Protothread that yields on every call, used to time a resume and return.
+*
+* Parameter:
+*  protothread_t *pt : Protothread state
+*
+* Return:
+*  PT_YIELDED
+*******************************************************************************/
+static char probe_thread(protothread_t *pt)
+{
+    PT_BEGIN(pt);
+
+    for (;;)
     {
-        if (space_count != MIN_SPACE_KEY_COUNT_NEW_TIME)
+        PT_YIELD(pt);
+    }
+
+    PT_END(pt);
+}
+
+/*******************************************************************************
+* Function Name: run_stopwatch
+********************************************************************************
+* Summary:
+*  Shows the console stopwatch and countdown until the user quits or no key is
+*  pressed before the timeout.
+*
+* Parameters:
+*  uint32_t timeout_ms : Time to wait for a key press, in milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_stopwatch(uint32_t timeout_ms)
+{
+    int32_t watch = stopwatch_open(MENU_TIMER_NAME);
+    int32_t timer = countdown_open(MENU_TIMER_NAME);
+    uint32_t idle_ms = 0;
+    uint8_t key = 0;
+
+    if ((STOPWATCH_INVALID == watch) || (STOPWATCH_INVALID == timer))
+    {
+        printf("\rNo free stopwatch or countdown\r\n\n");
+        return;
+    }
+
+    printf("\rs : Start/stop   l : Lap   r : Reset   "
+           "c : Countdown   q : Quit\r\n");
+
+    while ((STOPWATCH_CMD_QUIT != key) && (idle_ms < timeout_ms))
+    {
+        printf("\rStopwatch ");
+        print_duration(stopwatch_elapsed_us(watch));
+        printf("  Countdown ");
+        print_duration(countdown_remaining_us(timer));
+
+        char expired_name[STOPWATCH_NAME_LEN];
+        if (STOPWATCH_INVALID != countdown_take_expired(expired_name))
         {
-            printf("\rInvalid values! Please enter the"
-                    "values in specified format\r\n");
+            printf("\r\n[Countdown] %s expired\r\n", expired_name);
         }
-        else
+
+        if (CY_SCB_UART_BAD_PARAM == get_character(UART_HW, &key,
+                                                   UART_TIMEOUT_MS))
         {
-            sscanf(buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "",
-                   &hour, &min, &sec,
-                   &mday, &month, &year);
+            idle_ms += UART_TIMEOUT_MS;
+            key = 0;
+            continue;
+        }
+        idle_ms = 0;
+
+        if (STOPWATCH_CMD_START_STOP == key)
+        {
+            if (stopwatch_running(watch))
+            {
+                stopwatch_stop(watch);
+            }
+            else
+            {
+                stopwatch_start(watch);
+            }
+        }
+        else if (STOPWATCH_CMD_LAP == key)
+        {
+            uint64_t laps[STOPWATCH_LAPS];
 
-            if (validate_date_time(sec, min, hour, mday, month, year))
+            if (stopwatch_lap(watch))
             {
-                rslt = Cy_RTC_SetDateAndTimeDirect(sec, min, hour,
-                                                   mday, month, year % 100);
+                uint32_t count = stopwatch_get_laps(watch, laps, STOPWATCH_LAPS);
+                printf("\r\nLap ");
+                print_duration(laps[count - 1u]);
+                printf("\r\n");
+            }
+        }
+        else if (STOPWATCH_CMD_RESET == key)
+        {
+            stopwatch_reset(watch);
+        }
+        else if (STOPWATCH_CMD_COUNTDOWN == key)
+        {
+            char *buffer = buffer_arena_checkout();
+            uint32_t space_count = 0;
+            uint64_t duration_ms = 0;
 
-                century_data = ((year / 100) * 100);
+            if (NULL == buffer)
+            {
+                handle_error();
+            }
 
-                if (CY_RTC_SUCCESS == rslt)
+            printf("\r\nEnter countdown in seconds, e.g. 90 or 2.5, "
+                   "0 to cancel\r\n");
+            cy_rslt_t rslt = fetch_time_data(buffer, timeout_ms, &space_count);
+            /* A full buffer is not terminated */
+            buffer[STRING_BUFFER_SIZE - 1u] = '\0';
+            if ((CY_SCB_UART_BAD_PARAM != rslt) &&
+                parse_countdown_ms(buffer, &duration_ms) && (0u != duration_ms))
+            {
+                if (duration_ms > UINT32_MAX)
                 {
-                    printf("\rRTC time updated\r\n\n");
+                    printf("\rCountdown is at most %" PRIu32 ".%03" PRIu32
+                           " seconds\r\n", (uint32_t)COUNTDOWN_MAX_SECONDS,
+                           UINT32_MAX % 1000u);
+                }
+                else if (!countdown_start(timer, (uint32_t)duration_ms))
+                {
+                    printf("\rNo free alarm slot\r\n");
                 }
             }
             else
             {
-                printf("\rInvalid values! Please enter the values in specified"
-                       " format\r\n");
+                countdown_cancel(timer);
             }
+
+            buffer_arena_return(buffer);
         }
     }
-    else
+
+    printf("\r\nExit from stopwatch\r\n\n");
+}
+
+/*******************************************************************************
+* Function Name: print_duration
+********************************************************************************
+* Summary:
+*  Prints a duration as "HH:MM:SS.mmm".
+*
+* Parameters:
+*  uint64_t duration_us : Duration in microseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_duration(uint64_t duration_us)
+{
+    uint32_t seconds = (uint32_t)(duration_us / RTC_TIMEBASE_US_PER_SECOND);
+    uint32_t ms = (uint32_t)(duration_us % RTC_TIMEBASE_US_PER_SECOND) / 1000u;
+
+    printf("%02" PRIu32 ":%02" PRIu32 ":%02" PRIu32 ".%03" PRIu32,
+           seconds / SECONDS_PER_HOUR,
+           (seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE,
+           seconds % SECONDS_PER_MINUTE, ms);
+}
+
+/*******************************************************************************
+* Function Name: parse_countdown_ms
+********************************************************************************
+* Summary:
+*  Parses a countdown entered in seconds, with up to three decimals, e.g.
+*  "90" or "2.5", into milliseconds. A duration over UINT32_MAX ms is
+*  returned as UINT32_MAX + 1, so the caller can reject it.
+*
+* Parameters:
+*  const char *text      : Terminated input, leading spaces allowed
+*  uint64_t *duration_ms : Receives the duration in milliseconds
+*
+* Return:
+*  false if the text is not a duration
+*
+*******************************************************************************/
+static bool parse_countdown_ms(const char *text, uint64_t *duration_ms)
+{
+    const uint64_t too_long = (uint64_t)UINT32_MAX + 1u;
+    uint64_t seconds = 0u;
+    uint32_t ms = 0u;
+    uint32_t scale = 100u;
+    bool digits = false;
+
+    while (' ' == *text)
     {
-        printf("\rTimeout \r\n");
+        text++;
+    }
+
+    for (; ('0' <= *text) && ('9' >= *text); text++)
+    {
+        /* Saturates well below the uint64_t range */
+        if (seconds <= COUNTDOWN_MAX_SECONDS)
+        {
+            seconds = (seconds * 10u) + (uint32_t)(*text - '0');
+        }
+        digits = true;
+    }
+
+    if ('.' == *text)
+    {
+        for (text++; ('0' <= *text) && ('9' >= *text); text++)
+        {
+            if (0u == scale)
+            {
+                return false;
+            }
+            ms += (uint32_t)(*text - '0') * scale;
+            scale /= 10u;
+            digits = true;
+        }
+    }
+
+    while (' ' == *text)
+    {
+        text++;
+    }
+
+    if ((!digits) || ('\0' != *text))
+    {
+        return false;
+    }
+
+    *duration_ms = (seconds > COUNTDOWN_MAX_SECONDS) ? too_long :
+                   (seconds * 1000u) + ms;
+    if (*duration_ms > too_long)
+    {
+        *duration_ms = too_long;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: print_commands
+********************************************************************************
+* Summary:
+*  Clears the terminal and displays the available commands.
+*
+* Parameter:
+*  void
+*
+* Return :
+*  void
+*******************************************************************************/
+static void print_commands(void)
+{
+    /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
+    printf("\x1b[2J\x1b[;H");
+    printf("****************** PDL: RTC Basics ******************\r\n\n");
+
+    /* Display available commands */
+    printf("Available commands \r\n");
+    printf("1 : Set new time and date\r\n");
+    printf("2 : Configure DST feature\r\n");
+    printf("3 : Show status\r\n");
+    printf("4 : World clock\r\n");
+    printf("5 : Stopwatch and countdown\r\n\n");
+}
+
+/*******************************************************************************
+* Function Name: read_key
+********************************************************************************
+* Summary:
+*  Child protothread that waits for one key of the session, without echo.
+*  The key is stored in session->key; session->timed_out is set if no key
+*  arrives within INPUT_TIMEOUT_MS.
+*
+* Parameter:
+*  console_session_t *session : Session the key is read for
+*
+* Return:
+*  PT_WAITING until a key arrives or the timeout expires, then PT_ENDED
+*
+*******************************************************************************/
+static char read_key(console_session_t *session)
+{
+    PT_BEGIN(&session->input);
+
+    session->deadline_us = rtc_timebase_monotonic_us() +
+                           ((uint64_t)INPUT_TIMEOUT_MS * US_PER_MS);
+    PT_WAIT_UNTIL(&session->input, next_input(session, &session->key));
+
+    PT_END(&session->input);
+}
+
+/*******************************************************************************
+* Function Name: read_line
+********************************************************************************
+* Summary:
+*  Child protothread that reads a line entered by the user into the session
+*  buffer, echoing each character and counting the spaces. The whole line has
+*  to be entered within INPUT_TIMEOUT_MS, otherwise session->timed_out is set.
+*
+* Parameter:
+*  console_session_t *session : Session the line is read for
+*
+* Return:
+*  PT_WAITING until the line ends or the timeout expires, then PT_ENDED
+*
+*******************************************************************************/
+static char read_line(console_session_t *session)
+{
+    PT_BEGIN(&session->input);
+
+    session->length = 0u;
+    session->space_count = 0u;
+    session->deadline_us = rtc_timebase_monotonic_us() +
+                           ((uint64_t)INPUT_TIMEOUT_MS * US_PER_MS);
+
+    while (session->length < (STRING_BUFFER_SIZE - 1u))
+    {
+        PT_WAIT_UNTIL(&session->input, next_input(session, &session->key));
+
+        if (session->timed_out ||
+            ('\n' == session->key) || ('\r' == session->key))
+        {
+            break;
+        }
+        else if (' ' == session->key)
+        {
+            session->space_count++;
+        }
+
+        session->buffer[session->length++] = (char)session->key;
+
+        uint32_t stage_start = energy_profile_start();
+        uint32_t count = 0;
+        while (count == 0)
+        {
+            count = Cy_SCB_UART_Put(UART_HW, session->key);
+        }
+        energy_profile_record(ENERGY_STAGE_UART_ECHO, stage_start);
+    }
+
+    session->buffer[session->length] = '\0';
+    printf("\n\r");
+
+    PT_END(&session->input);
+}
+
+/*******************************************************************************
+* Function Name: next_input
+********************************************************************************
+* Summary:
+*  Takes the byte handed to the session by the main loop, or checks whether the
+*  deadline of the current prompt has passed.
+*
+* Parameter:
+*  console_session_t *session : Session waiting for input
+*  uint8_t *value             : Byte taken
+*
+* Return:
+*  true if a byte was taken or the prompt timed out, false to keep waiting
+*
+*******************************************************************************/
+static bool next_input(console_session_t *session, uint8_t *value)
+{
+    if (session->has_byte)
+    {
+        *value = session->byte;
+        session->has_byte = false;
+        session->timed_out = false;
+        return true;
     }
+
+    session->timed_out = (rtc_timebase_monotonic_us() >= session->deadline_us);
+    return session->timed_out;
 }
 
 /*******************************************************************************
@@ -703,96 +2505,6 @@ static cy_rslt_t fetch_time_data(char *buffer, uint32_t timeout_ms,
     return rslt;
 }
 
-/*******************************************************************************
-* Function Name: get_week_of_month
-********************************************************************************
-* Summary:
-*  Returns week number of the month for a year, month, and day that are passed
-*  through parameters.
-*
-* Parameters:
-*  uint32_t day    : The day of the month. Valid range 1..31.
-*  uint32_t month  : The month of the year. Valid range 1..12.
-*  uint32_t year   : The year value. Valid range non-zero value.
-*
-* Return:
-*  Returns the week number of the month (1 to 5).
-*
-*******************************************************************************/
-static uint32_t get_week_of_month(uint32_t day, uint32_t month, uint32_t year)
-{
-    uint32_t count = 1;
-    uint32_t day_of_week = Cy_RTC_ConvertDayOfWeek(1, month, year);
-    uint32_t weekend_day = 8 - day_of_week;
-    while (day > weekend_day)
-    {
-        count++;
-        weekend_day += 7;
-    }
-
-    return count;
-}
-
-/*******************************************************************************
-* Function Name: validate_date_time
-********************************************************************************
-* Summary:
-*  This function validates date and time value.
-*
-* Parameters:
-*  uint32_t sec     : The second valid range is [0-59].
-*  uint32_t min     : The minute valid range is [0-59].
-*  uint32_t hour    : The hour valid range is [0-23].
-*  uint32_t date    : The date valid range is [1-31], if the month of February
-*                     is selected as the Month parameter, then the valid range
-*                     is [0-29].
-*  uint32_t month   : The month valid range is [1-12].
-*  uint32_t year    : The year valid range is [> 0].
-*
-* Return:
-*  false - invalid ; true - valid
-*
-*******************************************************************************/
-static bool validate_date_time(uint32_t sec, uint32_t min, uint32_t hour,
-                               uint32_t mday, uint32_t month, uint32_t year)
-{
-    static const uint8_t days_in_month_table[MONTHS_PER_YEAR] =
-        {
-            DAYS_IN_JANUARY,
-            DAYS_IN_FEBRUARY,
-            DAYS_IN_MARCH,
-            DAYS_IN_APRIL,
-            DAYS_IN_MAY,
-            DAYS_IN_JUNE,
-            DAYS_IN_JULY,
-            DAYS_IN_AUGUST,
-            DAYS_IN_SEPTEMBER,
-            DAYS_IN_OCTOBER,
-            DAYS_IN_NOVEMBER,
-            DAYS_IN_DECEMBER,
-        };
-
-    uint8_t days_in_month;
-
-    bool rslt = IS_SEC_VALID(sec) & IS_MIN_VALID(min) &
-                IS_HOUR_VALID(hour) & IS_MONTH_VALID(month) &
-                IS_YEAR_VALID(year);
-
-    if (rslt)
-    {
-        days_in_month = days_in_month_table[month - 1];
-
-        if (IS_LEAP_YEAR(year) && (month == 2))
-        {
-            days_in_month++;
-        }
-
-        rslt &= (mday > 0U) && (mday <= days_in_month);
-    }
-
-    return rslt;
-}
-
 /*******************************************************************************
 * Function Name: get_character
 ********************************************************************************
@@ -811,6 +2523,12 @@ static cy_en_scb_uart_status_t get_character(CySCB_Type * base,
                                              uint8_t *value,
                                              uint32_t timeout)
 {
+#if defined(COMPONENT_FREERTOS)
+    /* The RX interrupt of the RTOS port queues the bytes; block on the queue */
+    (void)base;
+    return rtos_port_get_character(value, timeout) ? CY_SCB_UART_SUCCESS :
+                                                     CY_SCB_UART_BAD_PARAM;
+#else
     /* Get character via UART */
     uint32_t read_value = Cy_SCB_UART_Get(base);
     uint32_t timeoutTicks = timeout;
@@ -834,6 +2552,7 @@ static cy_en_scb_uart_status_t get_character(CySCB_Type * base,
     }
     *value = (uint8_t)read_value;
     return CY_SCB_UART_SUCCESS;
+#endif
 }
 
 /* [] END OF FILE */
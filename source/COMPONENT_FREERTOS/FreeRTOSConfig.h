@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name:   FreeRTOSConfig.h
+*
+* Description: FreeRTOS kernel configuration of the RTOS port. Static
+*              allocation only, and a tickless idle provided by rtos_port.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* The assemblers of some toolchains include this file */
+#if !defined(__IASMARM__) && !defined(__ASSEMBLER__)
+#include "cy_pdl.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scheduler */
+#define configUSE_PREEMPTION                    (1)
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION (1)
+#define configCPU_CLOCK_HZ                      (SystemCoreClock)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    (4)
+#define configMINIMAL_STACK_SIZE                ((uint16_t)128)
+#define configMAX_TASK_NAME_LEN                 (12)
+#define configUSE_16_BIT_TICKS                  (0)
+#define configIDLE_SHOULD_YIELD                 (1)
+#define configUSE_TASK_NOTIFICATIONS            (1)
+/* Events of the time service task, and its TX drain (rtos_port.c) */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   (2)
+#define configUSE_MUTEXES                       (0)
+#define configUSE_RECURSIVE_MUTEXES             (0)
+#define configUSE_COUNTING_SEMAPHORES           (0)
+#define configQUEUE_REGISTRY_SIZE               (0)
+#define configUSE_QUEUE_SETS                    (0)
+#define configUSE_TIME_SLICING                  (0)
+#define configUSE_NEWLIB_REENTRANT              (0)
+#define configENABLE_BACKWARD_COMPATIBILITY     (0)
+
+/* Memory: every kernel object is allocated statically, like the buffers of
+   the application */
+#define configSUPPORT_STATIC_ALLOCATION         (1)
+#define configSUPPORT_DYNAMIC_ALLOCATION        (0)
+#define configTOTAL_HEAP_SIZE                   (0)
+
+/* Hooks */
+#define configUSE_IDLE_HOOK                     (0)
+#define configUSE_TICK_HOOK                     (0)
+#define configCHECK_FOR_STACK_OVERFLOW          (2)
+#define configUSE_MALLOC_FAILED_HOOK            (0)
+
+/* Software timers are not used; the RTC alarm scheduler runs the timeouts */
+#define configUSE_TIMERS                        (0)
+#define configUSE_CO_ROUTINES                   (0)
+
+/* API functions */
+#define INCLUDE_vTaskDelay                      (1)
+#define INCLUDE_vTaskSuspend                    (1)
+#define INCLUDE_xTaskGetCurrentTaskHandle       (1)
+#define INCLUDE_uxTaskGetStackHighWaterMark     (1)
+#define INCLUDE_xTaskGetSchedulerState          (1)
+#define INCLUDE_vTaskDelete                     (0)
+
+/* Tickless idle: the port stops SysTick and sleeps until the next kernel
+   deadline or interrupt, at the latest the next RTC second */
+#define configUSE_TICKLESS_IDLE                 (2)
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   (2)
+#define portSUPPRESS_TICKS_AND_SLEEP(idle_ticks) \
+    rtos_port_suppress_ticks_and_sleep(idle_ticks)
+
+/* Interrupt priorities: __NVIC_PRIO_BITS levels, 0 is the highest. Interrupts
+   that use the kernel API are at configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+   or lower. */
+#define configPRIO_BITS                              (__NVIC_PRIO_BITS)
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY      ((1u << configPRIO_BITS) - 1u)
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY (3u)
+#define configKERNEL_INTERRUPT_PRIORITY \
+    (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8u - configPRIO_BITS))
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY \
+    (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8u - configPRIO_BITS))
+
+#define configASSERT(x) CY_ASSERT(x)
+
+/* Kernel handlers under their CMSIS names */
+#define vPortSVCHandler     SVC_Handler
+#define xPortPendSVHandler  PendSV_Handler
+#define xPortSysTickHandler SysTick_Handler
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if !defined(__IASMARM__) && !defined(__ASSEMBLER__)
+void rtos_port_suppress_ticks_and_sleep(uint32_t idle_ticks);
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
+
+/* [] END OF FILE */
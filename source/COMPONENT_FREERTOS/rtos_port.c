@@ -0,0 +1,555 @@
+/******************************************************************************
+* File Name:   rtos_port.c
+*
+* Description: FreeRTOS port of the application. The time service task runs
+*              the steps of the bare-metal super-loop, woken by a task notification
+*              from the RTC interrupt or the UART RX interrupt instead of polling.
+*              UART bytes pass through queues, and the idle task sleeps with
+*              SysTick stopped until the next kernel deadline or interrupt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "app.h"
+#include "rtos_port.h"
+#include "rtc_timebase.h"
+#include "binary_command.h"
+#include "energy_profile.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TIME_TASK_NAME ("time")
+/* The status command formats its report with printf */
+#define TIME_TASK_STACK_WORDS (2048u)
+#define TIME_TASK_PRIORITY (configMAX_PRIORITIES - 1u)
+
+#define RX_QUEUE_LENGTH (64u)
+#define TX_QUEUE_LENGTH (64u)
+
+/* Wake-up period while a binary frame is incomplete, so that its timeout is
+   checked without input */
+#define FRAME_POLL_MS (20u)
+
+/* Notification indexes of the time service task. The task loop waits for
+   the events on one and rtos_port_write() for the TX drain on the other, so
+   that neither wait takes the notification of the other. */
+#define NOTIFY_INDEX_EVENTS (0u)
+#define NOTIFY_INDEX_TX (1u)
+
+/* CPU interrupt the UART is routed to */
+#define UART_NVIC_MUX (NvicMux4_IRQn)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static TaskHandle_t time_task;
+static StaticTask_t time_task_tcb;
+static StackType_t time_task_stack[TIME_TASK_STACK_WORDS];
+
+static StaticTask_t idle_task_tcb;
+static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+
+static QueueHandle_t rx_queue;
+static StaticQueue_t rx_queue_control;
+static uint8_t rx_queue_storage[RX_QUEUE_LENGTH];
+
+static QueueHandle_t tx_queue;
+static StaticQueue_t tx_queue_control;
+static uint8_t tx_queue_storage[TX_QUEUE_LENGTH];
+
+/* Tickless idle statistics */
+static uint64_t sleep_cycles;
+static uint32_t sleep_count;
+
+static const cy_stc_sysint_t IRQ_CFG_UART =
+{
+    .intrSrc = ((UART_NVIC_MUX << 16) | UART_IRQ),
+    .intrPriority = RTOS_PORT_ISR_PRIORITY,
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void time_service_task(void *arg);
+static void uart_start(void);
+static void uart_isr(void);
+static void notify(UBaseType_t index, uint32_t events, BaseType_t *woken);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Initializes the application, creates the UART queues and the time service
+*  task, and starts the scheduler.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    app_init();
+
+    rx_queue = xQueueCreateStatic(RX_QUEUE_LENGTH, sizeof(uint8_t),
+                                  rx_queue_storage, &rx_queue_control);
+    tx_queue = xQueueCreateStatic(TX_QUEUE_LENGTH, sizeof(uint8_t),
+                                  tx_queue_storage, &tx_queue_control);
+    time_task = xTaskCreateStatic(time_service_task, TIME_TASK_NAME,
+                                  TIME_TASK_STACK_WORDS, NULL,
+                                  TIME_TASK_PRIORITY, time_task_stack,
+                                  &time_task_tcb);
+
+    vTaskStartScheduler();
+
+    /* The scheduler does not return */
+    CY_ASSERT(0);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: rtos_port_notify_from_isr
+********************************************************************************
+* Summary:
+*  Sets notification bits of the time service task from an interrupt. Does
+*  nothing before the scheduler runs.
+*
+* Parameters:
+*  uint32_t events : RTOS_PORT_EVENT_* bits
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtos_port_notify_from_isr(uint32_t events)
+{
+    BaseType_t woken = pdFALSE;
+
+    notify(NOTIFY_INDEX_EVENTS, events, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/*******************************************************************************
+* Function Name: rtos_port_get_character
+********************************************************************************
+* Summary:
+*  Takes a byte from the RX queue, blocking the calling task.
+*
+* Parameters:
+*  uint8_t *value      : Byte read
+*  uint32_t timeout_ms : Longest wait in milliseconds, 0 to wait forever
+*
+* Return:
+*  true if a byte was read before the timeout
+*
+*******************************************************************************/
+bool rtos_port_get_character(uint8_t *value, uint32_t timeout_ms)
+{
+    TickType_t ticks = (0u == timeout_ms) ? portMAX_DELAY :
+                                            pdMS_TO_TICKS(timeout_ms);
+
+    return (pdPASS == xQueueReceive(rx_queue, value, ticks));
+}
+
+/*******************************************************************************
+* Function Name: rtos_port_write
+********************************************************************************
+* Summary:
+*  Sends bytes through the TX queue, which the UART interrupt moves into the
+*  TX FIFO. Returns once the queue is empty, so that the bytes stay in order
+*  with the printf output that retarget-io writes to the FIFO directly. Call
+*  from the time service task only.
+*
+* Parameters:
+*  const uint8_t *data : Bytes to send
+*  uint32_t size       : Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtos_port_write(const uint8_t *data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        (void)xQueueSend(tx_queue, &data[i], portMAX_DELAY);
+        Cy_SCB_SetTxInterruptMask(UART_HW, CY_SCB_TX_INTR_LEVEL);
+    }
+
+    /* On its own index, so the events of the task loop stay pending */
+    while (0u != uxQueueMessagesWaiting(tx_queue))
+    {
+        (void)xTaskNotifyWaitIndexed(NOTIFY_INDEX_TX, 0u, RTOS_PORT_EVENT_TX,
+                                     NULL, portMAX_DELAY);
+    }
+}
+
+/*******************************************************************************
+* Function Name: rtos_port_get_stats
+********************************************************************************
+* Summary:
+*  Returns the idle residency counters and the stack headroom of the time
+*  service task.
+*
+* Parameters:
+*  rtos_port_stats_t *stats : Filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtos_port_get_stats(rtos_port_stats_t *stats)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint64_t cycles = sleep_cycles;
+    stats->sleeps = sleep_count;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    stats->sleep_us = (cycles * RTC_TIMEBASE_US_PER_SECOND) / SystemCoreClock;
+    stats->stack_free = (uint32_t)uxTaskGetStackHighWaterMark(time_task) *
+                        sizeof(StackType_t);
+}
+
+/*******************************************************************************
+* Function Name: rtos_port_suppress_ticks_and_sleep
+********************************************************************************
+* Summary:
+*  Tickless idle (portSUPPRESS_TICKS_AND_SLEEP). Programs SysTick to the end
+*  of the idle period, enters CPU Sleep, and steps the kernel tick count by
+*  the time slept when SysTick or another interrupt wakes the CPU. The RTC
+*  second tick wakes the time service task, so a sleep never outlasts it.
+*  The cycle counter stops in Sleep, so the time slept is also reported to
+*  the RTC time base. CPU Sleep keeps the UART running; Deep Sleep would
+*  lose console input.
+*
+* Parameters:
+*  uint32_t idle_ticks : Ticks until the next kernel deadline
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtos_port_suppress_ticks_and_sleep(uint32_t idle_ticks)
+{
+    uint32_t cycles_per_tick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    uint32_t max_ticks = SysTick_LOAD_RELOAD_Msk / cycles_per_tick;
+    uint32_t reload;
+    uint32_t ctrl;
+    uint32_t slept;
+    uint32_t complete_ticks;
+    uint32_t stage_start = energy_profile_start();
+
+    if (idle_ticks > max_ticks)
+    {
+        idle_ticks = max_ticks;
+    }
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    /* A task was made ready or a context switch is pending */
+    if (eAbortSleep == eTaskConfirmSleepModeStatus())
+    {
+        __enable_irq();
+        return;
+    }
+
+    /* Continue the current tick, then count the remaining idle ticks */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    reload = SysTick->VAL + (cycles_per_tick * (idle_ticks - 1u));
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0u;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    (void)Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+
+    /* Reading CTRL clears COUNTFLAG, so it is read once */
+    ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+    if (0u != (ctrl & SysTick_CTRL_COUNTFLAG_Msk))
+    {
+        /* The idle period ran out; the pending SysTick counts its last tick */
+        uint32_t remaining = (cycles_per_tick - 1u) - (reload - SysTick->VAL);
+
+        if (remaining >= cycles_per_tick)
+        {
+            remaining = cycles_per_tick - 1u;
+        }
+        slept = reload + 1u;
+        SysTick->LOAD = remaining;
+        complete_ticks = idle_ticks - 1u;
+    }
+    else
+    {
+        /* Another interrupt ended the sleep */
+        uint32_t elapsed = (idle_ticks * cycles_per_tick) - SysTick->VAL;
+
+        slept = reload - SysTick->VAL;
+        complete_ticks = elapsed / cycles_per_tick;
+        SysTick->LOAD = ((complete_ticks + 1u) * cycles_per_tick) - elapsed;
+    }
+
+    rtc_timebase_add_sleep(slept);
+    sleep_cycles += slept;
+    sleep_count++;
+    energy_profile_add(ENERGY_STAGE_SLEEP, slept);
+
+    SysTick->VAL = 0u;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    vTaskStepTick(complete_ticks);
+    SysTick->LOAD = cycles_per_tick - 1u;
+
+    /* The cycle counter stopped during the sleep, so this is the overhead */
+    energy_profile_record(ENERGY_STAGE_SLEEP_TRANSITION, stage_start);
+
+    /* The interrupt that woke the CPU runs now */
+    __enable_irq();
+}
+
+/*******************************************************************************
+* Function Name: vApplicationGetIdleTaskMemory
+********************************************************************************
+* Summary:
+*  Provides the static memory of the idle task.
+*
+* Parameters:
+*  StaticTask_t **tcb       : Control block of the idle task
+*  StackType_t **stack      : Stack of the idle task
+*  uint32_t *stack_words    : Stack size in words
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                   uint32_t *stack_words)
+{
+    *tcb = &idle_task_tcb;
+    *stack = idle_task_stack;
+    *stack_words = configMINIMAL_STACK_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: vApplicationStackOverflowHook
+********************************************************************************
+* Summary:
+*  Called by the kernel when a task overflowed its stack.
+*
+* Parameters:
+*  TaskHandle_t task : Task that overflowed
+*  char *name        : Name of the task
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name)
+{
+    (void)task;
+    (void)name;
+
+    /* Disable all interrupts. */
+    __disable_irq();
+
+    CY_ASSERT(0);
+}
+
+/*******************************************************************************
+* Function Name: time_service_task
+********************************************************************************
+* Summary:
+*  Runs the steps of the super-loop. Instead of polling the UART every
+*  10 ms, the task blocks until the RTC interrupt (every second) or the UART
+*  RX interrupt notifies it, so the CPU sleeps in between.
+*
+* Parameters:
+*  void *arg : Unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void time_service_task(void *arg)
+{
+    uint8_t byte;
+
+    (void)arg;
+
+    uart_start();
+
+    for (;;)
+    {
+        app_refresh();
+
+        (void)xTaskNotifyWaitIndexed(NOTIFY_INDEX_EVENTS, 0u,
+                                     RTOS_PORT_EVENT_RTC | RTOS_PORT_EVENT_UART,
+                                     NULL, binary_command_pending() ?
+                                     pdMS_TO_TICKS(FRAME_POLL_MS) :
+                                     portMAX_DELAY);
+
+        while (pdPASS == xQueueReceive(rx_queue, &byte, 0u))
+        {
+            app_input(&byte);
+        }
+
+        /* Lets the frame receiver and the console flow check timeouts */
+        app_input(NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_start
+********************************************************************************
+* Summary:
+*  Routes the UART interrupt and enables the RX interrupt. The TX interrupt
+*  is enabled by rtos_port_write() while the TX queue holds bytes.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_start(void)
+{
+    Cy_SysInt_Init(&IRQ_CFG_UART, &uart_isr);
+    NVIC_EnableIRQ(Cy_SysInt_GetNvicConnection(UART_IRQ));
+
+    /* Refill when the TX FIFO is half empty */
+    Cy_SCB_SetTxFifoLevel(UART_HW, Cy_SCB_GetFifoSize(UART_HW) / 2u);
+
+    Cy_SCB_ClearRxInterrupt(UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    Cy_SCB_SetRxInterruptMask(UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+}
+
+/*******************************************************************************
+* Function Name: uart_isr
+********************************************************************************
+* Summary:
+*  Moves received bytes into the RX queue and queued bytes into the TX FIFO,
+*  and notifies the time service task.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_isr(void)
+{
+    BaseType_t woken = pdFALSE;
+    uint32_t events = 0u;
+    uint8_t byte;
+
+    if (0u != (Cy_SCB_GetRxInterruptStatusMasked(UART_HW) &
+               CY_SCB_RX_INTR_NOT_EMPTY))
+    {
+        while (0u != Cy_SCB_UART_GetNumInRxFifo(UART_HW))
+        {
+            byte = (uint8_t)Cy_SCB_UART_Get(UART_HW);
+
+            /* A full queue drops the byte, like a full RX FIFO */
+            (void)xQueueSendFromISR(rx_queue, &byte, &woken);
+        }
+        Cy_SCB_ClearRxInterrupt(UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+        events |= RTOS_PORT_EVENT_UART;
+    }
+
+    if (0u != (Cy_SCB_GetTxInterruptStatusMasked(UART_HW) &
+               CY_SCB_TX_INTR_LEVEL))
+    {
+        while ((Cy_SCB_UART_GetNumInTxFifo(UART_HW) < Cy_SCB_GetFifoSize(UART_HW)) &&
+               (pdPASS == xQueueReceiveFromISR(tx_queue, &byte, &woken)))
+        {
+            (void)Cy_SCB_UART_Put(UART_HW, byte);
+        }
+
+        if (pdFALSE != xQueueIsQueueEmptyFromISR(tx_queue))
+        {
+            Cy_SCB_SetTxInterruptMask(UART_HW, 0u);
+            notify(NOTIFY_INDEX_TX, RTOS_PORT_EVENT_TX, &woken);
+        }
+        Cy_SCB_ClearTxInterrupt(UART_HW, CY_SCB_TX_INTR_LEVEL);
+    }
+
+    notify(NOTIFY_INDEX_EVENTS, events, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/*******************************************************************************
+* Function Name: notify
+********************************************************************************
+* Summary:
+*  Sets notification bits of the time service task from an interrupt, once
+*  the scheduler runs.
+*
+* Parameters:
+*  UBaseType_t index  : NOTIFY_INDEX_* notification of the task
+*  uint32_t events    : RTOS_PORT_EVENT_* bits, none to do nothing
+*  BaseType_t *woken  : Set if the task must run when the interrupt returns
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void notify(UBaseType_t index, uint32_t events, BaseType_t *woken)
+{
+    if ((0u != events) && (NULL != time_task) &&
+        (taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState()))
+    {
+        (void)xTaskNotifyIndexedFromISR(time_task, index, events, eSetBits,
+                                        woken);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name:   rtos_port.h
+*
+* Description: FreeRTOS port of the application: time service task, queued
+*              UART RX/TX and a tickless idle that sleeps between RTC ticks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTOS_PORT_H
+#define RTOS_PORT_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Priority of the interrupts that use the kernel API, within the range set by
+   configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+#define RTOS_PORT_ISR_PRIORITY (5u)
+
+/* Notification bits of the time service task; RTOS_PORT_EVENT_TX is set on
+   a notification index of its own */
+#define RTOS_PORT_EVENT_RTC (1UL << 0u)
+#define RTOS_PORT_EVENT_UART (1UL << 1u)
+#define RTOS_PORT_EVENT_TX (1UL << 2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint64_t sleep_us;   /* Time spent in CPU Sleep by the idle task */
+    uint32_t sleeps;     /* Number of tickless idle periods */
+    uint32_t stack_free; /* Unused stack of the time service task, in bytes */
+} rtos_port_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rtos_port_notify_from_isr(uint32_t events);
+bool rtos_port_get_character(uint8_t *value, uint32_t timeout_ms);
+void rtos_port_write(const uint8_t *data, uint32_t size);
+void rtos_port_get_stats(rtos_port_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTOS_PORT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,247 @@
+/******************************************************************************
+* File Name:   alarm_scheduler.c
+*
+* Description: Fixed-slot alarm scheduler driven by the RTC second tick. The
+*              earliest due time is cached so a tick with nothing due costs a
+*              single compare.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "alarm_scheduler.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t due_seconds;
+    alarm_scheduler_callback_t callback;
+    void *context;
+} alarm_slot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static alarm_slot_t slots[ALARM_SCHEDULER_SLOTS];
+/* Earliest due time of all used slots, valid if has_next; any second,
+   including UINT32_MAX, can be due */
+static volatile uint32_t next_due;
+static volatile bool has_next = false;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void update_next_due(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: alarm_scheduler_add
+********************************************************************************
+* Summary:
+*  Schedules a callback. A due time that has already passed fires on the next
+*  tick.
+*
+* Parameters:
+*  uint32_t due_seconds                : Monotonic second to fire at
+*  alarm_scheduler_callback_t callback : Called from the RTC interrupt
+*  void *context                       : Passed to the callback
+*
+* Return:
+*  Alarm id, or ALARM_SCHEDULER_INVALID if all slots are in use
+*
+*******************************************************************************/
+int32_t alarm_scheduler_add(uint32_t due_seconds,
+                            alarm_scheduler_callback_t callback,
+                            void *context)
+{
+    int32_t id = ALARM_SCHEDULER_INVALID;
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    for (uint32_t i = 0; i < ALARM_SCHEDULER_SLOTS; i++)
+    {
+        if (NULL == slots[i].callback)
+        {
+            slots[i].due_seconds = due_seconds;
+            slots[i].callback = callback;
+            slots[i].context = context;
+            if ((!has_next) || (due_seconds < next_due))
+            {
+                next_due = due_seconds;
+                has_next = true;
+            }
+            id = (int32_t)i;
+            break;
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return id;
+}
+
+/*******************************************************************************
+* Function Name: alarm_scheduler_cancel
+********************************************************************************
+* Summary:
+*  Removes a pending alarm. The id of an alarm that fired may already belong
+*  to a new alarm, so owners forget the id in their callback.
+*
+* Parameters:
+*  int32_t id : Alarm id from alarm_scheduler_add()
+*
+* Return:
+*  true if the alarm was pending, false if it already fired
+*
+*******************************************************************************/
+bool alarm_scheduler_cancel(int32_t id)
+{
+    bool pending = false;
+
+    if ((id >= 0) && ((uint32_t)id < ALARM_SCHEDULER_SLOTS))
+    {
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+        pending = (NULL != slots[id].callback);
+        slots[id].callback = NULL;
+        update_next_due();
+
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+
+    return pending;
+}
+
+/*******************************************************************************
+* Function Name: alarm_scheduler_next_due
+********************************************************************************
+* Summary:
+*  Returns the due time of the earliest pending alarm.
+*
+* Parameters:
+*  uint32_t *due_seconds : Receives the monotonic second, if an alarm is
+*                          pending
+*
+* Return:
+*  false if no alarm is pending
+*
+*******************************************************************************/
+bool alarm_scheduler_next_due(uint32_t *due_seconds)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    bool pending = has_next;
+
+    *due_seconds = next_due;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return pending;
+}
+
+/*******************************************************************************
+* Function Name: alarm_scheduler_tick
+********************************************************************************
+* Summary:
+*  Fires every alarm that is due. Called from the RTC second interrupt.
+*
+* Parameters:
+*  uint32_t now_seconds : Current monotonic second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void alarm_scheduler_tick(uint32_t now_seconds)
+{
+    if ((!has_next) || (now_seconds < next_due))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < ALARM_SCHEDULER_SLOTS; i++)
+    {
+        alarm_scheduler_callback_t callback = slots[i].callback;
+
+        if ((NULL != callback) && (slots[i].due_seconds <= now_seconds))
+        {
+            /* Free the slot first so the callback can schedule again */
+            slots[i].callback = NULL;
+            callback(slots[i].context);
+        }
+    }
+
+    update_next_due();
+}
+
+/*******************************************************************************
+* Function Name: update_next_due
+********************************************************************************
+* Summary:
+*  Recomputes the cached earliest due time. Called with interrupts disabled
+*  or from the RTC interrupt.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void update_next_due(void)
+{
+    bool found = false;
+    uint32_t earliest = 0u;
+
+    for (uint32_t i = 0; i < ALARM_SCHEDULER_SLOTS; i++)
+    {
+        if ((NULL != slots[i].callback) &&
+            ((!found) || (slots[i].due_seconds < earliest)))
+        {
+            earliest = slots[i].due_seconds;
+            found = true;
+        }
+    }
+
+    next_due = earliest;
+    has_next = found;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name:   alarm_scheduler.h
+*
+* Description: Public interface of the second-resolution alarm scheduler.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ALARM_SCHEDULER_H
+#define ALARM_SCHEDULER_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of alarms that can be pending at the same time */
+#define ALARM_SCHEDULER_SLOTS (8u)
+/* Returned by alarm_scheduler_add() when all slots are in use */
+#define ALARM_SCHEDULER_INVALID (-1)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Called from the RTC interrupt when the alarm is due */
+typedef void (*alarm_scheduler_callback_t)(void *context);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int32_t alarm_scheduler_add(uint32_t due_seconds,
+                            alarm_scheduler_callback_t callback,
+                            void *context);
+bool alarm_scheduler_cancel(int32_t id);
+bool alarm_scheduler_next_due(uint32_t *due_seconds);
+void alarm_scheduler_tick(uint32_t now_seconds);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ALARM_SCHEDULER_H */
+
+/* [] END OF FILE */
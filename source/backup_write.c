@@ -0,0 +1,532 @@
+/******************************************************************************
+* File Name:   backup_write.c
+*
+* Description: Write-coalescing queue for the backup-domain registers: RTC
+*              time, alarm and backup register updates are queued and
+*              committed together in one write-sync window.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "backup_write.h"
+#include "calendar.h"
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Queue slots of the RTC registers, in commit order */
+#define SLOT_RTC_TIME   (0u)
+#define SLOT_RTC_DATE   (1u)
+#define SLOT_ALM1_TIME  (2u)
+#define SLOT_ALM1_DATE  (3u)
+#define SLOT_ALM2_TIME  (4u)
+#define SLOT_ALM2_DATE  (5u)
+#define SLOT_COUNT      (6u)
+
+#define SLOT_BIT(slot)  (1UL << (slot))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Queued RTC register values, valid where the slot bit is set in rtc_pending */
+static uint32_t rtc_values[SLOT_COUNT];
+static uint32_t rtc_pending;
+/* Queued BREG values, valid where the bit is set in breg_pending */
+static uint32_t breg_values[BACKUP_WRITE_BREG_COUNT];
+static uint32_t breg_pending;
+/* Interrupt mask bits enabled once the queued writes are committed */
+static uint32_t mask_pending;
+static backup_write_stats_t stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void queue_rtc(uint32_t slot, uint32_t value);
+static bool open_window(uint32_t *savedIntrStatus);
+static bool wait_transfer(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: backup_write_date_time
+********************************************************************************
+* Summary:
+*  Queues a new date and time, encoded as Cy_RTC_SetDateAndTimeDirect() does
+*  in 24-hour mode. The arguments must be valid (see
+*  calendar_validate_date_time()).
+*
+* Parameters:
+*  uint32_t sec   : The second value
+*  uint32_t min   : The minute value
+*  uint32_t hour  : The hour value, 24-hour format
+*  uint32_t mday  : The day of month value
+*  uint32_t month : The month value
+*  uint32_t year  : Full year value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void backup_write_date_time(uint32_t sec, uint32_t min, uint32_t hour,
+                            uint32_t mday, uint32_t month, uint32_t year)
+{
+    uint32_t rtc_time =
+        _VAL2FLD(BACKUP_RTC_TIME_RTC_SEC, Cy_RTC_ConvertDecToBcd(sec)) |
+        _VAL2FLD(BACKUP_RTC_TIME_RTC_MIN, Cy_RTC_ConvertDecToBcd(min)) |
+        _VAL2FLD(BACKUP_RTC_TIME_RTC_HOUR, Cy_RTC_ConvertDecToBcd(hour)) |
+        _VAL2FLD(BACKUP_RTC_TIME_RTC_DAY,
+                 calendar_day_of_week(mday, month, year));
+    uint32_t rtc_date =
+        _VAL2FLD(BACKUP_RTC_DATE_RTC_DATE, Cy_RTC_ConvertDecToBcd(mday)) |
+        _VAL2FLD(BACKUP_RTC_DATE_RTC_MON, Cy_RTC_ConvertDecToBcd(month)) |
+        _VAL2FLD(BACKUP_RTC_DATE_RTC_YEAR,
+                 Cy_RTC_ConvertDecToBcd(year % 100u));
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    queue_rtc(SLOT_RTC_TIME, rtc_time);
+    queue_rtc(SLOT_RTC_DATE, rtc_date);
+    stats.setter_windows++;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: backup_write_alarm
+********************************************************************************
+* Summary:
+*  Queues an alarm configuration, encoded as Cy_RTC_SetAlarmDateAndTime()
+*  does with the RTC in 24-hour mode.
+*
+* Parameters:
+*  const cy_stc_rtc_alarm_t *alarm : The alarm configuration
+*  cy_en_rtc_alarm_t alarm_index   : CY_RTC_ALARM_1 or CY_RTC_ALARM_2
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void backup_write_alarm(const cy_stc_rtc_alarm_t *alarm,
+                        cy_en_rtc_alarm_t alarm_index)
+{
+    /* ALARM1 and ALARM2 have the same layout, the ALARM1 fields serve both */
+    uint32_t alm_time =
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_SEC, Cy_RTC_ConvertDecToBcd(alarm->sec)) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_SEC_EN, alarm->secEn) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_MIN, Cy_RTC_ConvertDecToBcd(alarm->min)) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_MIN_EN, alarm->minEn) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_HOUR,
+                 Cy_RTC_ConvertDecToBcd(alarm->hour)) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_HOUR_EN, alarm->hourEn) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_DAY, alarm->dayOfWeek) |
+        _VAL2FLD(BACKUP_ALM1_TIME_ALM_DAY_EN, alarm->dayOfWeekEn);
+    uint32_t alm_date =
+        _VAL2FLD(BACKUP_ALM1_DATE_ALM_DATE,
+                 Cy_RTC_ConvertDecToBcd(alarm->date)) |
+        _VAL2FLD(BACKUP_ALM1_DATE_ALM_DATE_EN, alarm->dateEn) |
+        _VAL2FLD(BACKUP_ALM1_DATE_ALM_MON,
+                 Cy_RTC_ConvertDecToBcd(alarm->month)) |
+        _VAL2FLD(BACKUP_ALM1_DATE_ALM_MON_EN, alarm->monthEn) |
+        _VAL2FLD(BACKUP_ALM1_DATE_ALM_EN, alarm->almEn);
+    bool second = (CY_RTC_ALARM_2 == alarm_index);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    queue_rtc(second ? SLOT_ALM2_TIME : SLOT_ALM1_TIME, alm_time);
+    queue_rtc(second ? SLOT_ALM2_DATE : SLOT_ALM1_DATE, alm_date);
+    stats.setter_windows++;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: backup_write_dst_alarm
+********************************************************************************
+* Summary:
+*  Queues ALARM2 for a DST edge and its interrupt enable, as
+*  Cy_RTC_EnableDstTime() programs them. A relative edge is resolved for the
+*  given year.
+*
+* Parameters:
+*  const cy_stc_rtc_dst_format_t *edge : The DST start or stop edge
+*  uint32_t year                       : Full year of the edge
+*
+* Return:
+*  bool : false if the edge is not valid, nothing is queued then
+*
+*******************************************************************************/
+bool backup_write_dst_alarm(const cy_stc_rtc_dst_format_t *edge,
+                            uint32_t year)
+{
+    if ((edge->month < CY_RTC_JANUARY) || (edge->month > CY_RTC_DECEMBER) ||
+        (edge->hour > 23u))
+    {
+        return false;
+    }
+
+    const calendar_dst_rule_t rule =
+    {
+        .format = (uint32_t)edge->format,
+        .hour = edge->hour,
+        .day_of_month = edge->dayOfMonth,
+        .week_of_month = edge->weekOfMonth,
+        .day_of_week = edge->dayOfWeek,
+        .month = edge->month,
+    };
+    calendar_dst_transition_t transition;
+
+    calendar_resolve_dst(&rule, &rule, year, &transition);
+
+    return backup_write_dst_alarm_on(edge, transition.start_mday, year);
+}
+
+/*******************************************************************************
+* Function Name: backup_write_dst_alarm_on
+********************************************************************************
+* Summary:
+*  Queues ALARM2 for a DST edge already resolved to its day of the month,
+*  e.g. from the transition table of calendar_get_dst_transition(), and its
+*  interrupt enable.
+*
+* Parameters:
+*  const cy_stc_rtc_dst_format_t *edge : The DST start or stop edge
+*  uint32_t mday                       : Day of the month of the edge
+*  uint32_t year                       : Full year of the edge
+*
+* Return:
+*  bool : false if the edge is not valid, nothing is queued then
+*
+*******************************************************************************/
+bool backup_write_dst_alarm_on(const cy_stc_rtc_dst_format_t *edge,
+                               uint32_t mday, uint32_t year)
+{
+    if ((edge->month < CY_RTC_JANUARY) || (edge->month > CY_RTC_DECEMBER) ||
+        (edge->hour > 23u) || (0u == mday) ||
+        (mday > calendar_days_in_month(edge->month, year)))
+    {
+        return false;
+    }
+
+    const cy_stc_rtc_alarm_t alarm =
+    {
+        .sec = 0u, .secEn = CY_RTC_ALARM_DISABLE,
+        .min = 0u, .minEn = CY_RTC_ALARM_DISABLE,
+        .hour = edge->hour, .hourEn = CY_RTC_ALARM_ENABLE,
+        .dayOfWeek = CY_RTC_SUNDAY, .dayOfWeekEn = CY_RTC_ALARM_DISABLE,
+        .date = mday, .dateEn = CY_RTC_ALARM_ENABLE,
+        .month = edge->month, .monthEn = CY_RTC_ALARM_ENABLE,
+        .almEn = CY_RTC_ALARM_ENABLE,
+    };
+
+    backup_write_alarm(&alarm, CY_RTC_ALARM_2);
+    backup_write_interrupt_mask(CY_RTC_INTR_ALARM2);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: backup_write_breg
+********************************************************************************
+* Summary:
+*  Queues a backup register write. Backup registers need no write window,
+*  they are written by the next flush after the RTC registers.
+*
+* Parameters:
+*  uint32_t index : Backup register, 0..BACKUP_WRITE_BREG_COUNT-1
+*  uint32_t value : The value to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void backup_write_breg(uint32_t index, uint32_t value)
+{
+    CY_ASSERT(index < BACKUP_WRITE_BREG_COUNT);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    if (0u != (breg_pending & SLOT_BIT(index)))
+    {
+        stats.coalesced++;
+    }
+    breg_values[index] = value;
+    breg_pending |= SLOT_BIT(index);
+    stats.writes++;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: backup_write_interrupt_mask
+********************************************************************************
+* Summary:
+*  Queues RTC interrupt enables. They are set by the next flush once the
+*  queued registers are committed, so that an alarm does not fire on its
+*  previous configuration.
+*
+* Parameters:
+*  uint32_t mask : CY_RTC_INTR_* bits to enable
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void backup_write_interrupt_mask(uint32_t mask)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    mask_pending |= mask;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: backup_write_flush
+********************************************************************************
+* Summary:
+*  Commits the queued writes. The ordering is:
+*   1. all queued RTC registers, in one write-sync window; a register queued
+*      more than once gets the last value,
+*   2. the wait for the transfer to the RTC, so a read after the flush sees
+*      the new values,
+*   3. the backup registers,
+*   4. the interrupt enables.
+*  Writes queued by an interrupt handler during the flush are kept for the
+*  next one.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool : false if the RTC stayed busy; writes not yet committed stay
+*         queued for a retry
+*
+*******************************************************************************/
+bool backup_write_flush(void)
+{
+    uint32_t savedIntrStatus;
+
+    if (0u != rtc_pending)
+    {
+        if (!open_window(&savedIntrStatus))
+        {
+            return false;
+        }
+
+        uint32_t pending = rtc_pending;
+        if (0u != (pending & SLOT_BIT(SLOT_RTC_TIME)))
+        {
+            BACKUP_RTC_TIME = rtc_values[SLOT_RTC_TIME];
+        }
+        if (0u != (pending & SLOT_BIT(SLOT_RTC_DATE)))
+        {
+            BACKUP_RTC_DATE = rtc_values[SLOT_RTC_DATE];
+        }
+        if (0u != (pending & SLOT_BIT(SLOT_ALM1_TIME)))
+        {
+            BACKUP_ALM1_TIME = rtc_values[SLOT_ALM1_TIME];
+        }
+        if (0u != (pending & SLOT_BIT(SLOT_ALM1_DATE)))
+        {
+            BACKUP_ALM1_DATE = rtc_values[SLOT_ALM1_DATE];
+        }
+        if (0u != (pending & SLOT_BIT(SLOT_ALM2_TIME)))
+        {
+            BACKUP_ALM2_TIME = rtc_values[SLOT_ALM2_TIME];
+        }
+        if (0u != (pending & SLOT_BIT(SLOT_ALM2_DATE)))
+        {
+            BACKUP_ALM2_DATE = rtc_values[SLOT_ALM2_DATE];
+        }
+        rtc_pending = 0u;
+
+        /* Clearing the write bit starts the transfer to the RTC */
+        (void)Cy_RTC_WriteEnable(CY_RTC_WRITE_DISABLED);
+        stats.windows++;
+        stats.flushes++;
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+        if (!wait_transfer())
+        {
+            return false;
+        }
+    }
+
+    savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    for (uint32_t i = 0u; i < BACKUP_WRITE_BREG_COUNT; i++)
+    {
+        if (0u != (breg_pending & SLOT_BIT(i)))
+        {
+            BACKUP_BREG[i] = breg_values[i];
+        }
+    }
+    breg_pending = 0u;
+
+    if (0u != mask_pending)
+    {
+        Cy_RTC_SetInterruptMask(Cy_RTC_GetInterruptMask() | mask_pending);
+        mask_pending = 0u;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: backup_write_get_stats
+********************************************************************************
+* Summary:
+*  Returns the queue statistics. setter_windows / flushes against
+*  windows / flushes compares the write-sync windows per configuration
+*  change with and without the queue.
+*
+* Parameters:
+*  backup_write_stats_t *out : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void backup_write_get_stats(backup_write_stats_t *out)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: queue_rtc
+********************************************************************************
+* Summary:
+*  Stores the value of an RTC register slot. Call with interrupts disabled.
+*
+* Parameters:
+*  uint32_t slot  : SLOT_* index
+*  uint32_t value : Register value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void queue_rtc(uint32_t slot, uint32_t value)
+{
+    if (0u != (rtc_pending & SLOT_BIT(slot)))
+    {
+        stats.coalesced++;
+    }
+    rtc_values[slot] = value;
+    rtc_pending |= SLOT_BIT(slot);
+    stats.writes++;
+}
+
+/*******************************************************************************
+* Function Name: open_window
+********************************************************************************
+* Summary:
+*  Opens a write-sync window, retrying while a transfer is in progress.
+*  Returns with interrupts disabled on success.
+*
+* Parameters:
+*  uint32_t *savedIntrStatus : Receives the saved interrupt state
+*
+* Return:
+*  bool : false on timeout, interrupts are enabled then
+*
+*******************************************************************************/
+static bool open_window(uint32_t *savedIntrStatus)
+{
+    uint32_t start = cycle_counter_read();
+
+    for (uint32_t waited = 0u; ; waited++)
+    {
+        *savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+        if (CY_RTC_SUCCESS == Cy_RTC_WriteEnable(CY_RTC_WRITE_ENABLED))
+        {
+            stats.wait_cycles += cycle_counter_read() - start;
+            return true;
+        }
+        Cy_SysLib_ExitCriticalSection(*savedIntrStatus);
+
+        if (waited >= BACKUP_WRITE_TIMEOUT_US)
+        {
+            break;
+        }
+        Cy_SysLib_DelayUs(1u);
+    }
+
+    *savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    stats.wait_cycles += cycle_counter_read() - start;
+    stats.timeouts++;
+    Cy_SysLib_ExitCriticalSection(*savedIntrStatus);
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: wait_transfer
+********************************************************************************
+* Summary:
+*  Waits for the transfer started by the end of a write window to complete.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool : false on timeout
+*
+*******************************************************************************/
+static bool wait_transfer(void)
+{
+    uint32_t start = cycle_counter_read();
+    uint32_t waited = 0u;
+
+    while ((CY_RTC_BUSY == Cy_RTC_GetSyncStatus()) &&
+           (waited < BACKUP_WRITE_TIMEOUT_US))
+    {
+        Cy_SysLib_DelayUs(1u);
+        waited++;
+    }
+    bool done = (CY_RTC_BUSY != Cy_RTC_GetSyncStatus());
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    stats.wait_cycles += cycle_counter_read() - start;
+    if (!done)
+    {
+        stats.timeouts++;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return done;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name:   backup_write.h
+*
+* Description: Write-coalescing queue for the backup-domain registers: RTC
+*              time, alarm and backup register updates are queued and
+*              committed together in one write-sync window.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BACKUP_WRITE_H
+#define BACKUP_WRITE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Backup registers (BREG) that can be queued, starting from BREG[0] */
+#ifndef BACKUP_WRITE_BREG_COUNT
+#define BACKUP_WRITE_BREG_COUNT (4u)
+#endif
+
+/* Microseconds a flush waits for the RTC to accept or complete a transfer */
+#ifndef BACKUP_WRITE_TIMEOUT_US
+#define BACKUP_WRITE_TIMEOUT_US (5000u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t flushes;           /* Flushes that committed RTC registers */
+    uint32_t windows;           /* Write-sync windows opened by the flushes */
+    uint32_t setter_windows;    /* Windows the PDL setters would have opened */
+    uint32_t writes;            /* Register writes queued */
+    uint32_t coalesced;         /* Queued writes replaced before the commit */
+    uint64_t wait_cycles;       /* Cycles spent waiting for the RTC */
+    uint32_t timeouts;          /* Flushes abandoned on a busy RTC */
+} backup_write_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void backup_write_date_time(uint32_t sec, uint32_t min, uint32_t hour,
+                            uint32_t mday, uint32_t month, uint32_t year);
+void backup_write_alarm(const cy_stc_rtc_alarm_t *alarm,
+                        cy_en_rtc_alarm_t alarm_index);
+bool backup_write_dst_alarm(const cy_stc_rtc_dst_format_t *edge,
+                            uint32_t year);
+bool backup_write_dst_alarm_on(const cy_stc_rtc_dst_format_t *edge,
+                               uint32_t mday, uint32_t year);
+void backup_write_breg(uint32_t index, uint32_t value);
+void backup_write_interrupt_mask(uint32_t mask);
+bool backup_write_flush(void);
+void backup_write_get_stats(backup_write_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BACKUP_WRITE_H */
+
+/* [] END OF FILE */
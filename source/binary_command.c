@@ -0,0 +1,372 @@
+/******************************************************************************
+* File Name:   binary_command.c
+*
+* Description: Framed binary command channel. The main loop passes each byte it
+*              reads; a protothread assembles the frame from the sync byte,
+*              checks it and dispatches it to the handler registered for its
+*              opcode.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "binary_command.h"
+#include "energy_profile.h"
+#include "protothread.h"
+#include "rtc_timebase.h"
+#if defined(COMPONENT_FREERTOS)
+#include "rtos_port.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Waits for the next byte of the frame; drops the frame on a timeout */
+#define RECEIVE_BYTE(rx, value) \
+    do \
+    { \
+        PT_WAIT_UNTIL(&(rx)->pt, next_byte((rx), (value))); \
+        if ((rx)->timed_out) \
+        { \
+            PT_EXIT(&(rx)->pt); \
+        } \
+    } while (0)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint8_t opcode;
+    binary_command_handler_t handler;
+} binary_command_entry_t;
+
+/* Frame being received, kept across the calls of the receiver */
+typedef struct
+{
+    protothread_t pt;
+    CySCB_Type *base;
+    const uint8_t *byte;
+    uint32_t timeout_ms;
+    uint64_t deadline_us;
+    bool timed_out;
+    uint8_t opcode;
+    uint8_t length;
+    uint8_t checksum;
+    uint8_t checksum_byte;
+    uint32_t index;
+    uint8_t payload[BINARY_COMMAND_MAX_PAYLOAD];
+} binary_command_receiver_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static binary_command_entry_t handlers[BINARY_COMMAND_HANDLERS];
+static uint32_t handler_count;
+static binary_command_receiver_t receiver;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static char receive_frame(binary_command_receiver_t *rx);
+static bool next_byte(binary_command_receiver_t *rx, uint8_t *value);
+static void dispatch_frame(binary_command_receiver_t *rx);
+static void send_response(CySCB_Type *base, uint8_t opcode,
+                          binary_command_status_t status,
+                          const uint8_t *data, uint32_t length);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: binary_command_register
+********************************************************************************
+* Summary:
+*  Registers the handler of an opcode.
+*
+* Parameters:
+*  uint8_t opcode                   : Opcode below BINARY_COMMAND_RESPONSE
+*  binary_command_handler_t handler : Handler called for the opcode
+*
+* Return:
+*  true on success, false if the table is full or the opcode is invalid
+*
+*******************************************************************************/
+bool binary_command_register(uint8_t opcode, binary_command_handler_t handler)
+{
+    if ((0u != (opcode & BINARY_COMMAND_RESPONSE)) ||
+        (handler_count >= BINARY_COMMAND_HANDLERS))
+    {
+        return false;
+    }
+
+    handlers[handler_count].opcode = opcode;
+    handlers[handler_count].handler = handler;
+    handler_count++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: binary_command_receive
+********************************************************************************
+* Summary:
+*  Runs the frame receiver with the byte read by the caller. The receiver takes
+*  the sync byte and every byte up to the end of the frame, then dispatches the
+*  frame and sends the response. A frame with a gap longer than the timeout is
+*  dropped without a response.
+*
+* Parameters:
+*  CySCB_Type *base    : UART the bytes are read from
+*  const uint8_t *byte : Byte read in this pass, NULL if none
+*  uint32_t timeout_ms : Longest gap between two bytes of a frame
+*
+* Return:
+*  true if the receiver took the byte, false if it is left to the caller
+*
+*******************************************************************************/
+bool binary_command_receive(CySCB_Type *base, const uint8_t *byte,
+                            uint32_t timeout_ms)
+{
+    receiver.base = base;
+    receiver.byte = byte;
+    receiver.timeout_ms = timeout_ms;
+
+    (void)receive_frame(&receiver);
+
+    bool taken = (NULL != byte) && (NULL == receiver.byte);
+    receiver.byte = NULL;
+
+    return taken;
+}
+
+/*******************************************************************************
+* Function Name: binary_command_pending
+********************************************************************************
+* Summary:
+*  Tells whether a frame is partly received, so that the caller checks its
+*  timeout again even if no byte arrives.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  true between the sync byte and the end of a frame
+*
+*******************************************************************************/
+bool binary_command_pending(void)
+{
+    return (0u != receiver.pt.line);
+}
+
+/*******************************************************************************
+* Function Name: receive_frame
+********************************************************************************
+* Summary:
+*  Protothread that waits for the sync byte, then reads the opcode, the length,
+*  the payload and the checksum, one byte per call.
+*
+* Parameters:
+*  binary_command_receiver_t *rx : Receiver state
+*
+* Return:
+*  PT_WAITING while a frame is incomplete, PT_EXITED or PT_ENDED otherwise
+*
+*******************************************************************************/
+static char receive_frame(binary_command_receiver_t *rx)
+{
+    PT_BEGIN(&rx->pt);
+
+    /* Bytes outside a frame stay with the caller */
+    PT_WAIT_UNTIL(&rx->pt, (NULL != rx->byte) &&
+                           (BINARY_COMMAND_SYNC == *rx->byte));
+    (void)next_byte(rx, &rx->opcode);
+
+    RECEIVE_BYTE(rx, &rx->opcode);
+    RECEIVE_BYTE(rx, &rx->length);
+
+    if (rx->length > BINARY_COMMAND_MAX_PAYLOAD)
+    {
+        send_response(rx->base, rx->opcode, BINARY_COMMAND_BAD_LENGTH,
+                      NULL, 0u);
+        PT_EXIT(&rx->pt);
+    }
+
+    rx->checksum = rx->opcode ^ rx->length;
+    for (rx->index = 0u; rx->index < rx->length; rx->index++)
+    {
+        RECEIVE_BYTE(rx, &rx->payload[rx->index]);
+        rx->checksum ^= rx->payload[rx->index];
+    }
+
+    RECEIVE_BYTE(rx, &rx->checksum_byte);
+
+    dispatch_frame(rx);
+
+    PT_END(&rx->pt);
+}
+
+/*******************************************************************************
+* Function Name: next_byte
+********************************************************************************
+* Summary:
+*  Takes the byte of this call, or checks whether the gap since the previous
+*  byte is over the timeout.
+*
+* Parameters:
+*  binary_command_receiver_t *rx : Receiver state
+*  uint8_t *value                : Byte taken
+*
+* Return:
+*  true if a byte was taken or the frame timed out, false to keep waiting
+*
+*******************************************************************************/
+static bool next_byte(binary_command_receiver_t *rx, uint8_t *value)
+{
+    uint64_t now_us = rtc_timebase_monotonic_us();
+
+    if (NULL != rx->byte)
+    {
+        *value = *rx->byte;
+        rx->byte = NULL;
+        rx->timed_out = false;
+        rx->deadline_us = now_us + ((uint64_t)rx->timeout_ms * 1000u);
+        return true;
+    }
+
+    rx->timed_out = (now_us >= rx->deadline_us);
+    return rx->timed_out;
+}
+
+/*******************************************************************************
+* Function Name: dispatch_frame
+********************************************************************************
+* Summary:
+*  Checks a complete frame, calls the handler of its opcode and sends the
+*  response.
+*
+* Parameters:
+*  binary_command_receiver_t *rx : Receiver holding the frame
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dispatch_frame(binary_command_receiver_t *rx)
+{
+    uint8_t response[BINARY_COMMAND_MAX_PAYLOAD - 1u];
+    uint32_t response_length = 0u;
+    binary_command_status_t status = BINARY_COMMAND_UNKNOWN_OPCODE;
+    uint32_t stage_start = energy_profile_start();
+
+    if (rx->checksum != rx->checksum_byte)
+    {
+        status = BINARY_COMMAND_BAD_CHECKSUM;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < handler_count; i++)
+        {
+            if (handlers[i].opcode == rx->opcode)
+            {
+                status = handlers[i].handler(rx->payload, rx->length,
+                                             response, &response_length);
+                break;
+            }
+        }
+    }
+
+    energy_profile_record(ENERGY_STAGE_PARSE, stage_start);
+
+    send_response(rx->base, rx->opcode, status, response, response_length);
+}
+
+/*******************************************************************************
+* Function Name: send_response
+********************************************************************************
+* Summary:
+*  Sends a response frame.
+*
+* Parameters:
+*  CySCB_Type *base               : UART to send on
+*  uint8_t opcode                 : Opcode of the request
+*  binary_command_status_t status : Result of the request
+*  const uint8_t *data            : Response data
+*  uint32_t length                : Number of data bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void send_response(CySCB_Type *base, uint8_t opcode,
+                          binary_command_status_t status,
+                          const uint8_t *data, uint32_t length)
+{
+    uint8_t frame[BINARY_COMMAND_MAX_PAYLOAD + 4u];
+    uint8_t checksum;
+    uint32_t size = 0u;
+
+    frame[size++] = BINARY_COMMAND_SYNC;
+    frame[size++] = opcode | BINARY_COMMAND_RESPONSE;
+    frame[size++] = (uint8_t)(length + 1u);
+    frame[size++] = (uint8_t)status;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        frame[size++] = data[i];
+    }
+
+    checksum = 0u;
+    for (uint32_t i = 1u; i < size; i++)
+    {
+        checksum ^= frame[i];
+    }
+    frame[size++] = checksum;
+
+#if defined(COMPONENT_FREERTOS)
+    /* The TX queue of the RTOS port sends it; the task blocks meanwhile */
+    (void)base;
+    rtos_port_write(frame, size);
+#else
+    Cy_SCB_UART_PutArrayBlocking(base, frame, size);
+    while (!Cy_SCB_UART_IsTxComplete(base))
+    {
+    }
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name:   binary_command.h
+*
+* Description: Public interface of the framed binary command channel that shares
+*              the debug UART with the text menu.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BINARY_COMMAND_H
+#define BINARY_COMMAND_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame: SYNC, opcode, length, payload[length], XOR of opcode..payload.
+   The response echoes the opcode with BINARY_COMMAND_RESPONSE set and carries
+   a status byte followed by the handler data. */
+#define BINARY_COMMAND_SYNC (0xA5u)
+#define BINARY_COMMAND_RESPONSE (0x80u)
+#define BINARY_COMMAND_MAX_PAYLOAD (16u)
+#define BINARY_COMMAND_HANDLERS (8u)
+
+/* Opcodes */
+#define BINARY_COMMAND_STOPWATCH (0x10u)
+#define BINARY_COMMAND_COUNTDOWN (0x11u)
+#define BINARY_COMMAND_EVENT (0x12u)
+#define BINARY_COMMAND_TIMESTAMPS (0x13u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    BINARY_COMMAND_OK = 0u,
+    BINARY_COMMAND_UNKNOWN_OPCODE = 1u,
+    BINARY_COMMAND_BAD_LENGTH = 2u,
+    BINARY_COMMAND_BAD_CHECKSUM = 3u,
+    BINARY_COMMAND_FAILED = 4u,
+} binary_command_status_t;
+
+/* Fills at most BINARY_COMMAND_MAX_PAYLOAD - 1 response bytes */
+typedef binary_command_status_t (*binary_command_handler_t)(
+    const uint8_t *payload, uint32_t length,
+    uint8_t *response, uint32_t *response_length);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool binary_command_register(uint8_t opcode, binary_command_handler_t handler);
+bool binary_command_receive(CySCB_Type *base, const uint8_t *byte,
+                            uint32_t timeout_ms);
+bool binary_command_pending(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BINARY_COMMAND_H */
+
+/* [] END OF FILE */
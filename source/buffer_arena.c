@@ -0,0 +1,166 @@
+/******************************************************************************
+* File Name:   buffer_arena.c
+*
+* Description: Static arena of fixed-size command and session buffers. Free
+*              blocks are tracked in a bitmap, so checkout is one bit scan and
+*              return is one bit set.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "buffer_arena.h"
+#include "string.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bitmap with one set bit per free block */
+#define ARENA_ALL_FREE ((uint32_t)((1ULL << BUFFER_ARENA_BLOCKS) - 1u))
+
+#if (BUFFER_ARENA_BLOCKS > 32u)
+#error "BUFFER_ARENA_BLOCKS must fit in the 32-bit free bitmap"
+#endif
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static char arena[BUFFER_ARENA_BLOCKS][BUFFER_ARENA_BLOCK_SIZE];
+static uint32_t free_map = ARENA_ALL_FREE;
+static buffer_arena_stats_t arena_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: buffer_arena_checkout
+********************************************************************************
+* Summary:
+*  Takes the lowest free block out of the arena and clears it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Pointer to a zeroed BUFFER_ARENA_BLOCK_SIZE byte buffer, or NULL if all
+*  blocks are checked out
+*
+*******************************************************************************/
+char *buffer_arena_checkout(void)
+{
+    char *buffer = NULL;
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    if (0u != free_map)
+    {
+        /* Index of the lowest set bit */
+        uint32_t index = __CLZ(__RBIT(free_map));
+        free_map &= ~(1UL << index);
+        buffer = arena[index];
+
+        arena_stats.in_use++;
+        if (arena_stats.in_use > arena_stats.peak_in_use)
+        {
+            arena_stats.peak_in_use = arena_stats.in_use;
+        }
+    }
+    else
+    {
+        arena_stats.failed_checkouts++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    if (NULL != buffer)
+    {
+        memset(buffer, '\0', BUFFER_ARENA_BLOCK_SIZE);
+    }
+
+    return buffer;
+}
+
+/*******************************************************************************
+* Function Name: buffer_arena_return
+********************************************************************************
+* Summary:
+*  Gives a block back to the arena. NULL is ignored.
+*
+* Parameters:
+*  char *buffer : Pointer returned by buffer_arena_checkout()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buffer_arena_return(char *buffer)
+{
+    if (NULL != buffer)
+    {
+        uint32_t index = (uint32_t)((buffer - arena[0]) /
+                                    (int32_t)BUFFER_ARENA_BLOCK_SIZE);
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+        CY_ASSERT(index < BUFFER_ARENA_BLOCKS);
+        CY_ASSERT(0u == (free_map & (1UL << index)));
+
+        free_map |= (1UL << index);
+        arena_stats.in_use--;
+
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+}
+
+/*******************************************************************************
+* Function Name: buffer_arena_get_stats
+********************************************************************************
+* Summary:
+*  Copies the arena usage statistics.
+*
+* Parameters:
+*  buffer_arena_stats_t *stats : Destination of the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buffer_arena_get_stats(buffer_arena_stats_t *stats)
+{
+    *stats = arena_stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   buffer_arena.h
+*
+* Description: Static arena of fixed-size command and session buffers with
+*              O(1) checkout and return.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BUFFER_ARENA_H
+#define BUFFER_ARENA_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of one buffer, enough for a console line */
+#define BUFFER_ARENA_BLOCK_SIZE (80u)
+
+/* Number of buffers: display line plus the console session line */
+#define BUFFER_ARENA_BLOCKS (2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Arena usage statistics */
+typedef struct
+{
+    uint32_t in_use;
+    uint32_t peak_in_use;
+    uint32_t failed_checkouts;
+} buffer_arena_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+char *buffer_arena_checkout(void);
+void buffer_arena_return(char *buffer);
+void buffer_arena_get_stats(buffer_arena_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BUFFER_ARENA_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,403 @@
+/******************************************************************************
+* File Name:   business_calendar.c
+*
+* Description: Business-day calendar. Each year is materialised once as a bitset
+*              of its working days, with the number of working days before every
+*              word, so queries are a bit test, a bit scan, or two popcounts.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "business_calendar.h"
+#include "calendar.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BITS_PER_WORD (32u)
+#define MAX_DAYS_PER_YEAR (366u)
+#define WORDS_PER_YEAR ((MAX_DAYS_PER_YEAR + BITS_PER_WORD - 1u) / BITS_PER_WORD)
+#define DAYS_PER_WEEK (7u)
+
+/* A year without any working day ends the search after this many years */
+#define SEARCH_YEARS (2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t year;                      /* 0 while the slot is unused */
+    uint32_t first_day;                 /* Day number of January 1 */
+    uint32_t days;                      /* 365 or 366 */
+    uint32_t total;                     /* Working days in the year */
+    uint32_t bits[WORDS_PER_YEAR];      /* Bit n: day of year n is worked */
+    uint16_t rank[WORDS_PER_YEAR];      /* Working days before each word */
+} year_bitset_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const business_calendar_holiday_t holidays[] = BUSINESS_CALENDAR_HOLIDAYS;
+
+static year_bitset_t years[BUSINESS_CALENDAR_CACHED_YEARS];
+/* Slot replaced by the next build */
+static uint32_t next_slot;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static const year_bitset_t *get_year(uint32_t year);
+static const year_bitset_t *get_year_of_day(uint32_t day);
+static void build_year(year_bitset_t *bitset, uint32_t year);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: popcount
+********************************************************************************
+* Summary:
+*  Counts the set bits of a word. The Cortex-M7 has no population count
+*  instruction, so this is the branch-free SWAR sequence.
+*
+* Parameters:
+*  uint32_t value : Word to count
+*
+* Return:
+*  Number of set bits
+*
+*******************************************************************************/
+static inline uint32_t popcount(uint32_t value)
+{
+    value = value - ((value >> 1u) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2u) & 0x33333333u);
+    value = (value + (value >> 4u)) & 0x0F0F0F0Fu;
+    return (uint32_t)(value * 0x01010101u) >> 24u;
+}
+
+/*******************************************************************************
+* Function Name: rank_of
+********************************************************************************
+* Summary:
+*  Counts the working days of a year before a day of the year.
+*
+* Parameters:
+*  const year_bitset_t *bitset : The year
+*  uint32_t yday               : Day of the year, 0..days
+*
+* Return:
+*  Number of working days
+*
+*******************************************************************************/
+static inline uint32_t rank_of(const year_bitset_t *bitset, uint32_t yday)
+{
+    uint32_t word = yday / BITS_PER_WORD;
+    uint32_t bit = yday % BITS_PER_WORD;
+
+    if (word >= WORDS_PER_YEAR)
+    {
+        return bitset->total;
+    }
+
+    return bitset->rank[word] +
+           popcount(bitset->bits[word] & ((1UL << bit) - 1u));
+}
+
+/*******************************************************************************
+* Function Name: business_calendar_is_working_day
+********************************************************************************
+* Summary:
+*  Checks whether a day is a working day.
+*
+* Parameters:
+*  uint32_t day : Days since 2000-01-01
+*
+* Return:
+*  true if the day is neither a weekend day nor a holiday
+*
+*******************************************************************************/
+bool business_calendar_is_working_day(uint32_t day)
+{
+    const year_bitset_t *bitset = get_year_of_day(day);
+    uint32_t yday = day - bitset->first_day;
+
+    return 0u != (bitset->bits[yday / BITS_PER_WORD] &
+                  (1UL << (yday % BITS_PER_WORD)));
+}
+
+/*******************************************************************************
+* Function Name: business_calendar_next_working_day
+********************************************************************************
+* Summary:
+*  Finds the first working day after a day.
+*
+* Parameters:
+*  uint32_t day : Days since 2000-01-01
+*
+* Return:
+*  Day number of the next working day, or BUSINESS_CALENDAR_NO_DAY
+*
+*******************************************************************************/
+uint32_t business_calendar_next_working_day(uint32_t day)
+{
+    const year_bitset_t *bitset = get_year_of_day(day);
+    uint32_t yday = (day - bitset->first_day) + 1u;
+
+    for (uint32_t i = 0; i <= SEARCH_YEARS; i++)
+    {
+        uint32_t word = yday / BITS_PER_WORD;
+        uint32_t bits = 0u;
+
+        if (word < WORDS_PER_YEAR)
+        {
+            /* Drop the days before yday in the first word */
+            bits = bitset->bits[word] & ~((1UL << (yday % BITS_PER_WORD)) - 1u);
+        }
+
+        while ((0u == bits) && (++word < WORDS_PER_YEAR))
+        {
+            bits = bitset->bits[word];
+        }
+
+        if (0u != bits)
+        {
+            return bitset->first_day + (word * BITS_PER_WORD) +
+                   __CLZ(__RBIT(bits));
+        }
+
+        bitset = get_year(bitset->year + 1u);
+        yday = 0u;
+    }
+
+    return BUSINESS_CALENDAR_NO_DAY;
+}
+
+/*******************************************************************************
+* Function Name: business_calendar_working_days_between
+********************************************************************************
+* Summary:
+*  Counts the working days from one day up to, but not including, another.
+*
+* Parameters:
+*  uint32_t first : Days since 2000-01-01 of the first day counted
+*  uint32_t last  : Days since 2000-01-01 of the day after the range
+*
+* Return:
+*  Number of working days, 0 if last is not after first
+*
+*******************************************************************************/
+uint32_t business_calendar_working_days_between(uint32_t first, uint32_t last)
+{
+    const year_bitset_t *bitset;
+    uint32_t year;
+    uint32_t before_first;
+    uint32_t count = 0u;
+
+    if (last <= first)
+    {
+        return 0u;
+    }
+
+    bitset = get_year_of_day(first);
+    year = bitset->year;
+    before_first = rank_of(bitset, first - bitset->first_day);
+
+    /* Whole years in between add their totals */
+    while (last >= (bitset->first_day + bitset->days))
+    {
+        count += bitset->total;
+        bitset = get_year(++year);
+    }
+    count += rank_of(bitset, last - bitset->first_day);
+
+    return count - before_first;
+}
+
+/*******************************************************************************
+* Function Name: get_year
+********************************************************************************
+* Summary:
+*  Returns the bitset of a year, building it in the least recently used slot
+*  if it is not cached. The first query after the RTC year changes pays for
+*  the build.
+*
+* Parameters:
+*  uint32_t year : The year, 2000 or later
+*
+* Return:
+*  Bitset of the year
+*
+*******************************************************************************/
+static const year_bitset_t *get_year(uint32_t year)
+{
+    uint32_t slot;
+
+    for (slot = 0; slot < BUSINESS_CALENDAR_CACHED_YEARS; slot++)
+    {
+        if (years[slot].year == year)
+        {
+            break;
+        }
+    }
+
+    if (slot == BUSINESS_CALENDAR_CACHED_YEARS)
+    {
+        slot = next_slot;
+        build_year(&years[slot], year);
+    }
+
+    next_slot = (slot + 1u) % BUSINESS_CALENDAR_CACHED_YEARS;
+
+    return &years[slot];
+}
+
+/*******************************************************************************
+* Function Name: get_year_of_day
+********************************************************************************
+* Summary:
+*  Returns the bitset of the year that contains a day.
+*
+* Parameters:
+*  uint32_t day : Days since 2000-01-01
+*
+* Return:
+*  Bitset of the year
+*
+*******************************************************************************/
+static const year_bitset_t *get_year_of_day(uint32_t day)
+{
+    uint32_t year;
+
+    for (uint32_t slot = 0; slot < BUSINESS_CALENDAR_CACHED_YEARS; slot++)
+    {
+        if ((0u != years[slot].year) && (day >= years[slot].first_day) &&
+            (day < (years[slot].first_day + years[slot].days)))
+        {
+            next_slot = (slot + 1u) % BUSINESS_CALENDAR_CACHED_YEARS;
+            return &years[slot];
+        }
+    }
+
+    /* Never too late, so at most one step forward */
+    year = CALENDAR_EPOCH_YEAR + (day / MAX_DAYS_PER_YEAR);
+    while (calendar_days_from_epoch(1u, 1u, year + 1u) <= day)
+    {
+        year++;
+    }
+
+    return get_year(year);
+}
+
+/*******************************************************************************
+* Function Name: build_year
+********************************************************************************
+* Summary:
+*  Materialises the working days of a year: every day that is not a weekend
+*  day, minus the holidays, and the running count of working days per word.
+*
+* Parameters:
+*  year_bitset_t *bitset : Slot to fill
+*  uint32_t year         : The year
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void build_year(year_bitset_t *bitset, uint32_t year)
+{
+    uint32_t wday = calendar_day_of_week(1u, 1u, year);
+    uint32_t easter = calendar_easter_day_of_year(year);
+    uint32_t total = 0u;
+
+    bitset->year = year;
+    bitset->first_day = calendar_days_from_epoch(1u, 1u, year);
+    bitset->days = calendar_is_leap_year(year) ? MAX_DAYS_PER_YEAR :
+                                                 (MAX_DAYS_PER_YEAR - 1u);
+
+    for (uint32_t word = 0; word < WORDS_PER_YEAR; word++)
+    {
+        bitset->bits[word] = 0u;
+    }
+
+    for (uint32_t yday = 0; yday < bitset->days; yday++)
+    {
+        if (0u == (BUSINESS_CALENDAR_WEEKEND_MASK & (1UL << wday)))
+        {
+            bitset->bits[yday / BITS_PER_WORD] |= 1UL << (yday % BITS_PER_WORD);
+        }
+        wday = (wday % DAYS_PER_WEEK) + 1u;
+    }
+
+    for (uint32_t i = 0; i < (sizeof(holidays) / sizeof(holidays[0])); i++)
+    {
+        int32_t yday;
+
+        if (BUSINESS_CALENDAR_EASTER == holidays[i].month)
+        {
+            yday = (int32_t)easter + holidays[i].day;
+        }
+        else if ((holidays[i].day > 0) &&
+                 ((uint32_t)holidays[i].day <=
+                  calendar_days_in_month(holidays[i].month, year)))
+        {
+            yday = (int32_t)calendar_day_of_year((uint32_t)holidays[i].day,
+                                                 holidays[i].month, year);
+        }
+        else
+        {
+            continue;
+        }
+
+        if ((yday >= 0) && ((uint32_t)yday < bitset->days))
+        {
+            bitset->bits[(uint32_t)yday / BITS_PER_WORD] &=
+                ~(1UL << ((uint32_t)yday % BITS_PER_WORD));
+        }
+    }
+
+    for (uint32_t word = 0; word < WORDS_PER_YEAR; word++)
+    {
+        bitset->rank[word] = (uint16_t)total;
+        total += popcount(bitset->bits[word]);
+    }
+    bitset->total = total;
+}
+
+/* [] END OF FILE */
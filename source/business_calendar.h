@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   business_calendar.h
+*
+* Description: Public interface of the business-day and holiday calendar.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BUSINESS_CALENDAR_H
+#define BUSINESS_CALENDAR_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Days that are not worked, bit n set for calendar day of week n (1 = Sunday) */
+#ifndef BUSINESS_CALENDAR_WEEKEND_MASK
+#define BUSINESS_CALENDAR_WEEKEND_MASK ((1u << 1u) | (1u << 7u))
+#endif
+
+/* Month value of a holiday that is given as an offset from Easter Sunday */
+#define BUSINESS_CALENDAR_EASTER (0u)
+
+/* Regional holidays: { month, day of month } or { BUSINESS_CALENDAR_EASTER,
+   offset in days }. The default is New Year, Good Friday, Easter Monday,
+   Labour Day, Christmas Day and Boxing Day (26 December). */
+#ifndef BUSINESS_CALENDAR_HOLIDAYS
+#define BUSINESS_CALENDAR_HOLIDAYS                                             \
+{                                                                              \
+    { 1u, 1 }, { BUSINESS_CALENDAR_EASTER, -2 }, { BUSINESS_CALENDAR_EASTER, 1 }, \
+    { 5u, 1 }, { 12u, 25 }, { 12u, 26 },                                       \
+}
+#endif
+
+/* Number of years whose bitsets are kept */
+#define BUSINESS_CALENDAR_CACHED_YEARS (2u)
+
+/* Returned by business_calendar_next_working_day() if there is none */
+#define BUSINESS_CALENDAR_NO_DAY (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint8_t month;
+    int8_t day;
+} business_calendar_holiday_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Days are numbered from 2000-01-01, see calendar_days_from_epoch() */
+bool business_calendar_is_working_day(uint32_t day);
+uint32_t business_calendar_next_working_day(uint32_t day);
+uint32_t business_calendar_working_days_between(uint32_t first, uint32_t last);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BUSINESS_CALENDAR_H */
+
+/* [] END OF FILE */
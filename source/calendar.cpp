@@ -0,0 +1,462 @@
+/******************************************************************************
+* File Name:   calendar.cpp
+*
+* Description: C-callable wrappers around the constexpr calendar library and
+*              the product DST transition and alarm tables it generates at
+*              compile time.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "calendar.hpp"
+#include "rtc_dst_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Weekday masks for the alarm schedule (bit 0 = Sunday) */
+#define WEEKDAYS_MONDAY_TO_FRIDAY (0x3Eu)
+#define WEEKDAYS_SATURDAY_SUNDAY (0x41u)
+
+namespace
+{
+
+/*******************************************************************************
+* Compile-time tables
+*******************************************************************************/
+constexpr calendar::dst_rule DST_START =
+{
+    static_cast<uint32_t>(CALENDAR_DST_START_FORMAT),
+    CALENDAR_DST_START_HOUR,
+    CALENDAR_DST_START_DAY_OF_MONTH,
+    CALENDAR_DST_START_WEEK,
+    CALENDAR_DST_START_DAY_OF_WEEK,
+    CALENDAR_DST_START_MONTH,
+};
+
+constexpr calendar::dst_rule DST_STOP =
+{
+    static_cast<uint32_t>(CALENDAR_DST_STOP_FORMAT),
+    CALENDAR_DST_STOP_HOUR,
+    CALENDAR_DST_STOP_DAY_OF_MONTH,
+    CALENDAR_DST_STOP_WEEK,
+    CALENDAR_DST_STOP_DAY_OF_WEEK,
+    CALENDAR_DST_STOP_MONTH,
+};
+
+constexpr std::size_t DST_TABLE_SIZE =
+    (CALENDAR_TABLE_LAST_YEAR - CALENDAR_TABLE_FIRST_YEAR) + 1u;
+
+/* Resolved DST dates of every year the RTC can hold, linked into flash */
+constexpr std::array<calendar_dst_transition_t, DST_TABLE_SIZE> dst_table =
+    calendar::make_dst_table<DST_TABLE_SIZE>(DST_START, DST_STOP,
+                                             CALENDAR_TABLE_FIRST_YEAR);
+
+/* Product alarm schedule: 07:30 on working days, 09:00 at weekends */
+constexpr std::array<calendar::alarm_rule, 2u> ALARM_RULES =
+{{
+    {WEEKDAYS_MONDAY_TO_FRIDAY, 7u, 30u, 0u},
+    {WEEKDAYS_SATURDAY_SUNDAY, 9u, 0u, 0u},
+}};
+
+constexpr std::size_t ALARM_TABLE_SIZE = calendar::alarm_count(ALARM_RULES);
+
+constexpr std::array<uint32_t, ALARM_TABLE_SIZE> alarm_table =
+    calendar::make_alarm_table<ALARM_TABLE_SIZE>(ALARM_RULES);
+
+static_assert(dst_table[24u].year == 2024u, "table is indexed by year");
+static_assert(ALARM_TABLE_SIZE == 7u, "one alarm per day of the week");
+
+/*******************************************************************************
+* Function Name: runtime_rule_day
+********************************************************************************
+* Summary:
+*  Resolves a DST rule with the PDL calendar functions. This is the runtime
+*  reference the compile-time table is checked against.
+*
+* Parameters:
+*  const calendar::dst_rule &rule : DST rule edge
+*  uint32_t year                 : The year value
+*
+* Return:
+*  Day of the month selected by the rule
+*
+*******************************************************************************/
+uint32_t runtime_rule_day(const calendar::dst_rule &rule, uint32_t year)
+{
+    uint32_t mday;
+    uint32_t last;
+    uint32_t count = 0u;
+    uint32_t found = 0u;
+
+    if (calendar::DST_FIXED == rule.format)
+    {
+        return rule.day_of_month;
+    }
+
+    last = Cy_RTC_DaysInMonth(rule.month, year);
+    for (mday = 1u; mday <= last; mday++)
+    {
+        if (Cy_RTC_ConvertDayOfWeek(mday, rule.month, year) == rule.day_of_week)
+        {
+            found = mday;
+            count++;
+            if ((count == rule.week_of_month) ||
+                ((0u == rule.week_of_month) && (1u == count)))
+            {
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: runtime_week_of_month
+********************************************************************************
+* Summary:
+*  Iterative week-of-month count, as originally done by the console code.
+*
+* Parameters:
+*  uint32_t day    : The day of the month. Valid range 1..31.
+*  uint32_t month  : The month of the year. Valid range 1..12.
+*  uint32_t year   : The year value. Valid range non-zero value.
+*
+* Return:
+*  Returns the week number of the month.
+*
+*******************************************************************************/
+uint32_t runtime_week_of_month(uint32_t day, uint32_t month, uint32_t year)
+{
+    uint32_t count = 1u;
+    uint32_t weekend_day = 8u - Cy_RTC_ConvertDayOfWeek(1u, month, year);
+
+    while (day > weekend_day)
+    {
+        count++;
+        weekend_day += calendar::DAYS_PER_WEEK;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: runtime_next_alarm
+********************************************************************************
+* Summary:
+*  Finds the next alarm by scanning the alarm rules, without the table. This
+*  is the runtime reference the compile-time alarm table is checked against.
+*
+* Parameters:
+*  uint32_t now : Current time as seconds since Sunday 00:00:00
+*
+* Return:
+*  Seconds until the next alarm, or CALENDAR_NO_ALARM
+*
+*******************************************************************************/
+uint32_t runtime_next_alarm(uint32_t now)
+{
+    uint32_t next = CALENDAR_NO_ALARM;
+
+    for (const calendar::alarm_rule &rule : ALARM_RULES)
+    {
+        for (uint32_t day = 0u; day < calendar::DAYS_PER_WEEK; day++)
+        {
+            if (0u == ((rule.weekday_mask >> day) & 1u))
+            {
+                continue;
+            }
+
+            uint32_t at = (day * calendar::SECONDS_PER_DAY) +
+                          ((uint32_t)rule.hour * 3600u) +
+                          ((uint32_t)rule.min * 60u) + rule.sec;
+            uint32_t wait = (at > now) ? (at - now) :
+                            ((at + CALENDAR_SECONDS_PER_WEEK) - now);
+            if (wait < next)
+            {
+                next = wait;
+            }
+        }
+    }
+
+    return next;
+}
+
+} /* namespace */
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+bool calendar_is_leap_year(uint32_t year)
+{
+    return calendar::is_leap_year(year);
+}
+
+uint32_t calendar_days_in_month(uint32_t month, uint32_t year)
+{
+    return calendar::days_in_month(month, year);
+}
+
+uint32_t calendar_day_of_year(uint32_t mday, uint32_t month, uint32_t year)
+{
+    return calendar::day_of_year(mday, month, year);
+}
+
+uint32_t calendar_day_of_week(uint32_t mday, uint32_t month, uint32_t year)
+{
+    return calendar::day_of_week(mday, month, year);
+}
+
+uint32_t calendar_week_of_month(uint32_t mday, uint32_t month, uint32_t year)
+{
+    return calendar::week_of_month(mday, month, year);
+}
+
+bool calendar_validate_date_time(uint32_t sec, uint32_t min, uint32_t hour,
+                                 uint32_t mday, uint32_t month, uint32_t year)
+{
+    return calendar::validate_date_time(sec, min, hour, mday, month, year);
+}
+
+uint32_t calendar_days_from_epoch(uint32_t mday, uint32_t month, uint32_t year)
+{
+    return calendar::days_from_civil(year, month, mday);
+}
+
+uint32_t calendar_easter_day_of_year(uint32_t year)
+{
+    return calendar::easter_day_of_year(year);
+}
+
+/*******************************************************************************
+* Function Name: calendar_to_seconds
+********************************************************************************
+* Summary:
+*  Converts a broken-down date and time to seconds since 2000-01-01 00:00:00.
+*  The wday field is ignored.
+*
+* Parameters:
+*  const calendar_date_time_t *date_time : Date and time, year >= 2000
+*
+* Return:
+*  Seconds since CALENDAR_EPOCH_YEAR
+*
+*******************************************************************************/
+uint32_t calendar_to_seconds(const calendar_date_time_t *date_time)
+{
+    return calendar::to_seconds(*date_time);
+}
+
+/*******************************************************************************
+* Function Name: calendar_from_seconds
+********************************************************************************
+* Summary:
+*  Converts seconds since 2000-01-01 00:00:00 to a broken-down date and time.
+*
+* Parameters:
+*  uint32_t seconds                : Seconds since CALENDAR_EPOCH_YEAR
+*  calendar_date_time_t *date_time : Resulting date, time and day of week
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void calendar_from_seconds(uint32_t seconds, calendar_date_time_t *date_time)
+{
+    *date_time = calendar::from_seconds(seconds);
+}
+
+/*******************************************************************************
+* Function Name: calendar_from_days
+********************************************************************************
+* Summary:
+*  Converts a day number, as returned by calendar_days_from_epoch(), to a date
+*  and day of week with the time set to zero. Days before 2000 are passed as
+*  negative numbers cast to uint32_t, back to 0000-03-01.
+*
+* Parameters:
+*  uint32_t days                   : Days since CALENDAR_EPOCH_YEAR-01-01
+*  calendar_date_time_t *date_time : Resulting date and day of week
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void calendar_from_days(uint32_t days, calendar_date_time_t *date_time)
+{
+    *date_time = calendar::from_days(days);
+}
+
+/*******************************************************************************
+* Function Name: calendar_resolve_dst
+********************************************************************************
+* Summary:
+*  Resolves a DST rule that is only known at run time (for example one keyed
+*  in on the console) for one year.
+*
+* Parameters:
+*  const calendar_dst_rule_t *start       : Rule of the DST start
+*  const calendar_dst_rule_t *stop        : Rule of the DST end
+*  uint32_t year                          : The year value
+*  calendar_dst_transition_t *transition : Resolved transition dates
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void calendar_resolve_dst(const calendar_dst_rule_t *start,
+                          const calendar_dst_rule_t *stop, uint32_t year,
+                          calendar_dst_transition_t *transition)
+{
+    *transition = calendar::dst_transition(*start, *stop, year);
+}
+
+/*******************************************************************************
+* Function Name: calendar_get_dst_transition
+********************************************************************************
+* Summary:
+*  Returns the precomputed DST transition dates of a year.
+*
+* Parameters:
+*  uint32_t year : Full year, CALENDAR_TABLE_FIRST_YEAR..CALENDAR_TABLE_LAST_YEAR
+*
+* Return:
+*  Pointer into the flash table, or NULL if the year is out of range
+*
+*******************************************************************************/
+const calendar_dst_transition_t *calendar_get_dst_transition(uint32_t year)
+{
+    if ((year < CALENDAR_TABLE_FIRST_YEAR) || (year > CALENDAR_TABLE_LAST_YEAR))
+    {
+        return nullptr;
+    }
+
+    return &dst_table[year - CALENDAR_TABLE_FIRST_YEAR];
+}
+
+/*******************************************************************************
+* Function Name: calendar_next_alarm
+********************************************************************************
+* Summary:
+*  Looks up the next entry of the compile-time alarm schedule.
+*
+* Parameters:
+*  uint32_t second_of_week : Current time as seconds since Sunday 00:00:00
+*
+* Return:
+*  Seconds until the next alarm, or CALENDAR_NO_ALARM
+*
+*******************************************************************************/
+uint32_t calendar_next_alarm(uint32_t second_of_week)
+{
+    return calendar::next_alarm(alarm_table, second_of_week);
+}
+
+/*******************************************************************************
+* Function Name: calendar_self_test
+********************************************************************************
+* Summary:
+*  Checks every compile-time result against the runtime computation done with
+*  the PDL calendar functions, for all dates the RTC can hold, and the alarm
+*  table against a scan of the alarm rules.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  true if the compile-time and runtime results are identical
+*
+*******************************************************************************/
+bool calendar_self_test(void)
+{
+    bool rslt = true;
+
+    for (uint32_t year = CALENDAR_TABLE_FIRST_YEAR;
+         rslt && (year <= CALENDAR_TABLE_LAST_YEAR); year++)
+    {
+        const calendar_dst_transition_t *entry =
+            calendar_get_dst_transition(year);
+
+        rslt = (calendar::is_leap_year(year) == Cy_RTC_IsLeapYear(year)) &&
+               (entry->start_mday == runtime_rule_day(DST_START, year)) &&
+               (entry->stop_mday == runtime_rule_day(DST_STOP, year));
+
+        for (uint32_t month = 1u;
+             rslt && (month <= calendar::MONTHS_PER_YEAR); month++)
+        {
+            uint32_t last = Cy_RTC_DaysInMonth(month, year);
+            rslt = (calendar::days_in_month(month, year) == last);
+
+            for (uint32_t mday = 1u; rslt && (mday <= last); mday++)
+            {
+                calendar_date_time_t dt = calendar::from_seconds(
+                    calendar::days_from_civil(year, month, mday) *
+                    calendar::SECONDS_PER_DAY);
+
+                rslt = (calendar::day_of_week(mday, month, year) ==
+                        Cy_RTC_ConvertDayOfWeek(mday, month, year)) &&
+                       (calendar::week_of_month(mday, month, year) ==
+                        runtime_week_of_month(mday, month, year)) &&
+                       (dt.year == year) && (dt.month == month) &&
+                       (dt.mday == mday) &&
+                       (dt.wday == calendar::day_of_week(mday, month, year));
+            }
+        }
+    }
+
+    /* The alarm table, at every minute of the week and around each entry */
+    for (uint32_t now = 0u; rslt && (now < CALENDAR_SECONDS_PER_WEEK);
+         now += 60u)
+    {
+        rslt = (calendar_next_alarm(now) == runtime_next_alarm(now));
+    }
+    for (std::size_t i = 0u; rslt && (i < ALARM_TABLE_SIZE); i++)
+    {
+        uint32_t at = alarm_table[i];
+        uint32_t before = (0u == at) ? (CALENDAR_SECONDS_PER_WEEK - 1u) :
+                                       (at - 1u);
+        rslt = (calendar_next_alarm(before) == runtime_next_alarm(before)) &&
+               (calendar_next_alarm(at) == runtime_next_alarm(at));
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:   calendar.h
+*
+* Description: C interface of the compile-time calendar library. The
+*              implementation lives in calendar.hpp (constexpr) and the
+*              wrappers in calendar.cpp.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Origin of calendar_to_seconds(): 2000-01-01 00:00:00 */
+#define CALENDAR_EPOCH_YEAR (2000u)
+
+/* First and last year covered by the compile-time DST transition table */
+#define CALENDAR_TABLE_FIRST_YEAR (2000u)
+#define CALENDAR_TABLE_LAST_YEAR (2099u)
+
+/* Seconds in one week, the period of the weekly alarm schedule */
+#define CALENDAR_SECONDS_PER_WEEK (604800UL)
+
+/* Returned by calendar_next_alarm() when the schedule is empty */
+#define CALENDAR_NO_ALARM (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Broken-down date and time; wday follows the PDL, CY_RTC_SUNDAY (1) ..
+   CY_RTC_SATURDAY (7) */
+typedef struct
+{
+    uint32_t year;
+    uint32_t month;
+    uint32_t mday;
+    uint32_t hour;
+    uint32_t min;
+    uint32_t sec;
+    uint32_t wday;
+} calendar_date_time_t;
+
+/* One edge of a DST rule, same fields and encoding as cy_stc_rtc_dst_format_t */
+typedef struct
+{
+    uint32_t format;
+    uint32_t hour;
+    uint32_t day_of_month;
+    uint32_t week_of_month;
+    uint32_t day_of_week;
+    uint32_t month;
+} calendar_dst_rule_t;
+
+/* Resolved DST transition dates for one year, both in local standard time */
+typedef struct
+{
+    uint16_t year;
+    uint8_t start_month;
+    uint8_t start_mday;
+    uint8_t start_hour;
+    uint8_t stop_month;
+    uint8_t stop_mday;
+    uint8_t stop_hour;
+} calendar_dst_transition_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool calendar_is_leap_year(uint32_t year);
+uint32_t calendar_days_in_month(uint32_t month, uint32_t year);
+uint32_t calendar_day_of_year(uint32_t mday, uint32_t month, uint32_t year);
+uint32_t calendar_day_of_week(uint32_t mday, uint32_t month, uint32_t year);
+uint32_t calendar_week_of_month(uint32_t mday, uint32_t month, uint32_t year);
+bool calendar_validate_date_time(uint32_t sec, uint32_t min, uint32_t hour,
+                                 uint32_t mday, uint32_t month, uint32_t year);
+uint32_t calendar_days_from_epoch(uint32_t mday, uint32_t month, uint32_t year);
+uint32_t calendar_easter_day_of_year(uint32_t year);
+uint32_t calendar_to_seconds(const calendar_date_time_t *date_time);
+void calendar_from_seconds(uint32_t seconds, calendar_date_time_t *date_time);
+void calendar_from_days(uint32_t days, calendar_date_time_t *date_time);
+const calendar_dst_transition_t *calendar_get_dst_transition(uint32_t year);
+void calendar_resolve_dst(const calendar_dst_rule_t *start,
+                          const calendar_dst_rule_t *stop, uint32_t year,
+                          calendar_dst_transition_t *transition);
+uint32_t calendar_next_alarm(uint32_t second_of_week);
+bool calendar_self_test(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CALENDAR_H */
+
+/* [] END OF FILE */
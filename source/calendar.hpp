@@ -0,0 +1,410 @@
+/******************************************************************************
+* File Name:   calendar.hpp
+*
+* Description: Header-only constexpr calendar library. Every function can be
+*              evaluated by the compiler, so product-specific DST transition
+*              tables and alarm schedules are generated at build time and
+*              placed in flash.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CALENDAR_HPP
+#define CALENDAR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "calendar.h"
+
+namespace calendar
+{
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Day-of-week numbering follows the PDL: CY_RTC_SUNDAY (1) .. CY_RTC_SATURDAY (7) */
+constexpr uint32_t SUNDAY = 1u;
+constexpr uint32_t DAYS_PER_WEEK = 7u;
+constexpr uint32_t MONTHS_PER_YEAR = 12u;
+constexpr uint32_t MAX_SEC_OR_MIN = 60u;
+constexpr uint32_t MAX_HOURS_24H = 23u;
+constexpr uint32_t SECONDS_PER_DAY = 86400u;
+
+/* Same encoding as CY_RTC_LAST_WEEK_OF_MONTH */
+constexpr uint32_t LAST_WEEK_OF_MONTH = 6u;
+
+/* Same encoding as CY_RTC_DST_RELATIVE / CY_RTC_DST_FIXED */
+constexpr uint32_t DST_RELATIVE = 0u;
+constexpr uint32_t DST_FIXED = 1u;
+
+constexpr std::array<uint8_t, MONTHS_PER_YEAR> DAYS_IN_MONTH =
+    {31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u};
+
+constexpr std::array<uint16_t, MONTHS_PER_YEAR> CUMULATIVE_DAYS =
+    {0u, 31u, 59u, 90u, 120u, 151u, 181u, 212u, 243u, 273u, 304u, 334u};
+
+/*******************************************************************************
+* Calendar arithmetic
+*******************************************************************************/
+/* Checks whether the year is a leap year (Gregorian rules) */
+constexpr bool is_leap_year(uint32_t year)
+{
+    return ((0u == (year % 4u)) && (0u != (year % 100u))) ||
+           (0u == (year % 400u));
+}
+
+/* Number of days in the month (1..12) of the year */
+constexpr uint32_t days_in_month(uint32_t month, uint32_t year)
+{
+    return DAYS_IN_MONTH[month - 1u] +
+           (((2u == month) && is_leap_year(year)) ? 1u : 0u);
+}
+
+/* Zero-based day of the year, as stored in struct tm::tm_yday */
+constexpr uint32_t day_of_year(uint32_t mday, uint32_t month, uint32_t year)
+{
+    return CUMULATIVE_DAYS[month - 1u] + (mday - 1u) +
+           (((month >= 3u) && is_leap_year(year)) ? 1u : 0u);
+}
+
+/* Day of the week, SUNDAY (1) .. SATURDAY (7), by Sakamoto's method */
+constexpr uint32_t day_of_week(uint32_t mday, uint32_t month, uint32_t year)
+{
+    constexpr std::array<uint8_t, MONTHS_PER_YEAR> offset =
+        {0u, 3u, 2u, 5u, 0u, 3u, 5u, 1u, 4u, 6u, 2u, 4u};
+    uint32_t y = (month < 3u) ? (year - 1u) : year;
+    return ((y + (y / 4u) - (y / 100u) + (y / 400u) +
+             offset[month - 1u] + mday) % DAYS_PER_WEEK) + SUNDAY;
+}
+
+/* Calendar row (weeks start on Sunday) holding the day, 1..6 */
+constexpr uint32_t week_of_month(uint32_t mday, uint32_t month, uint32_t year)
+{
+    uint32_t first_day = day_of_week(1u, month, year);
+    return ((mday + first_day - SUNDAY - 1u) / DAYS_PER_WEEK) + 1u;
+}
+
+/* Range check of a date and time, mirroring the limits used by the console */
+constexpr bool validate_date_time(uint32_t sec, uint32_t min, uint32_t hour,
+                                  uint32_t mday, uint32_t month, uint32_t year)
+{
+    bool valid = (sec <= MAX_SEC_OR_MIN) && (min <= MAX_SEC_OR_MIN) &&
+                 (hour <= MAX_HOURS_24H) && (month > 0u) &&
+                 (month <= MONTHS_PER_YEAR) && (year > 0u);
+
+    return valid && (mday > 0u) && (mday <= days_in_month(month, year));
+}
+
+/*******************************************************************************
+* Linear time
+*******************************************************************************/
+/* Days from CALENDAR_EPOCH_YEAR-01-01 to the date (Howard Hinnant's
+*  days_from_civil with March-based years). Dates before 2000, from year 1 on,
+*  wrap around and are negative when cast to int32_t */
+constexpr uint32_t days_from_civil(uint32_t year, uint32_t month, uint32_t mday)
+{
+    uint32_t y = year - ((month <= 2u) ? 1u : 0u);
+    uint32_t era = y / 400u;
+    uint32_t yoe = y - (era * 400u);
+    uint32_t doy = (((153u * ((month > 2u) ? (month - 3u) : (month + 9u))) + 2u)
+                    / 5u) + mday - 1u;
+    uint32_t doe = (yoe * 365u) + (yoe / 4u) - (yoe / 100u) + doy;
+
+    /* 730425 days from 0000-03-01 to 2000-01-01 */
+    return (era * 146097u) + doe - 730425u;
+}
+
+/* Seconds from CALENDAR_EPOCH_YEAR-01-01 00:00:00 to the date and time */
+constexpr uint32_t to_seconds(const calendar_date_time_t &dt)
+{
+    return (days_from_civil(dt.year, dt.month, dt.mday) * SECONDS_PER_DAY) +
+           (dt.hour * 3600u) + (dt.min * 60u) + dt.sec;
+}
+
+/* Inverse of days_from_civil(); fills in the date and the day of the week
+*  and leaves the time zero. Wrapped days before 2000 are accepted back to
+*  0000-03-01 */
+constexpr calendar_date_time_t from_days(uint32_t days)
+{
+    calendar_date_time_t dt {};
+
+    /* Days since 0000-03-01, which was a Wednesday */
+    uint32_t z = days + 730425u;
+    uint32_t era = z / 146097u;
+    uint32_t doe = z - (era * 146097u);
+    uint32_t yoe = (doe - (doe / 1460u) + (doe / 36524u) - (doe / 146096u)) / 365u;
+    uint32_t doy = doe - ((365u * yoe) + (yoe / 4u) - (yoe / 100u));
+    uint32_t mp = ((5u * doy) + 2u) / 153u;
+
+    dt.wday = ((z + 3u) % DAYS_PER_WEEK) + SUNDAY;
+    dt.mday = doy - (((153u * mp) + 2u) / 5u) + 1u;
+    dt.month = (mp < 10u) ? (mp + 3u) : (mp - 9u);
+    dt.year = (yoe + (era * 400u)) + ((dt.month <= 2u) ? 1u : 0u);
+    return dt;
+}
+
+/* Inverse of to_seconds(), also fills in the day of the week */
+constexpr calendar_date_time_t from_seconds(uint32_t seconds)
+{
+    calendar_date_time_t dt = from_days(seconds / SECONDS_PER_DAY);
+    uint32_t rem = seconds % SECONDS_PER_DAY;
+
+    dt.hour = rem / 3600u;
+    dt.min = (rem % 3600u) / 60u;
+    dt.sec = rem % 60u;
+    return dt;
+}
+
+/*******************************************************************************
+* Movable holidays
+*******************************************************************************/
+/* Day of the year (0-based, as day_of_year()) of Easter Sunday in the
+*  Gregorian calendar (anonymous Gregorian algorithm) */
+constexpr uint32_t easter_day_of_year(uint32_t year)
+{
+    uint32_t a = year % 19u;
+    uint32_t b = year / 100u;
+    uint32_t c = year % 100u;
+    uint32_t g = (b - ((b + 8u) / 25u) + 1u) / 3u;
+    uint32_t h = ((19u * a) + b - (b / 4u) - g + 15u) % 30u;
+    uint32_t l = (32u + (2u * (b % 4u)) + (2u * (c / 4u)) - h - (c % 4u)) % 7u;
+    uint32_t m = (a + (11u * h) + (22u * l)) / 451u;
+    uint32_t n = h + l + 114u - (7u * m);
+
+    return day_of_year((n % 31u) + 1u, n / 31u, year);
+}
+
+/*******************************************************************************
+* DST rules
+*******************************************************************************/
+/* One edge of a DST rule, same fields as cy_stc_rtc_dst_format_t */
+using dst_rule = calendar_dst_rule_t;
+
+/* Resolves a rule to the day of the month it selects in the given year.
+*  Relative rules pick the n-th occurrence of the weekday, LAST_WEEK_OF_MONTH
+*  (or an n-th occurrence that does not exist) picks the last one. */
+constexpr uint32_t dst_rule_day(const dst_rule &rule, uint32_t year)
+{
+    if (DST_FIXED == rule.format)
+    {
+        return rule.day_of_month;
+    }
+
+    uint32_t first = day_of_week(1u, rule.month, year);
+    uint32_t mday = 1u + ((rule.day_of_week + DAYS_PER_WEEK - first) %
+                          DAYS_PER_WEEK);
+    uint32_t last = days_in_month(rule.month, year);
+    uint32_t week = (rule.week_of_month == 0u) ? 1u : rule.week_of_month;
+
+    while ((week > 1u) && ((mday + DAYS_PER_WEEK) <= last))
+    {
+        mday += DAYS_PER_WEEK;
+        week--;
+    }
+
+    if (LAST_WEEK_OF_MONTH == rule.week_of_month)
+    {
+        while ((mday + DAYS_PER_WEEK) <= last)
+        {
+            mday += DAYS_PER_WEEK;
+        }
+    }
+
+    return mday;
+}
+
+/* Resolves both edges of a DST rule for one year */
+constexpr calendar_dst_transition_t dst_transition(const dst_rule &start,
+                                                   const dst_rule &stop,
+                                                   uint32_t year)
+{
+    calendar_dst_transition_t entry {};
+    entry.year = static_cast<uint16_t>(year);
+    entry.start_month = static_cast<uint8_t>(start.month);
+    entry.start_mday = static_cast<uint8_t>(dst_rule_day(start, year));
+    entry.start_hour = static_cast<uint8_t>(start.hour);
+    entry.stop_month = static_cast<uint8_t>(stop.month);
+    entry.stop_mday = static_cast<uint8_t>(dst_rule_day(stop, year));
+    entry.stop_hour = static_cast<uint8_t>(stop.hour);
+    return entry;
+}
+
+/* Builds the DST transition table for N consecutive years */
+template <std::size_t N>
+constexpr std::array<calendar_dst_transition_t, N>
+make_dst_table(const dst_rule &start, const dst_rule &stop, uint32_t first_year)
+{
+    std::array<calendar_dst_transition_t, N> table {};
+    for (std::size_t i = 0u; i < N; i++)
+    {
+        table[i] = dst_transition(start, stop,
+                                  first_year + static_cast<uint32_t>(i));
+    }
+    return table;
+}
+
+/*******************************************************************************
+* Weekly alarm schedules
+*******************************************************************************/
+/* Alarm fired at hour:min:sec on every weekday set in weekday_mask
+*  (bit 0 = Sunday .. bit 6 = Saturday) */
+struct alarm_rule
+{
+    uint8_t weekday_mask;
+    uint8_t hour;
+    uint8_t min;
+    uint8_t sec;
+};
+
+/* Second of the week (Sunday 00:00:00 = 0) of a weekday and time */
+constexpr uint32_t second_of_week(uint32_t day_of_week, uint32_t hour,
+                                  uint32_t min, uint32_t sec)
+{
+    return ((day_of_week - SUNDAY) * SECONDS_PER_DAY) +
+           (hour * 3600u) + (min * 60u) + sec;
+}
+
+/* Number of table entries produced by a set of alarm rules */
+template <std::size_t R>
+constexpr std::size_t alarm_count(const std::array<alarm_rule, R> &rules)
+{
+    std::size_t count = 0u;
+    for (const alarm_rule &rule : rules)
+    {
+        for (uint32_t day = 0u; day < DAYS_PER_WEEK; day++)
+        {
+            count += ((rule.weekday_mask >> day) & 1u);
+        }
+    }
+    return count;
+}
+
+/* Expands alarm rules into a sorted table of seconds of the week */
+template <std::size_t N, std::size_t R>
+constexpr std::array<uint32_t, N>
+make_alarm_table(const std::array<alarm_rule, R> &rules)
+{
+    std::array<uint32_t, N> table {};
+    std::size_t count = 0u;
+
+    for (const alarm_rule &rule : rules)
+    {
+        for (uint32_t day = 0u; day < DAYS_PER_WEEK; day++)
+        {
+            if (0u != ((rule.weekday_mask >> day) & 1u))
+            {
+                /* Insertion sort keeps the table ordered for bisection */
+                uint32_t value = second_of_week(day + SUNDAY, rule.hour,
+                                                rule.min, rule.sec);
+                std::size_t pos = count;
+                while ((pos > 0u) && (table[pos - 1u] > value))
+                {
+                    table[pos] = table[pos - 1u];
+                    pos--;
+                }
+                table[pos] = value;
+                count++;
+            }
+        }
+    }
+    return table;
+}
+
+/* First alarm strictly after the given second of the week, wrapping into
+*  the next week; returns the number of seconds until it fires */
+template <std::size_t N>
+constexpr uint32_t next_alarm(const std::array<uint32_t, N> &table,
+                              uint32_t now)
+{
+    if (0u == N)
+    {
+        return CALENDAR_NO_ALARM;
+    }
+
+    std::size_t low = 0u;
+    std::size_t high = N;
+    while (low < high)
+    {
+        std::size_t mid = (low + high) / 2u;
+        if (table[mid] <= now)
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return (low < N) ? (table[low] - now) :
+                       ((CALENDAR_SECONDS_PER_WEEK - now) + table[0]);
+}
+
+/*******************************************************************************
+* Compile-time checks against known calendar facts
+*******************************************************************************/
+static_assert(is_leap_year(2000u) && !is_leap_year(2100u) &&
+              is_leap_year(2024u) && !is_leap_year(2023u), "leap year");
+static_assert(day_of_week(1u, 1u, 2000u) == 7u, "2000-01-01 is a Saturday");
+static_assert(day_of_week(18u, 10u, 2026u) == 1u, "2026-10-18 is a Sunday");
+static_assert(day_of_year(31u, 12u, 2024u) == 365u, "leap year tm_yday");
+static_assert(week_of_month(7u, 9u, 2024u) == 1u &&
+              week_of_month(8u, 9u, 2024u) == 2u, "week of month");
+static_assert(!validate_date_time(0u, 0u, 0u, 29u, 2u, 2023u) &&
+              validate_date_time(0u, 0u, 0u, 29u, 2u, 2024u), "validation");
+static_assert(days_from_civil(2000u, 1u, 1u) == 0u &&
+              days_from_civil(2024u, 3u, 1u) == 8826u, "days from civil");
+static_assert(from_seconds(to_seconds({2096u, 2u, 29u, 23u, 59u, 58u, 0u})).mday
+              == 29u, "round trip");
+static_assert(from_seconds(0u).wday == 7u, "epoch is a Saturday");
+static_assert((from_days(days_from_civil(1970u, 1u, 1u)).year == 1970u) &&
+              (from_days(days_from_civil(1970u, 1u, 1u)).wday == 5u) &&
+              (from_days(days_from_civil(1600u, 2u, 29u)).mday == 29u),
+              "dates before 2000");
+static_assert(dst_rule_day({DST_RELATIVE, 1u, 1u, LAST_WEEK_OF_MONTH, SUNDAY, 3u},
+                           2024u) == 31u, "EU DST start 2024");
+static_assert(dst_rule_day({DST_RELATIVE, 2u, 1u, 2u, SUNDAY, 3u},
+                           2024u) == 10u, "US DST start 2024");
+static_assert((easter_day_of_year(2025u) == day_of_year(20u, 4u, 2025u)) &&
+              (easter_day_of_year(2026u) == day_of_year(5u, 4u, 2026u)) &&
+              (easter_day_of_year(2038u) == day_of_year(25u, 4u, 2038u)),
+              "Easter Sunday");
+
+} /* namespace calendar */
+
+#endif /* CALENDAR_HPP */
+
+/* [] END OF FILE */
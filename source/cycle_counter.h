@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name:   cycle_counter.h
+*
+* Description: Core cycle counter (DWT CYCCNT) access for timing and
+*              instrumentation.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Key that unlocks the DWT registers on Cortex-M7 */
+#define CYCLE_COUNTER_DWT_UNLOCK (0xC5ACCE55UL)
+
+/*******************************************************************************
+* Function Name: cycle_counter_init
+********************************************************************************
+* Summary:
+*  Enables the DWT cycle counter. Safe to call more than once.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = CYCLE_COUNTER_DWT_UNLOCK;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: cycle_counter_read
+********************************************************************************
+* Summary:
+*  Returns the free-running core cycle count. It wraps every 2^32 cycles and
+*  does not advance while the CPU is in Sleep or Deep Sleep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Current cycle count
+*
+*******************************************************************************/
+static inline uint32_t cycle_counter_read(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYCLE_COUNTER_H */
+
+/* [] END OF FILE */
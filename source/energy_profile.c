@@ -0,0 +1,282 @@
+/******************************************************************************
+* File Name:   energy_profile.c
+*
+* Description: Charge estimate per operation from per-stage cycle counts and a
+*              current model per power mode.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "energy_profile.h"
+#include "rtc_timebase.h"
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HZ_PER_MHZ (1000000UL)
+#define PC_PER_NC (1000u)
+#define NA_PER_UA (1000u)
+#define US_PER_MS (1000u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t ops;
+    uint64_t cycles;
+} energy_stage_stats_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const stage_names[ENERGY_STAGES] =
+{
+    "Display refresh",
+    "UART echo",
+    "Parsing",
+    "DST evaluation",
+    "Sleep transition",
+    "Sleep",
+};
+
+/* Power mode the cycles of each stage are spent in */
+static const energy_mode_t stage_modes[ENERGY_STAGES] =
+{
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_SLEEP,
+};
+
+static energy_stage_stats_t stage_stats[ENERGY_STAGES];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t mode_current_ua(energy_mode_t mode, uint32_t mhz);
+static uint32_t print_line(const char *name, uint32_t ops, uint64_t cycles,
+                           uint64_t us, uint32_t current_ua,
+                           uint32_t uptime_ms);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: energy_profile_record
+********************************************************************************
+* Summary:
+*  Counts one operation of a stage that ran from start until now. May be
+*  called from interrupts.
+*
+* Parameters:
+*  energy_stage_t stage : Stage that ran
+*  uint32_t start       : Value of energy_profile_start() at its beginning
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_profile_record(energy_stage_t stage, uint32_t start)
+{
+    uint32_t cycles = cycle_counter_read() - start;
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    stage_stats[stage].ops++;
+    stage_stats[stage].cycles += cycles;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: energy_profile_add
+********************************************************************************
+* Summary:
+*  Counts one operation of a stage whose duration was measured by the caller,
+*  for example a sleep during which the cycle counter stopped.
+*
+* Parameters:
+*  energy_stage_t stage : Stage that ran
+*  uint32_t cycles      : Duration in core clock cycles
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_profile_add(energy_stage_t stage, uint32_t cycles)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    stage_stats[stage].ops++;
+    stage_stats[stage].cycles += cycles;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: energy_profile_print
+********************************************************************************
+* Summary:
+*  Prints the current model and, per stage, the number of operations, the
+*  cycles and charge per operation, and the average current the stage adds,
+*  which is its charge per hour. The time not spent in any stage is shown as
+*  idle in Active mode. tools/energy_model.py parses this output.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_profile_print(void)
+{
+    energy_stage_stats_t stats[ENERGY_STAGES];
+    uint32_t mhz = SystemCoreClock / HZ_PER_MHZ;
+    uint64_t uptime_us = rtc_timebase_monotonic_us();
+    uint64_t staged_us = 0u;
+    uint32_t total_na = 0u;
+    uint32_t uptime_ms;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    memcpy(stats, stage_stats, sizeof(stats));
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    if (0u == mhz)
+    {
+        mhz = 1u;
+    }
+    uptime_ms = (uint32_t)(uptime_us / US_PER_MS);
+    if (0u == uptime_ms)
+    {
+        uptime_ms = 1u;
+    }
+
+    printf("Energy model        : active %u uA + %u uA/MHz, sleep %u uA + %u"
+           " uA/MHz, %" PRIu32 " MHz, %" PRIu32 " ms up\r\n",
+           ENERGY_ACTIVE_BASE_UA, ENERGY_ACTIVE_UA_PER_MHZ,
+           ENERGY_SLEEP_BASE_UA, ENERGY_SLEEP_UA_PER_MHZ, mhz, uptime_ms);
+
+    for (uint32_t i = 0u; i < ENERGY_STAGES; i++)
+    {
+        uint64_t us = stats[i].cycles / mhz;
+
+        staged_us += us;
+        total_na += print_line(stage_names[i], stats[i].ops, stats[i].cycles,
+                               us, mode_current_ua(stage_modes[i], mhz),
+                               uptime_ms);
+    }
+
+    uint64_t idle_us = (uptime_us > staged_us) ? (uptime_us - staged_us) : 0u;
+    total_na += print_line("Idle", 0u, idle_us * mhz, idle_us,
+                           mode_current_ua(ENERGY_MODE_ACTIVE, mhz), uptime_ms);
+    printf("  %-18s: %" PRIu32 ".%03" PRIu32 " uAh/h\r\n", "Total",
+           total_na / NA_PER_UA, total_na % NA_PER_UA);
+}
+
+/*******************************************************************************
+* Function Name: mode_current_ua
+********************************************************************************
+* Summary:
+*  Returns the modelled current of a power mode at a core clock.
+*
+* Parameters:
+*  energy_mode_t mode : Power mode
+*  uint32_t mhz       : Core clock in MHz
+*
+* Return:
+*  Current in microamperes
+*
+*******************************************************************************/
+static uint32_t mode_current_ua(energy_mode_t mode, uint32_t mhz)
+{
+    return (ENERGY_MODE_SLEEP == mode) ?
+           (ENERGY_SLEEP_BASE_UA + (ENERGY_SLEEP_UA_PER_MHZ * mhz)) :
+           (ENERGY_ACTIVE_BASE_UA + (ENERGY_ACTIVE_UA_PER_MHZ * mhz));
+}
+
+/*******************************************************************************
+* Function Name: print_line
+********************************************************************************
+* Summary:
+*  Prints the charge of one stage. The charge per operation is in nC; the
+*  average current the stage adds, in uA, is also its charge per hour in uAh.
+*
+* Parameters:
+*  const char *name    : Stage name
+*  uint32_t ops        : Operations counted, 0 to print only the average
+*  uint64_t cycles     : Total core cycles in the stage
+*  uint64_t us         : Total time in the stage
+*  uint32_t current_ua : Current of the power mode of the stage
+*  uint32_t uptime_ms  : Time since start, not 0
+*
+* Return:
+*  Average current of the stage in nA
+*
+*******************************************************************************/
+static uint32_t print_line(const char *name, uint32_t ops, uint64_t cycles,
+                           uint64_t us, uint32_t current_ua,
+                           uint32_t uptime_ms)
+{
+    /* uA * us = pC, and pC / ms = nA */
+    uint64_t charge_pc = (uint64_t)current_ua * us;
+    uint32_t average_na = (uint32_t)(charge_pc / uptime_ms);
+    uint32_t cycles_per_op = 0u;
+    uint32_t nc_per_op = 0u;
+
+    if (0u != ops)
+    {
+        cycles_per_op = (uint32_t)(cycles / ops);
+        nc_per_op = (uint32_t)(charge_pc / PC_PER_NC / ops);
+    }
+
+    printf("  %-18s: %" PRIu32 " ops, %" PRIu32 " cycles/op, %" PRIu32
+           " nC/op, %" PRIu32 ".%03" PRIu32 " uAh/h\r\n", name, ops,
+           cycles_per_op, nc_per_op, average_na / NA_PER_UA,
+           average_na % NA_PER_UA);
+
+    return average_na;
+}
+
+/* [] END OF FILE */
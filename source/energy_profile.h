@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name:   energy_profile.h
+*
+* Description: Charge estimate per operation from per-stage cycle counts and a
+*              current model per power mode.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENERGY_PROFILE_H
+#define ENERGY_PROFILE_H
+
+#include "cy_pdl.h"
+#include "cycle_counter.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Current model of the board per power mode: a fixed part and a part that
+   scales with the core clock. Replace with values measured on the target
+   board; tools/energy_model.py reads the defaults from this file. */
+#ifndef ENERGY_ACTIVE_BASE_UA
+#define ENERGY_ACTIVE_BASE_UA (9000u)
+#define ENERGY_ACTIVE_UA_PER_MHZ (120u)
+#define ENERGY_SLEEP_BASE_UA (9000u)
+#define ENERGY_SLEEP_UA_PER_MHZ (40u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    ENERGY_MODE_ACTIVE = 0u,    /* CPU running */
+    ENERGY_MODE_SLEEP = 1u,     /* CPU Sleep, peripherals and UART running */
+    ENERGY_MODES = 2u,
+} energy_mode_t;
+
+typedef enum
+{
+    ENERGY_STAGE_DISPLAY = 0u,          /* Clock or world clock redraw */
+    ENERGY_STAGE_UART_ECHO = 1u,        /* Echo of a typed character */
+    ENERGY_STAGE_PARSE = 2u,            /* Console line or binary frame */
+    ENERGY_STAGE_DST = 3u,              /* DST status and transitions */
+    ENERGY_STAGE_SLEEP_TRANSITION = 4u, /* Tickless idle entry and exit */
+    ENERGY_STAGE_SLEEP = 5u,            /* Time in CPU Sleep */
+    ENERGY_STAGES = 6u,
+} energy_stage_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void energy_profile_record(energy_stage_t stage, uint32_t start);
+void energy_profile_add(energy_stage_t stage, uint32_t cycles);
+void energy_profile_print(void);
+
+/*******************************************************************************
+* Function Name: energy_profile_start
+********************************************************************************
+* Summary:
+*  Returns the start of a stage, to be passed to energy_profile_record().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Current cycle count
+*
+*******************************************************************************/
+static inline uint32_t energy_profile_start(void)
+{
+    return cycle_counter_read();
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ENERGY_PROFILE_H */
+
+/* [] END OF FILE */
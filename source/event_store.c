@@ -0,0 +1,894 @@
+/******************************************************************************
+* File Name:   event_store.c
+*
+* Description: Calendar event store. Events live in a fixed pool and are indexed
+*              by a treap keyed by the packed (start, handle) value, so insert,
+*              delete and next-event queries are O(log n). Each node also keeps
+*              the latest end time of its subtree, which turns the treap into an
+*              interval tree for "active at" queries. The earliest event is armed
+*              in the alarm scheduler, so nothing is scanned at the RTC tick.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "event_store.h"
+#include "alarm_scheduler.h"
+#include "binary_command.h"
+#include "rtc_timebase.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define NIL (EVENT_STORE_INVALID)
+/* Marks a node on the free list, stored in its right link */
+#define FREE_MARK (0xFFFEu)
+/* Knuth's multiplicative hash, a bijection, so priorities never tie */
+#define PRIORITY_HASH (2654435761UL)
+
+/* Binary command actions, first payload byte */
+#define EVENT_ACTION_ADD (0u)
+#define EVENT_ACTION_DELETE (1u)
+#define EVENT_ACTION_NEXT (2u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;
+    uint32_t period;
+    uint32_t max_end;   /* Latest end in the subtree */
+    uint16_t left;      /* Next free node while on the free list */
+    uint16_t right;
+} event_node_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static event_node_t nodes[EVENT_STORE_CAPACITY];
+static uint16_t root = NIL;
+static uint16_t free_list = NIL;
+static uint32_t event_count;
+static event_store_callback_t event_callback;
+static int32_t alarm_id = ALARM_SCHEDULER_INVALID;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint16_t tree_insert(uint16_t tree, uint16_t node);
+static uint16_t tree_remove(uint16_t tree, uint16_t node);
+static uint16_t tree_merge(uint16_t low, uint16_t high);
+static uint16_t tree_first(void);
+static uint32_t tree_collect(uint16_t tree, uint32_t time,
+                             event_handle_t *handles, uint32_t max_handles,
+                             uint32_t found);
+static void arm_first(void);
+static void on_event_alarm(void *context);
+static binary_command_status_t event_command(const uint8_t *payload,
+                                             uint32_t length,
+                                             uint8_t *response,
+                                             uint32_t *response_length);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: key_of
+********************************************************************************
+* Summary:
+*  Returns the tree key of a node: the start time, made unique by the handle.
+*
+* Parameters:
+*  uint16_t node : Node index
+*
+* Return:
+*  Key of the node
+*
+*******************************************************************************/
+static inline uint64_t key_of(uint16_t node)
+{
+    return ((uint64_t)nodes[node].start << 16u) | node;
+}
+
+/*******************************************************************************
+* Function Name: priority_of
+********************************************************************************
+* Summary:
+*  Returns the heap priority of a node, derived from its handle.
+*
+* Parameters:
+*  uint16_t node : Node index
+*
+* Return:
+*  Priority of the node
+*
+*******************************************************************************/
+static inline uint32_t priority_of(uint16_t node)
+{
+    return (uint32_t)node * PRIORITY_HASH;
+}
+
+/*******************************************************************************
+* Function Name: update_max_end
+********************************************************************************
+* Summary:
+*  Recomputes the subtree end time of a node from its children.
+*
+* Parameters:
+*  uint16_t node : Node index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void update_max_end(uint16_t node)
+{
+    event_node_t *n = &nodes[node];
+    uint32_t max_end = n->end;
+
+    if ((NIL != n->left) && (nodes[n->left].max_end > max_end))
+    {
+        max_end = nodes[n->left].max_end;
+    }
+    if ((NIL != n->right) && (nodes[n->right].max_end > max_end))
+    {
+        max_end = nodes[n->right].max_end;
+    }
+    n->max_end = max_end;
+}
+
+/*******************************************************************************
+* Function Name: event_store_init
+********************************************************************************
+* Summary:
+*  Empties the store and sets the callback for starting events.
+*
+* Parameters:
+*  event_store_callback_t callback : Called from the RTC interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_store_init(event_store_callback_t callback)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    for (uint32_t i = 0; i < EVENT_STORE_CAPACITY; i++)
+    {
+        nodes[i].left = (uint16_t)(i + 1u);
+        nodes[i].right = FREE_MARK;
+    }
+    nodes[EVENT_STORE_CAPACITY - 1u].left = NIL;
+
+    free_list = 0u;
+    root = NIL;
+    event_count = 0u;
+    event_callback = callback;
+    (void)alarm_scheduler_cancel(alarm_id);
+    alarm_id = ALARM_SCHEDULER_INVALID;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: event_store_insert
+********************************************************************************
+* Summary:
+*  Adds an event. A recurring event whose start has passed first fires at
+*  the next RTC second and then moves on by its period.
+*
+* Parameters:
+*  const event_t *event : Event to add
+*
+* Return:
+*  Handle of the event, or EVENT_STORE_INVALID if the pool is full or the
+*  event ends before it starts
+*
+*******************************************************************************/
+event_handle_t event_store_insert(const event_t *event)
+{
+    uint16_t node;
+
+    if (event->end < event->start)
+    {
+        return EVENT_STORE_INVALID;
+    }
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    node = free_list;
+    if (NIL != node)
+    {
+        free_list = nodes[node].left;
+
+        nodes[node].start = event->start;
+        nodes[node].end = event->end;
+        nodes[node].period = event->period;
+        nodes[node].max_end = event->end;
+        nodes[node].left = NIL;
+        nodes[node].right = NIL;
+
+        root = tree_insert(root, node);
+        event_count++;
+
+        if (tree_first() == node)
+        {
+            arm_first();
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return node;
+}
+
+/*******************************************************************************
+* Function Name: event_store_delete
+********************************************************************************
+* Summary:
+*  Removes an event.
+*
+* Parameters:
+*  event_handle_t handle : Handle from event_store_insert()
+*
+* Return:
+*  true if the event was removed, false if the handle is not in use
+*
+*******************************************************************************/
+bool event_store_delete(event_handle_t handle)
+{
+    bool removed = false;
+
+    if (handle >= EVENT_STORE_CAPACITY)
+    {
+        return false;
+    }
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    if (FREE_MARK != nodes[handle].right)
+    {
+        bool was_first = (tree_first() == handle);
+
+        root = tree_remove(root, handle);
+        nodes[handle].left = free_list;
+        nodes[handle].right = FREE_MARK;
+        free_list = handle;
+        event_count--;
+
+        if (was_first)
+        {
+            arm_first();
+        }
+        removed = true;
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return removed;
+}
+
+/*******************************************************************************
+* Function Name: event_store_get
+********************************************************************************
+* Summary:
+*  Reads an event. The start of a recurring event is its next occurrence.
+*
+* Parameters:
+*  event_handle_t handle : Handle from event_store_insert()
+*  event_t *event        : The event
+*
+* Return:
+*  true on success, false if the handle is not in use
+*
+*******************************************************************************/
+bool event_store_get(event_handle_t handle, event_t *event)
+{
+    bool used = false;
+
+    if (handle < EVENT_STORE_CAPACITY)
+    {
+        uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+        used = (FREE_MARK != nodes[handle].right);
+        if (used)
+        {
+            event->start = nodes[handle].start;
+            event->end = nodes[handle].end;
+            event->period = nodes[handle].period;
+        }
+
+        Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+    }
+
+    return used;
+}
+
+/*******************************************************************************
+* Function Name: event_store_next_after
+********************************************************************************
+* Summary:
+*  Finds the first event that starts at or after a time.
+*
+* Parameters:
+*  uint32_t time  : Seconds since 2000
+*  event_t *event : The event found, may be NULL
+*
+* Return:
+*  Handle of the event, or EVENT_STORE_INVALID if there is none
+*
+*******************************************************************************/
+event_handle_t event_store_next_after(uint32_t time, event_t *event)
+{
+    uint16_t best = NIL;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    for (uint16_t node = root; NIL != node; )
+    {
+        if (nodes[node].start >= time)
+        {
+            best = node;
+            node = nodes[node].left;
+        }
+        else
+        {
+            node = nodes[node].right;
+        }
+    }
+
+    if ((NIL != best) && (NULL != event))
+    {
+        event->start = nodes[best].start;
+        event->end = nodes[best].end;
+        event->period = nodes[best].period;
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return best;
+}
+
+/*******************************************************************************
+* Function Name: event_store_find_active
+********************************************************************************
+* Summary:
+*  Finds the events in progress at a time, that is start <= time < end.
+*  Subtrees that end before the time are skipped, but a subtree whose latest
+*  end passes the time may still hold no match, so the cost is
+*  O(min(n, k log n)) for k events found.
+*
+* Parameters:
+*  uint32_t time           : Seconds since 2000
+*  event_handle_t *handles : Handles of the events found, in start order
+*  uint32_t max_handles    : Capacity of handles
+*
+* Return:
+*  Number of handles stored
+*
+*******************************************************************************/
+uint32_t event_store_find_active(uint32_t time, event_handle_t *handles,
+                                 uint32_t max_handles)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t found = tree_collect(root, time, handles, max_handles, 0u);
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: event_store_count
+********************************************************************************
+* Summary:
+*  Returns the number of stored events.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Number of events
+*
+*******************************************************************************/
+uint32_t event_store_count(void)
+{
+    return event_count;
+}
+
+/*******************************************************************************
+* Function Name: event_store_rearm
+********************************************************************************
+* Summary:
+*  Re-arms the alarm of the earliest event. Call after the wall-clock time
+*  was moved, i.e. after rtc_timebase_resync().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_store_rearm(void)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    arm_first();
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: event_store_register_commands
+********************************************************************************
+* Summary:
+*  Registers the event binary command.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_store_register_commands(void)
+{
+    (void)binary_command_register(BINARY_COMMAND_EVENT, event_command);
+}
+
+/*******************************************************************************
+* Function Name: tree_insert
+********************************************************************************
+* Summary:
+*  Inserts a node by key and rotates it up while its priority is higher than
+*  its parent's. The recursion depth is the treap height, O(log n) expected.
+*
+* Parameters:
+*  uint16_t tree : Root of the subtree
+*  uint16_t node : Node to insert
+*
+* Return:
+*  New root of the subtree
+*
+*******************************************************************************/
+static uint16_t tree_insert(uint16_t tree, uint16_t node)
+{
+    if (NIL == tree)
+    {
+        return node;
+    }
+
+    event_node_t *t = &nodes[tree];
+
+    if (key_of(node) < key_of(tree))
+    {
+        t->left = tree_insert(t->left, node);
+        if (priority_of(t->left) > priority_of(tree))
+        {
+            /* Rotate right */
+            uint16_t top = t->left;
+            t->left = nodes[top].right;
+            nodes[top].right = tree;
+            update_max_end(tree);
+            tree = top;
+        }
+    }
+    else
+    {
+        t->right = tree_insert(t->right, node);
+        if (priority_of(t->right) > priority_of(tree))
+        {
+            /* Rotate left */
+            uint16_t top = t->right;
+            t->right = nodes[top].left;
+            nodes[top].left = tree;
+            update_max_end(tree);
+            tree = top;
+        }
+    }
+
+    update_max_end(tree);
+
+    return tree;
+}
+
+/*******************************************************************************
+* Function Name: tree_remove
+********************************************************************************
+* Summary:
+*  Removes a node that is in the subtree by merging its children.
+*
+* Parameters:
+*  uint16_t tree : Root of the subtree
+*  uint16_t node : Node to remove
+*
+* Return:
+*  New root of the subtree
+*
+*******************************************************************************/
+static uint16_t tree_remove(uint16_t tree, uint16_t node)
+{
+    if (tree == node)
+    {
+        return tree_merge(nodes[node].left, nodes[node].right);
+    }
+
+    if (key_of(node) < key_of(tree))
+    {
+        nodes[tree].left = tree_remove(nodes[tree].left, node);
+    }
+    else
+    {
+        nodes[tree].right = tree_remove(nodes[tree].right, node);
+    }
+
+    update_max_end(tree);
+
+    return tree;
+}
+
+/*******************************************************************************
+* Function Name: tree_merge
+********************************************************************************
+* Summary:
+*  Joins two subtrees where every key of the first is below the second.
+*
+* Parameters:
+*  uint16_t low  : Subtree with the lower keys
+*  uint16_t high : Subtree with the higher keys
+*
+* Return:
+*  Root of the joined subtree
+*
+*******************************************************************************/
+static uint16_t tree_merge(uint16_t low, uint16_t high)
+{
+    if (NIL == low)
+    {
+        return high;
+    }
+    if (NIL == high)
+    {
+        return low;
+    }
+
+    if (priority_of(low) > priority_of(high))
+    {
+        nodes[low].right = tree_merge(nodes[low].right, high);
+        update_max_end(low);
+        return low;
+    }
+
+    nodes[high].left = tree_merge(low, nodes[high].left);
+    update_max_end(high);
+    return high;
+}
+
+/*******************************************************************************
+* Function Name: tree_first
+********************************************************************************
+* Summary:
+*  Returns the event with the earliest start.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Handle of the event, or EVENT_STORE_INVALID if the store is empty
+*
+*******************************************************************************/
+static uint16_t tree_first(void)
+{
+    uint16_t node = root;
+
+    if (NIL != node)
+    {
+        while (NIL != nodes[node].left)
+        {
+            node = nodes[node].left;
+        }
+    }
+
+    return node;
+}
+
+/*******************************************************************************
+* Function Name: tree_collect
+********************************************************************************
+* Summary:
+*  Collects the events of a subtree that are in progress at a time.
+*
+* Parameters:
+*  uint16_t tree           : Root of the subtree
+*  uint32_t time           : Seconds since 2000
+*  event_handle_t *handles : Handles of the events found
+*  uint32_t max_handles    : Capacity of handles
+*  uint32_t found          : Number of handles already stored
+*
+* Return:
+*  Number of handles stored
+*
+*******************************************************************************/
+static uint32_t tree_collect(uint16_t tree, uint32_t time,
+                             event_handle_t *handles, uint32_t max_handles,
+                             uint32_t found)
+{
+    if ((NIL == tree) || (nodes[tree].max_end <= time) ||
+        (found >= max_handles))
+    {
+        return found;
+    }
+
+    found = tree_collect(nodes[tree].left, time, handles, max_handles, found);
+
+    /* The right subtree starts later still */
+    if (nodes[tree].start <= time)
+    {
+        if ((nodes[tree].end > time) && (found < max_handles))
+        {
+            handles[found++] = tree;
+        }
+        found = tree_collect(nodes[tree].right, time, handles, max_handles,
+                             found);
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: arm_first
+********************************************************************************
+* Summary:
+*  Schedules the alarm for the earliest event. The event times are wall-clock
+*  seconds and the scheduler counts monotonic seconds, so the distance to the
+*  start is added to the monotonic time, saturating at the last monotonic
+*  second rather than wrapping to an early one. Called with interrupts
+*  disabled or from the RTC interrupt.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void arm_first(void)
+{
+    uint16_t first = tree_first();
+
+    (void)alarm_scheduler_cancel(alarm_id);
+    alarm_id = ALARM_SCHEDULER_INVALID;
+
+    if (NIL != first)
+    {
+        uint32_t now = rtc_timebase_seconds();
+        uint32_t due = rtc_timebase_monotonic_seconds();
+
+        if (nodes[first].start > now)
+        {
+            uint32_t distance = nodes[first].start - now;
+
+            due = (distance > (UINT32_MAX - due)) ? UINT32_MAX :
+                                                    (due + distance);
+        }
+
+        alarm_id = alarm_scheduler_add(due, on_event_alarm, NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: on_event_alarm
+********************************************************************************
+* Summary:
+*  Alarm scheduler callback, runs in the RTC interrupt. Reports every event
+*  that has started; recurring events move to their next occurrence after the
+*  current time and one-off events are removed before their callback.
+*
+* Parameters:
+*  void *context : Unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void on_event_alarm(void *context)
+{
+    uint32_t now = rtc_timebase_seconds();
+    uint16_t first;
+
+    CY_UNUSED_PARAMETER(context);
+    alarm_id = ALARM_SCHEDULER_INVALID;
+
+    for (first = tree_first();
+         (NIL != first) && (nodes[first].start <= now);
+         first = tree_first())
+    {
+        event_node_t *n = &nodes[first];
+        event_t event = { n->start, n->end, n->period };
+
+        root = tree_remove(root, first);
+
+        if (EVENT_STORE_ONCE != n->period)
+        {
+            uint32_t skip = (((now - n->start) / n->period) + 1u) * n->period;
+
+            n->start += skip;
+            n->end += skip;
+            n->max_end = n->end;
+            n->left = NIL;
+            n->right = NIL;
+            root = tree_insert(root, first);
+        }
+        else
+        {
+            n->left = free_list;
+            n->right = FREE_MARK;
+            free_list = first;
+            event_count--;
+        }
+
+        if (NULL != event_callback)
+        {
+            event_callback(first, &event);
+        }
+    }
+
+    arm_first();
+}
+
+/*******************************************************************************
+* Function Name: get_u32
+********************************************************************************
+* Summary:
+*  Reads a little-endian value.
+*
+* Parameters:
+*  const uint8_t *data : Source, 4 bytes
+*
+* Return:
+*  The value
+*
+*******************************************************************************/
+static inline uint32_t get_u32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8u) |
+           ((uint32_t)data[2] << 16u) | ((uint32_t)data[3] << 24u);
+}
+
+/*******************************************************************************
+* Function Name: put_u32
+********************************************************************************
+* Summary:
+*  Stores a value little-endian.
+*
+* Parameters:
+*  uint8_t *data  : Destination, 4 bytes
+*  uint32_t value : Value to store
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void put_u32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8u);
+    data[2] = (uint8_t)(value >> 16u);
+    data[3] = (uint8_t)(value >> 24u);
+}
+
+/*******************************************************************************
+* Function Name: event_command
+********************************************************************************
+* Summary:
+*  Binary command handler. Payload: action, then
+*   - add:    start, end, period (LE32 each); response: handle (LE16)
+*   - delete: handle (LE16)
+*   - next:   time (LE32); response: handle (LE16), start, end (LE32 each)
+*
+* Parameters:
+*  const uint8_t *payload    : Request payload
+*  uint32_t length           : Payload length
+*  uint8_t *response         : Response data
+*  uint32_t *response_length : Number of response bytes
+*
+* Return:
+*  Command status
+*
+*******************************************************************************/
+static binary_command_status_t event_command(const uint8_t *payload,
+                                             uint32_t length,
+                                             uint8_t *response,
+                                             uint32_t *response_length)
+{
+    event_t event;
+    event_handle_t handle;
+
+    if (0u == length)
+    {
+        return BINARY_COMMAND_BAD_LENGTH;
+    }
+
+    if ((EVENT_ACTION_ADD == payload[0]) && (13u == length))
+    {
+        event.start = get_u32(&payload[1]);
+        event.end = get_u32(&payload[5]);
+        event.period = get_u32(&payload[9]);
+        handle = event_store_insert(&event);
+        if (EVENT_STORE_INVALID == handle)
+        {
+            return BINARY_COMMAND_FAILED;
+        }
+    }
+    else if ((EVENT_ACTION_DELETE == payload[0]) && (3u == length))
+    {
+        handle = (event_handle_t)(payload[1] | (payload[2] << 8u));
+        return event_store_delete(handle) ? BINARY_COMMAND_OK :
+                                            BINARY_COMMAND_FAILED;
+    }
+    else if ((EVENT_ACTION_NEXT == payload[0]) && (5u == length))
+    {
+        handle = event_store_next_after(get_u32(&payload[1]), &event);
+        if (EVENT_STORE_INVALID == handle)
+        {
+            return BINARY_COMMAND_FAILED;
+        }
+        put_u32(&response[2], event.start);
+        put_u32(&response[6], event.end);
+        *response_length = 10u;
+    }
+    else
+    {
+        return BINARY_COMMAND_BAD_LENGTH;
+    }
+
+    response[0] = (uint8_t)handle;
+    response[1] = (uint8_t)(handle >> 8u);
+    if (0u == *response_length)
+    {
+        *response_length = 2u;
+    }
+
+    return BINARY_COMMAND_OK;
+}
+
+/* [] END OF FILE */
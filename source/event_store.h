@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name:   event_store.h
+*
+* Description: Public interface of the calendar event store.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of events in the fixed pool, at most 0xFFFE */
+#ifndef EVENT_STORE_CAPACITY
+#define EVENT_STORE_CAPACITY (2048u)
+#endif
+
+#define EVENT_STORE_INVALID (0xFFFFu)
+
+/* Common recurrence periods */
+#define EVENT_STORE_ONCE (0u)
+#define EVENT_STORE_DAILY (86400u)
+#define EVENT_STORE_WEEKLY (604800u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint16_t event_handle_t;
+
+/* Times are local RTC seconds since 2000-01-01, see calendar_to_seconds() */
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;       /* First second after the event, at least start */
+    uint32_t period;    /* Recurrence in seconds, EVENT_STORE_ONCE if none */
+} event_t;
+
+/* Called from the RTC interrupt when an event starts */
+typedef void (*event_store_callback_t)(event_handle_t handle,
+                                       const event_t *event);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void event_store_init(event_store_callback_t callback);
+event_handle_t event_store_insert(const event_t *event);
+bool event_store_delete(event_handle_t handle);
+bool event_store_get(event_handle_t handle, event_t *event);
+event_handle_t event_store_next_after(uint32_t time, event_t *event);
+uint32_t event_store_find_active(uint32_t time, event_handle_t *handles,
+                                 uint32_t max_handles);
+uint32_t event_store_count(void);
+void event_store_rearm(void);
+void event_store_register_commands(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* EVENT_STORE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/******************************************************************************
+* File Name:   ilo_check.c
+*
+* Description: Boot-time check of the ILO that clocks the RTC, measured against
+*              the IMO with the clock measurement counters.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "ilo_check.h"
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The counters must finish within this many nominal windows */
+#define TIMEOUT_WINDOWS (4u)
+
+#define PPM (1000000UL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ilo_check_result_t result;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: ilo_check_run
+********************************************************************************
+* Summary:
+*  Counts ILO_CHECK_COUNT ILO cycles against the IMO with the hardware clock
+*  measurement counters, and derives the length of an RTC second in core
+*  cycles. An ILO that does not run or is more than 12.5% off nominal is
+*  rejected. The accuracy is limited by the IMO tolerance and by the
+*  resolution of one IMO count.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  true if the ILO is within the tolerance
+*
+*******************************************************************************/
+bool ilo_check_run(void)
+{
+    uint32_t window = (uint32_t)(((uint64_t)SystemCoreClock * ILO_CHECK_COUNT) /
+                                 ILO_CHECK_NOMINAL_HZ);
+    uint32_t nominal = ILO_CHECK_NOMINAL_HZ;
+    uint32_t start;
+    bool done = false;
+
+    cycle_counter_init();
+    start = cycle_counter_read();
+
+    result.valid = false;
+    result.ilo_hz = 0u;
+
+    if (CY_SYSCLK_SUCCESS ==
+        Cy_SysClk_StartClkMeasurementCounters(CY_SYSCLK_MEAS_CLK_ILO,
+                                              ILO_CHECK_COUNT,
+                                              CY_SYSCLK_MEAS_CLK_IMO))
+    {
+        do
+        {
+            done = Cy_SysClk_ClkMeasurementCountersDone();
+        } while (!done &&
+                 ((cycle_counter_read() - start) < (TIMEOUT_WINDOWS * window)));
+    }
+
+    if (done)
+    {
+        result.ilo_hz = Cy_SysClk_ClkMeasurementCountersGetFreq(false,
+                                                                CY_SYSCLK_IMO_FREQ);
+    }
+
+    result.duration_cycles = cycle_counter_read() - start;
+    result.resolution_ppm = (uint32_t)(((uint64_t)PPM * ILO_CHECK_NOMINAL_HZ) /
+                                       ((uint64_t)CY_SYSCLK_IMO_FREQ *
+                                        ILO_CHECK_COUNT));
+
+    if ((result.ilo_hz > (nominal - (nominal >> ILO_CHECK_TOLERANCE_SHIFT))) &&
+        (result.ilo_hz < (nominal + (nominal >> ILO_CHECK_TOLERANCE_SHIFT))))
+    {
+        result.valid = true;
+        result.cycles_per_second = (uint32_t)(((uint64_t)SystemCoreClock *
+                                               ILO_CHECK_NOMINAL_HZ) /
+                                              result.ilo_hz);
+    }
+    else
+    {
+        result.cycles_per_second = SystemCoreClock;
+    }
+
+    return result.valid;
+}
+
+/*******************************************************************************
+* Function Name: ilo_check_get_result
+********************************************************************************
+* Summary:
+*  Returns the result of the last ilo_check_run().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Check result
+*
+*******************************************************************************/
+const ilo_check_result_t *ilo_check_get_result(void)
+{
+    return &result;
+}
+
+/* [] END OF FILE */
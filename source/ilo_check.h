@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   ilo_check.h
+*
+* Description: Boot-time check of the ILO that clocks the RTC, measured against
+*              the IMO with the clock measurement counters.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ILO_CHECK_H
+#define ILO_CHECK_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* ILO cycles counted by the check, about 4 ms at the nominal frequency */
+#ifndef ILO_CHECK_COUNT
+#define ILO_CHECK_COUNT (128u)
+#endif
+
+/* Nominal ILO frequency; the RTC counts one second per ILO_CHECK_NOMINAL_HZ */
+#define ILO_CHECK_NOMINAL_HZ (32768UL)
+
+/* Accepted deviation from nominal, 2^-3 = 12.5%, as for a measured second */
+#define ILO_CHECK_TOLERANCE_SHIFT (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    bool valid;                 /* Measured and within the tolerance */
+    uint32_t ilo_hz;            /* Measured ILO frequency, 0 on a timeout */
+    uint32_t cycles_per_second; /* Core cycles per RTC second at ilo_hz */
+    uint32_t duration_cycles;   /* Core cycles taken by the check */
+    uint32_t resolution_ppm;    /* One IMO count over the measuring window */
+} ilo_check_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool ilo_check_run(void);
+const ilo_check_result_t *ilo_check_get_result(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ILO_CHECK_H */
+
+/* [] END OF FILE */
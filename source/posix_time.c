@@ -0,0 +1,509 @@
+/******************************************************************************
+* File Name:   posix_time.c
+*
+* Description: Newlib time(), _gettimeofday() and clock_gettime() backed by the
+*              interpolated RTC time base, without RTC register reads, and
+*              gmtime_r(), localtime_r() and mktime() on the calendar library
+*              and the local DST rule.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "posix_time.h"
+#include "rtc_timebase.h"
+#include "world_clock.h"
+#include "calendar.h"
+#include <errno.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 2000-01-01 00:00:00 UTC in seconds since 1970-01-01 */
+#define POSIX_TIME_EPOCH_2000 (946684800UL)
+
+#define SECONDS_PER_MINUTE (60)
+#define SECONDS_PER_HOUR (3600)
+#define SECONDS_PER_DAY (86400L)
+#define NS_PER_US (1000L)
+#define MONTHS_PER_YEAR (12)
+#define TM_YEAR_BASE (1900)
+
+/* Standard-time offset of the RTC zone, and the DST shift added to it */
+#define LOCAL_STD_OFFSET (WORLD_CLOCK_LOCAL_UTC_OFFSET_MIN * SECONDS_PER_MINUTE)
+#define DST_SHIFT (SECONDS_PER_HOUR)
+
+/* Day range of calendar_from_days(): 0000-03-01 .. INT32_MAX days after 2000 */
+#define MIN_DAYS (-730425L)
+#define MAX_DAYS (INT32_MAX)
+
+/* Year range of calendar_days_from_epoch() */
+#define MIN_YEAR (1)
+#define MAX_YEAR (5000000L)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* UTC seconds since 1970 minus the monotonic seconds of the time base */
+static volatile uint32_t utc_base;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if defined(__NEWLIB__)
+static int32_t local_offset(int64_t utc);
+static struct tm *break_down(int64_t seconds, struct tm *result);
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: posix_time_sync
+********************************************************************************
+* Summary:
+*  Converts the local RTC time to UTC and stores its distance to the monotonic
+*  time base. Call at boot and after the time or the DST rule was changed. A
+*  DST transition moves the local time but not UTC, so it needs no call.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void posix_time_sync(void)
+{
+    /* Both values from the same second tick */
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t local = rtc_timebase_seconds();
+    uint32_t mono = rtc_timebase_monotonic_seconds();
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    /* The world clock resolves the hour repeated after the DST stop */
+    uint32_t utc = world_clock_local_to_utc(local);
+
+    utc_base = (utc + POSIX_TIME_EPOCH_2000) - mono;
+}
+
+#if defined(__NEWLIB__)
+/*******************************************************************************
+* Function Name: time
+********************************************************************************
+* Summary:
+*  Overrides the newlib time(), which goes through _gettimeofday_r(). Returns
+*  the UTC time of the last RTC second tick.
+*
+* Parameters:
+*  time_t *timer : Also receives the time if not NULL
+*
+* Return:
+*  UTC seconds since 1970-01-01
+*
+*******************************************************************************/
+time_t time(time_t *timer)
+{
+    time_t now = (time_t)(rtc_timebase_monotonic_seconds() + utc_base);
+
+    if (NULL != timer)
+    {
+        *timer = now;
+    }
+
+    return now;
+}
+
+/*******************************************************************************
+* Function Name: _gettimeofday
+********************************************************************************
+* Summary:
+*  Newlib syscall behind gettimeofday(). Returns UTC with microsecond
+*  resolution. Time zones are not supported.
+*
+* Parameters:
+*  struct timeval *tv : Receives the time, may be NULL
+*  void *tz           : Ignored
+*
+* Return:
+*  0
+*
+*******************************************************************************/
+int _gettimeofday(struct timeval *tv, void *tz)
+{
+    (void)tz;
+
+    if (NULL != tv)
+    {
+        uint32_t micros;
+        uint32_t seconds = rtc_timebase_monotonic_split(&micros);
+
+        tv->tv_sec = (time_t)(seconds + utc_base);
+        tv->tv_usec = (suseconds_t)micros;
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: clock_gettime
+********************************************************************************
+* Summary:
+*  Returns CLOCK_REALTIME (UTC since 1970) or CLOCK_MONOTONIC (time since
+*  boot, not moved by setting the time). The resolution is one microsecond.
+*
+* Parameters:
+*  clockid_t clock_id   : CLOCK_REALTIME or CLOCK_MONOTONIC
+*  struct timespec *tp  : Receives the time
+*
+* Return:
+*  0, or -1 with errno set to EINVAL for other clocks
+*
+*******************************************************************************/
+int clock_gettime(clockid_t clock_id, struct timespec *tp)
+{
+    uint32_t micros;
+    uint32_t seconds;
+
+    if (CLOCK_REALTIME == clock_id)
+    {
+        seconds = rtc_timebase_monotonic_split(&micros) + utc_base;
+    }
+    else if (CLOCK_MONOTONIC == clock_id)
+    {
+        seconds = rtc_timebase_monotonic_split(&micros);
+    }
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    tp->tv_sec = (time_t)seconds;
+    tp->tv_nsec = (long)micros * NS_PER_US;
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: gmtime_r
+********************************************************************************
+* Summary:
+*  Overrides the newlib gmtime_r(); also used by gmtime().
+*
+* Parameters:
+*  const time_t *timer : UTC seconds since 1970-01-01
+*  struct tm *result   : Receives the broken-down UTC time
+*
+* Return:
+*  result, or NULL with errno set to EOVERFLOW if the date is out of range
+*
+*******************************************************************************/
+struct tm *gmtime_r(const time_t *timer, struct tm *result)
+{
+    if (NULL == break_down((int64_t)*timer - POSIX_TIME_EPOCH_2000, result))
+    {
+        return NULL;
+    }
+
+    result->tm_isdst = 0;
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: localtime_r
+********************************************************************************
+* Summary:
+*  Overrides the newlib localtime_r(); also used by localtime(). Converts to
+*  the zone the RTC is set to, with the active DST rule, instead of the TZ
+*  environment variable.
+*
+* Parameters:
+*  const time_t *timer : UTC seconds since 1970-01-01
+*  struct tm *result   : Receives the broken-down local time
+*
+* Return:
+*  result, or NULL with errno set to EOVERFLOW if the date is out of range
+*
+*******************************************************************************/
+struct tm *localtime_r(const time_t *timer, struct tm *result)
+{
+    int64_t utc = (int64_t)*timer - POSIX_TIME_EPOCH_2000;
+    int32_t offset = local_offset(utc);
+
+    if (NULL == break_down(utc + offset, result))
+    {
+        return NULL;
+    }
+
+    result->tm_isdst = (LOCAL_STD_OFFSET != offset) ? 1 : 0;
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: mktime
+********************************************************************************
+* Summary:
+*  Overrides the newlib mktime(). Converts a local time to UTC and normalises
+*  the fields, as localtime_r() would return them. With tm_isdst negative the
+*  DST state is taken from the local rule; a time in the gap of the DST start
+*  then moves forward by the DST shift.
+*
+* Parameters:
+*  struct tm *timeptr : Local time; fields may be out of their ranges
+*
+* Return:
+*  UTC seconds since 1970-01-01, or (time_t)-1 if the date is out of range
+*
+*******************************************************************************/
+time_t mktime(struct tm *timeptr)
+{
+    /* Fold the month into the year; the other fields add up linearly */
+    int64_t year = (int64_t)timeptr->tm_year + TM_YEAR_BASE +
+                   (timeptr->tm_mon / MONTHS_PER_YEAR);
+    int32_t month = timeptr->tm_mon % MONTHS_PER_YEAR;
+    int32_t offset;
+
+    if (month < 0)
+    {
+        month += MONTHS_PER_YEAR;
+        year--;
+    }
+
+    if ((year < MIN_YEAR) || (year > MAX_YEAR))
+    {
+        errno = EOVERFLOW;
+        return (time_t)-1;
+    }
+
+    int64_t days = (int32_t)calendar_days_from_epoch(1u, (uint32_t)month + 1u,
+                                                     (uint32_t)year);
+    int64_t local = ((days + timeptr->tm_mday - 1) * SECONDS_PER_DAY) +
+                    ((int64_t)timeptr->tm_hour * SECONDS_PER_HOUR) +
+                    ((int64_t)timeptr->tm_min * SECONDS_PER_MINUTE) +
+                    timeptr->tm_sec;
+
+    if (timeptr->tm_isdst < 0)
+    {
+        /* Find the offset at the standard-time guess of UTC. In the gap of
+           the DST start it is the DST offset, but the instant it gives is
+           still in standard time; the second lookup moves the time forward */
+        offset = local_offset(local - LOCAL_STD_OFFSET);
+        offset = local_offset(local - offset);
+    }
+    else
+    {
+        offset = LOCAL_STD_OFFSET + ((timeptr->tm_isdst > 0) ? DST_SHIFT : 0);
+    }
+
+    time_t utc = (time_t)(local - offset + POSIX_TIME_EPOCH_2000);
+
+    if (NULL == localtime_r(&utc, timeptr))
+    {
+        return (time_t)-1;
+    }
+
+    return utc;
+}
+
+#if !defined(NDEBUG)
+/*******************************************************************************
+* Function Name: posix_time_self_test
+********************************************************************************
+* Summary:
+*  Checks gmtime_r(), localtime_r() and mktime() for every day from 1970 to
+*  2105, each at a different time of day, against a day-by-day walk with the
+*  PDL calendar functions. Debug builds only.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  true if all conversions match
+*
+*******************************************************************************/
+bool posix_time_self_test(void)
+{
+    bool rslt = true;
+    time_t midnight = 0;
+    uint32_t day = 0u;
+
+    for (uint32_t year = 1970u; rslt && (year <= 2105u); year++)
+    {
+        int yday = 0;
+
+        for (uint32_t month = 1u; rslt && (month <= 12u); month++)
+        {
+            uint32_t last = Cy_RTC_DaysInMonth(month, year);
+
+            for (uint32_t mday = 1u; rslt && (mday <= last); mday++)
+            {
+                int32_t second_of_day = (int32_t)((day * 7919u) %
+                                                  (uint32_t)SECONDS_PER_DAY);
+                time_t now = midnight + second_of_day;
+                struct tm utc;
+                struct tm local;
+                struct tm norm;
+
+                rslt = (NULL != gmtime_r(&now, &utc)) &&
+                       (utc.tm_year == ((int)year - TM_YEAR_BASE)) &&
+                       (utc.tm_mon == ((int)month - 1)) &&
+                       (utc.tm_mday == (int)mday) &&
+                       (utc.tm_wday == (int)(Cy_RTC_ConvertDayOfWeek(mday,
+                                        month, year) - CY_RTC_SUNDAY)) &&
+                       (utc.tm_yday == yday) &&
+                       (utc.tm_hour == (second_of_day / SECONDS_PER_HOUR)) &&
+                       (utc.tm_min == ((second_of_day % SECONDS_PER_HOUR) /
+                                       SECONDS_PER_MINUTE)) &&
+                       (utc.tm_sec == (second_of_day % SECONDS_PER_MINUTE));
+
+                /* The local time converts back to the same instant */
+                rslt = rslt && (NULL != localtime_r(&now, &local));
+                norm = local;
+                rslt = rslt && (mktime(&norm) == now) &&
+                       (norm.tm_mday == local.tm_mday) &&
+                       (norm.tm_hour == local.tm_hour) &&
+                       (norm.tm_isdst == local.tm_isdst);
+
+                /* The day of the year given as an overflowing day of January */
+                norm = utc;
+                norm.tm_mon = 0;
+                norm.tm_mday = yday + 1;
+                norm.tm_isdst = 0;
+                rslt = rslt && (mktime(&norm) == (now - LOCAL_STD_OFFSET));
+
+                midnight += SECONDS_PER_DAY;
+                day++;
+                yday++;
+            }
+        }
+    }
+
+    return rslt;
+}
+#endif /* NDEBUG */
+
+/*******************************************************************************
+* Function Name: local_offset
+********************************************************************************
+* Summary:
+*  Returns the UTC offset of the RTC zone at an instant. Outside the range of
+*  the world clock, 2000 to 2136, the standard-time offset is returned.
+*
+* Parameters:
+*  int64_t utc : Instant, UTC seconds since 2000
+*
+* Return:
+*  Offset to add to UTC to get the local time, in seconds
+*
+*******************************************************************************/
+static int32_t local_offset(int64_t utc)
+{
+    if ((utc < 0) || (utc > (int64_t)UINT32_MAX))
+    {
+        return LOCAL_STD_OFFSET;
+    }
+
+    return world_clock_local_utc_offset((uint32_t)utc);
+}
+
+/*******************************************************************************
+* Function Name: break_down
+********************************************************************************
+* Summary:
+*  Fills all fields of a struct tm except tm_isdst. Times from 2000 to 2136
+*  take the 32-bit calendar_from_seconds(); others are split into days with
+*  a 64-bit division first.
+*
+* Parameters:
+*  int64_t seconds   : Seconds since 2000-01-01 00:00:00
+*  struct tm *result : Receives the broken-down time
+*
+* Return:
+*  result, or NULL with errno set to EOVERFLOW if the date is out of range
+*
+*******************************************************************************/
+static struct tm *break_down(int64_t seconds, struct tm *result)
+{
+    calendar_date_time_t date;
+
+    if ((seconds >= 0) && (seconds <= (int64_t)UINT32_MAX))
+    {
+        calendar_from_seconds((uint32_t)seconds, &date);
+    }
+    else
+    {
+        int64_t days = seconds / SECONDS_PER_DAY;
+        int32_t rem = (int32_t)(seconds % SECONDS_PER_DAY);
+
+        if (rem < 0)
+        {
+            rem += SECONDS_PER_DAY;
+            days--;
+        }
+
+        if ((days < MIN_DAYS) || (days > MAX_DAYS))
+        {
+            errno = EOVERFLOW;
+            return NULL;
+        }
+
+        calendar_from_days((uint32_t)(int32_t)days, &date);
+        date.hour = (uint32_t)rem / SECONDS_PER_HOUR;
+        date.min = ((uint32_t)rem % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE;
+        date.sec = (uint32_t)rem % SECONDS_PER_MINUTE;
+    }
+
+    result->tm_sec = (int)date.sec;
+    result->tm_min = (int)date.min;
+    result->tm_hour = (int)date.hour;
+    result->tm_mday = (int)date.mday;
+    result->tm_mon = (int)date.month - 1;
+    result->tm_year = (int)date.year - TM_YEAR_BASE;
+    result->tm_wday = (int)date.wday - CY_RTC_SUNDAY;
+    result->tm_yday = (int)calendar_day_of_year(date.mday, date.month,
+                                                date.year);
+
+    return result;
+}
+
+#endif /* __NEWLIB__ */
+
+/* [] END OF FILE */
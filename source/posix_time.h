@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   posix_time.h
+*
+* Description: POSIX time functions of newlib served from the RTC time base and
+*              the local DST rule.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef POSIX_TIME_H
+#define POSIX_TIME_H
+
+#include "cy_pdl.h"
+#include <time.h>
+#include <sys/time.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Clock ids, for newlib configurations that do not define _POSIX_TIMERS */
+#ifndef CLOCK_REALTIME
+#define CLOCK_REALTIME ((clockid_t)1)
+#endif
+#ifndef CLOCK_MONOTONIC
+#define CLOCK_MONOTONIC ((clockid_t)4)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void posix_time_sync(void);
+
+#if defined(__NEWLIB__)
+int _gettimeofday(struct timeval *tv, void *tz);
+int clock_gettime(clockid_t clock_id, struct timespec *tp);
+#if !defined(NDEBUG)
+bool posix_time_self_test(void);
+#endif
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* POSIX_TIME_H */
+
+/* [] END OF FILE */
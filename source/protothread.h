@@ -0,0 +1,149 @@
+/******************************************************************************
+* File Name:   protothread.h
+*
+* Description: Stackless coroutines (protothreads) for input flows that wait on
+*              the console without blocking the main loop.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROTOTHREAD_H
+#define PROTOTHREAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Values returned by a protothread function */
+#define PT_WAITING (0)
+#define PT_YIELDED (1)
+#define PT_EXITED (2)
+#define PT_ENDED (3)
+
+/* A protothread is a function returning char that brackets its body with
+   PT_BEGIN() and PT_END(). A wait stores the source line in the protothread
+   and returns; the next call jumps back to that line through the switch in
+   PT_BEGIN(). The case label sits in an "if (false)" block, so it is only
+   reached by that jump. Local variables are not kept across a wait, so the
+   state of a flow lives in a structure passed to it, and the body must not
+   contain switch statements of its own. */
+#define PT_INIT(pt) ((pt)->line = 0u)
+
+#define PT_BEGIN(pt) \
+    { \
+        bool pt_yielded = true; \
+        (void)pt_yielded; \
+        switch ((pt)->line) \
+        { \
+        case 0u:
+
+#define PT_END(pt) \
+        } \
+        PT_INIT(pt); \
+        return PT_ENDED; \
+    }
+
+/* Returns to the caller until the condition holds */
+#define PT_WAIT_UNTIL(pt, condition) \
+    do \
+    { \
+        (pt)->line = __LINE__; \
+        if (false) \
+        { \
+        case __LINE__:; \
+        } \
+        if (!(condition)) \
+        { \
+            return PT_WAITING; \
+        } \
+    } while (0)
+
+/* Returns to the caller once */
+#define PT_YIELD(pt) \
+    do \
+    { \
+        pt_yielded = false; \
+        (pt)->line = __LINE__; \
+        if (false) \
+        { \
+        case __LINE__:; \
+        } \
+        if (!pt_yielded) \
+        { \
+            return PT_YIELDED; \
+        } \
+    } while (0)
+
+/* Ends the protothread early; the next call starts it again */
+#define PT_EXIT(pt) \
+    do \
+    { \
+        PT_INIT(pt); \
+        return PT_EXITED; \
+    } while (0)
+
+/* true while a protothread call has not finished */
+#define PT_SCHEDULE(call) ((call) < PT_EXITED)
+
+/* Starts a child protothread and waits until it finishes */
+#define PT_SPAWN(pt, child, call) \
+    do \
+    { \
+        PT_INIT(child); \
+        PT_WAIT_UNTIL(pt, !PT_SCHEDULE(call)); \
+    } while (0)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Resume point of a protothread: the source line of its last wait */
+typedef struct
+{
+    uint16_t line;
+} protothread_t;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PROTOTHREAD_H */
+
+/* [] END OF FILE */
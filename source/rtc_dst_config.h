@@ -0,0 +1,56 @@
+/******************************************************************************
+* File Name:   rtc_dst_config.h
+*
+* Description: DST rule of the RTC personality in design.modus.
+*              Generated by tools/rtc_dst_gen.py during PREBUILD. Do not edit.
+*
+* Related Document: See README.md
+*
+*******************************************************************************/
+
+#ifndef RTC_DST_CONFIG_H
+#define RTC_DST_CONFIG_H
+
+/* 1: apply the rule at boot so DST does not need to be keyed in
+   again; from the dst setting of the personality */
+#define RTC_DST_BOOT_ENABLE (1u)
+
+#define CALENDAR_DST_START_FORMAT (CY_RTC_DST_RELATIVE)
+#define CALENDAR_DST_START_HOUR (0u)
+#define CALENDAR_DST_START_DAY_OF_MONTH (22u)
+#define CALENDAR_DST_START_WEEK (CY_RTC_LAST_WEEK_OF_MONTH)
+#define CALENDAR_DST_START_DAY_OF_WEEK (CY_RTC_SUNDAY)
+#define CALENDAR_DST_START_MONTH (CY_RTC_MARCH)
+
+#define CALENDAR_DST_STOP_FORMAT (CY_RTC_DST_RELATIVE)
+#define CALENDAR_DST_STOP_HOUR (0u)
+#define CALENDAR_DST_STOP_DAY_OF_MONTH (22u)
+#define CALENDAR_DST_STOP_WEEK (CY_RTC_LAST_WEEK_OF_MONTH)
+#define CALENDAR_DST_STOP_DAY_OF_WEEK (CY_RTC_SUNDAY)
+#define CALENDAR_DST_STOP_MONTH (CY_RTC_OCTOBER)
+
+#define RTC_DST_CONFIG_INIT \
+{ \
+    .startDst = \
+    { \
+        .format = CALENDAR_DST_START_FORMAT, \
+        .hour = CALENDAR_DST_START_HOUR, \
+        .dayOfMonth = CALENDAR_DST_START_DAY_OF_MONTH, \
+        .weekOfMonth = CALENDAR_DST_START_WEEK, \
+        .dayOfWeek = CALENDAR_DST_START_DAY_OF_WEEK, \
+        .month = CALENDAR_DST_START_MONTH, \
+    }, \
+    .stopDst = \
+    { \
+        .format = CALENDAR_DST_STOP_FORMAT, \
+        .hour = CALENDAR_DST_STOP_HOUR, \
+        .dayOfMonth = CALENDAR_DST_STOP_DAY_OF_MONTH, \
+        .weekOfMonth = CALENDAR_DST_STOP_WEEK, \
+        .dayOfWeek = CALENDAR_DST_STOP_DAY_OF_WEEK, \
+        .month = CALENDAR_DST_STOP_MONTH, \
+    }, \
+}
+
+#endif /* RTC_DST_CONFIG_H */
+
+/* [] END OF FILE */
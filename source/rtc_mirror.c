@@ -0,0 +1,332 @@
+/******************************************************************************
+* File Name:   rtc_mirror.c
+*
+* Description: RAM mirror of the RTC time and date registers, refreshed
+*              every RTC second by a DataWire descriptor chain and read
+*              lock-free.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "rtc_mirror.h"
+
+#if (RTC_MIRROR_DMA)
+
+#ifndef RTC_MIRROR_TRIGGER
+#error "Define RTC_MIRROR_TRIGGER, the trigger line of the mirror channel"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Descriptors of the chain, in execution order */
+#define DESCR_BEGIN     (0u)
+#define DESCR_LATCH     (1u)
+#define DESCR_SETTLE    (2u)
+#define DESCR_RELEASE   (3u)
+#define DESCR_COPY      (4u)
+#define DESCR_END       (5u)
+#define DESCR_COUNT     (6u)
+
+/* Cache line size of the CM7 */
+#define CACHE_LINE      (32u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Read by the DataWire, so each is kept in its own cache lines */
+static CY_ALIGN(CACHE_LINE) cy_stc_dma_descriptor_t descriptors[DESCR_COUNT];
+static CY_ALIGN(CACHE_LINE) volatile rtc_mirror_t mirror;
+/* Generation of the next copy, written by the CPU and copied by the chain */
+static CY_ALIGN(CACHE_LINE) volatile uint32_t request[CACHE_LINE /
+                                                      sizeof(uint32_t)];
+/* Destination of the settle reads */
+static CY_ALIGN(CACHE_LINE) volatile uint32_t discard[CACHE_LINE /
+                                                      sizeof(uint32_t)];
+static const uint32_t rtc_rw_read = BACKUP_RTC_RW_READ_Msk;
+static const uint32_t rtc_rw_idle = 0u;
+static rtc_mirror_stats_t stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool init_descriptor(uint32_t index, cy_en_dma_descriptor_type_t type,
+                            const volatile void *src, int32_t src_increment,
+                            volatile void *dst, int32_t dst_increment,
+                            uint32_t count);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: rtc_mirror_init
+********************************************************************************
+* Summary:
+*  Builds the descriptor chain and sets up its DataWire channel, disabled;
+*  rtc_mirror_trigger() enables it. Each trigger runs the whole chain once:
+*   1. copies the requested generation to mirror.begin,
+*   2. sets the RTC read bit, the RTC copies its counters to RTC_TIME and
+*      RTC_DATE,
+*   3. reads RTC_RW RTC_MIRROR_SETTLE_READS times while the copy completes,
+*   4. clears the read bit,
+*   5. copies RTC_TIME and RTC_DATE (adjacent registers) to the mirror,
+*   6. copies the generation to mirror.end, disables the channel and raises
+*      the chain complete cause.
+*  This is the handshake of Cy_RTC_SyncFromRtc(), without the CPU.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool : false if the DataWire rejected the configuration
+*
+*******************************************************************************/
+bool rtc_mirror_init(void)
+{
+    bool ok = init_descriptor(DESCR_BEGIN, CY_DMA_SINGLE_TRANSFER,
+                              &request[0], 0, &mirror.begin, 0, 1u) &&
+              init_descriptor(DESCR_LATCH, CY_DMA_SINGLE_TRANSFER,
+                              &rtc_rw_read, 0, &BACKUP_RTC_RW, 0, 1u) &&
+              init_descriptor(DESCR_SETTLE, CY_DMA_1D_TRANSFER,
+                              &BACKUP_RTC_RW, 0, &discard[0], 0,
+                              RTC_MIRROR_SETTLE_READS) &&
+              init_descriptor(DESCR_RELEASE, CY_DMA_SINGLE_TRANSFER,
+                              &rtc_rw_idle, 0, &BACKUP_RTC_RW, 0, 1u) &&
+              init_descriptor(DESCR_COPY, CY_DMA_1D_TRANSFER,
+                              &BACKUP_RTC_TIME, 1, &mirror.rtc_time, 1, 2u) &&
+              init_descriptor(DESCR_END, CY_DMA_SINGLE_TRANSFER,
+                              &request[0], 0, &mirror.end, 0, 1u);
+    if (!ok)
+    {
+        return false;
+    }
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    /* Push the descriptors to memory, and drop any line of the DataWire
+       destinations that startup code left dirty in the cache */
+    SCB_CleanDCache_by_Addr(descriptors, (int32_t)sizeof(descriptors));
+    SCB_CleanInvalidateDCache_by_Addr(&mirror, (int32_t)sizeof(mirror));
+    SCB_CleanInvalidateDCache_by_Addr(discard, (int32_t)sizeof(discard));
+#endif
+
+    const cy_stc_dma_channel_config_t channel =
+    {
+        .descriptor = &descriptors[DESCR_BEGIN],
+        .preemptable = false,
+        .priority = 3u,
+        .enable = false,
+        .bufferable = false,
+    };
+
+    if (CY_DMA_SUCCESS != Cy_DMA_Channel_Init(RTC_MIRROR_DW,
+                                              RTC_MIRROR_CHANNEL, &channel))
+    {
+        return false;
+    }
+    Cy_DMA_Enable(RTC_MIRROR_DW);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: rtc_mirror_trigger
+********************************************************************************
+* Summary:
+*  Starts the chain for the next generation. Called from the RTC second
+*  interrupt, after the PDL handler. The last descriptor disabled the
+*  channel, so it is pointed at the first descriptor and enabled again. While
+*  the RTC is busy with a write transfer (a DST transition), or the previous
+*  chain has not completed, the second is skipped.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_mirror_trigger(void)
+{
+    if ((CY_RTC_BUSY == Cy_RTC_GetSyncStatus()) ||
+        ((0u != stats.triggers) &&
+         (0u == (Cy_DMA_Channel_GetInterruptStatus(RTC_MIRROR_DW,
+                                                   RTC_MIRROR_CHANNEL) &
+                 CY_DMA_INTR_MASK))))
+    {
+        stats.skipped++;
+        return;
+    }
+
+    Cy_DMA_Channel_ClearInterrupt(RTC_MIRROR_DW, RTC_MIRROR_CHANNEL);
+    stats.triggers++;
+    request[0] = stats.triggers;
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr(request, (int32_t)sizeof(request));
+#endif
+    __DSB();
+
+    Cy_DMA_Channel_SetDescriptor(RTC_MIRROR_DW, RTC_MIRROR_CHANNEL,
+                                 &descriptors[DESCR_BEGIN]);
+    Cy_DMA_Channel_Enable(RTC_MIRROR_DW, RTC_MIRROR_CHANNEL);
+    (void)Cy_TrigMux_SwTrigger(RTC_MIRROR_TRIGGER, CY_TRIGGER_TWO_CYCLES);
+}
+
+/*******************************************************************************
+* Function Name: rtc_mirror_read
+********************************************************************************
+* Summary:
+*  Reads the mirror of this core.
+*
+* Parameters:
+*  rtc_mirror_sample_t *sample : Receives the registers and their generation
+*
+* Return:
+*  bool : false if no consistent copy was read
+*
+*******************************************************************************/
+bool rtc_mirror_read(rtc_mirror_sample_t *sample)
+{
+    bool ok = rtc_mirror_load(&mirror, sample);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    stats.reads++;
+    if (!ok)
+    {
+        stats.failures++;
+    }
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: rtc_mirror_get
+********************************************************************************
+* Summary:
+*  Returns the mirror, for readers on other cores (see rtc_mirror_load()).
+*
+* Parameters:
+*  void
+*
+* Return:
+*  const volatile rtc_mirror_t * : The mirror
+*
+*******************************************************************************/
+const volatile rtc_mirror_t *rtc_mirror_get(void)
+{
+    return &mirror;
+}
+
+/*******************************************************************************
+* Function Name: rtc_mirror_get_stats
+********************************************************************************
+* Summary:
+*  Returns the trigger and read statistics.
+*
+* Parameters:
+*  rtc_mirror_stats_t *out : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_mirror_get_stats(rtc_mirror_stats_t *out)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: init_descriptor
+********************************************************************************
+* Summary:
+*  Initializes one word-wide descriptor of the chain, linked to the next one.
+*  The last one ends the chain: it has no next descriptor, and disables the
+*  channel, so that a trigger runs the chain once.
+*
+* Parameters:
+*  uint32_t index                      : DESCR_* index
+*  cy_en_dma_descriptor_type_t type    : Single or 1D transfer
+*  const volatile void *src            : Source address
+*  int32_t src_increment               : Source increment, in words
+*  volatile void *dst                  : Destination address
+*  int32_t dst_increment               : Destination increment, in words
+*  uint32_t count                      : Words, for a 1D transfer
+*
+* Return:
+*  bool : false if the PDL rejected the configuration
+*
+*******************************************************************************/
+static bool init_descriptor(uint32_t index, cy_en_dma_descriptor_type_t type,
+                            const volatile void *src, int32_t src_increment,
+                            volatile void *dst, int32_t dst_increment,
+                            uint32_t count)
+{
+    const bool last = (DESCR_END == index);
+    const cy_stc_dma_descriptor_config_t config =
+    {
+        .retrigger = CY_DMA_RETRIG_IM,
+        .interruptType = CY_DMA_DESCR_CHAIN,
+        .triggerOutType = CY_DMA_DESCR_CHAIN,
+        .channelState = last ? CY_DMA_CHANNEL_DISABLED :
+                               CY_DMA_CHANNEL_ENABLED,
+        .triggerInType = CY_DMA_DESCR_CHAIN,
+        .dataSize = CY_DMA_WORD,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .descriptorType = type,
+        .srcAddress = (void *)(uintptr_t)src,
+        .dstAddress = (void *)(uintptr_t)dst,
+        .srcXincrement = src_increment,
+        .dstXincrement = dst_increment,
+        .xCount = count,
+        .srcYincrement = 0,
+        .dstYincrement = 0,
+        .yCount = 1u,
+        .nextDescriptor = last ? NULL : &descriptors[index + 1u],
+    };
+
+    return (CY_DMA_SUCCESS == Cy_DMA_Descriptor_Init(&descriptors[index],
+                                                     &config));
+}
+
+#endif /* RTC_MIRROR_DMA */
+
+/* [] END OF FILE */
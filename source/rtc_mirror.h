@@ -0,0 +1,172 @@
+/******************************************************************************
+* File Name:   rtc_mirror.h
+*
+* Description: RAM mirror of the RTC time and date registers, refreshed
+*              every RTC second by a DataWire descriptor chain and read
+*              lock-free.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTC_MIRROR_H
+#define RTC_MIRROR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1 to refresh the mirror by DataWire; needs RTC_MIRROR_TRIGGER */
+#ifndef RTC_MIRROR_DMA
+#define RTC_MIRROR_DMA (0)
+#endif
+
+/* DataWire block and channel of the descriptor chain */
+#ifndef RTC_MIRROR_DW
+#define RTC_MIRROR_DW DW0
+#endif
+#ifndef RTC_MIRROR_CHANNEL
+#define RTC_MIRROR_CHANNEL (15u)
+#endif
+
+/* Reads of RTC_RW the chain makes while the read bit is set, the time the
+   RTC takes to update RTC_TIME and RTC_DATE (the delay in
+   Cy_RTC_SyncFromRtc()). Tune for the DataWire clock. */
+#ifndef RTC_MIRROR_SETTLE_READS
+#define RTC_MIRROR_SETTLE_READS (32u)
+#endif
+
+/* Attempts of a reader that finds the mirror being written */
+#ifndef RTC_MIRROR_READ_RETRIES
+#define RTC_MIRROR_READ_RETRIES (4u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Written by the DataWire only. One cache line, so that readers can
+   invalidate it without touching other data. */
+typedef struct
+{
+    uint32_t begin;         /* Generation, written before the registers */
+    uint32_t rtc_time;      /* RTC_TIME register */
+    uint32_t rtc_date;      /* RTC_DATE register */
+    uint32_t end;           /* Generation, written after the registers */
+    uint32_t reserved[4];
+} rtc_mirror_t;
+
+typedef struct
+{
+    uint32_t generation;    /* Copies since start, 0 before the first one */
+    uint32_t rtc_time;
+    uint32_t rtc_date;
+} rtc_mirror_sample_t;
+
+typedef struct
+{
+    uint32_t triggers;      /* Chains started */
+    uint32_t skipped;       /* Seconds skipped on a busy RTC or chain */
+    uint32_t reads;         /* Reads through rtc_mirror_read() */
+    uint32_t failures;      /* Reads that ran out of retries */
+} rtc_mirror_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool rtc_mirror_init(void);
+void rtc_mirror_trigger(void);
+bool rtc_mirror_read(rtc_mirror_sample_t *sample);
+const volatile rtc_mirror_t *rtc_mirror_get(void);
+void rtc_mirror_get_stats(rtc_mirror_stats_t *stats);
+
+/*******************************************************************************
+* Function Name: rtc_mirror_load
+********************************************************************************
+* Summary:
+*  Reads a mirror without locking. The DataWire writes begin, the registers,
+*  then end; they are read in the reverse order, and a copy is consistent
+*  when both generations match. Inline, so that another core can read the
+*  mirror given its address (rtc_mirror_get()).
+*
+* Parameters:
+*  const volatile rtc_mirror_t *mirror : The mirror
+*  rtc_mirror_sample_t *sample         : Receives the registers
+*
+* Return:
+*  bool : false if no consistent copy was read
+*
+*******************************************************************************/
+static inline bool rtc_mirror_load(const volatile rtc_mirror_t *mirror,
+                                   rtc_mirror_sample_t *sample)
+{
+    for (uint32_t attempt = 0u; attempt < RTC_MIRROR_READ_RETRIES; attempt++)
+    {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        /* The DataWire writes the memory, not the data cache */
+        SCB_InvalidateDCache_by_Addr((volatile void *)mirror,
+                                     (int32_t)sizeof(*mirror));
+#endif
+        uint32_t end = mirror->end;
+        __DMB();
+        uint32_t rtc_time = mirror->rtc_time;
+        uint32_t rtc_date = mirror->rtc_date;
+        __DMB();
+        uint32_t begin = mirror->begin;
+
+        if ((begin == end) && (0u != end))
+        {
+            sample->generation = end;
+            sample->rtc_time = rtc_time;
+            sample->rtc_date = rtc_date;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTC_MIRROR_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,235 @@
+/******************************************************************************
+* File Name:   rtc_snapshot.c
+*
+* Description: Batched RTC register snapshot. One read-sync handshake copies
+*              the RTC counters into the backup registers; the time, date,
+*              alarm and interrupt registers are then read together and
+*              decoded, instead of one handshake per PDL getter.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "rtc_snapshot.h"
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* PM flag in the hour field of RTC_TIME in 12-hour mode */
+#define HOUR_PM_FLAG (0x20u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static rtc_snapshot_stats_t stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void decode_alarm(uint32_t alm_time, uint32_t alm_date,
+                         cy_stc_rtc_alarm_t *alarm);
+static cy_en_rtc_alarm_enable_t alarm_enable(uint32_t flag);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: rtc_snapshot_take
+********************************************************************************
+* Summary:
+*  Performs one read-sync handshake and captures the date and time, both
+*  alarm configurations and the interrupt state, then evaluates the DST
+*  status of the captured time. The registers are read with interrupts
+*  disabled, so the snapshot is consistent.
+*
+* Parameters:
+*  rtc_snapshot_t *snapshot     : Receives the snapshot
+*  const cy_stc_rtc_dst_t *dst  : DST rule in effect, NULL if none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_snapshot_take(rtc_snapshot_t *snapshot, const cy_stc_rtc_dst_t *dst)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    uint32_t start = cycle_counter_read();
+    Cy_RTC_SyncFromRtc();
+    uint32_t cycles = cycle_counter_read() - start;
+
+    uint32_t rtc_time = BACKUP_RTC_TIME;
+    uint32_t rtc_date = BACKUP_RTC_DATE;
+    uint32_t alm1_time = BACKUP_ALM1_TIME;
+    uint32_t alm1_date = BACKUP_ALM1_DATE;
+    uint32_t alm2_time = BACKUP_ALM2_TIME;
+    uint32_t alm2_date = BACKUP_ALM2_DATE;
+    snapshot->intr_status = Cy_RTC_GetInterruptStatus();
+    snapshot->intr_mask = Cy_RTC_GetInterruptMask();
+
+    stats.snapshots++;
+    stats.handshake_cycles += cycles;
+    if (cycles > stats.handshake_max)
+    {
+        stats.handshake_max = cycles;
+    }
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+
+    snapshot->rtc_time = rtc_time;
+    snapshot->rtc_date = rtc_date;
+
+    /* Same decoding as Cy_RTC_GetDateAndTime() */
+    cy_stc_rtc_config_t *date_time = &snapshot->date_time;
+    uint32_t hour = _FLD2VAL(BACKUP_RTC_TIME_RTC_HOUR, rtc_time);
+
+    date_time->sec = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_RTC_TIME_RTC_SEC,
+                                                     rtc_time));
+    date_time->min = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_RTC_TIME_RTC_MIN,
+                                                     rtc_time));
+    date_time->hrFormat = _FLD2BOOL(BACKUP_RTC_TIME_CTRL_12HR, rtc_time) ?
+                          CY_RTC_12_HOURS : CY_RTC_24_HOURS;
+    date_time->amPm = CY_RTC_AM;
+    if (CY_RTC_12_HOURS == date_time->hrFormat)
+    {
+        date_time->amPm = (0u != (hour & HOUR_PM_FLAG)) ? CY_RTC_PM :
+                                                          CY_RTC_AM;
+        hour &= ~HOUR_PM_FLAG;
+    }
+    date_time->hour = Cy_RTC_ConvertBcdToDec(hour);
+    date_time->dayOfWeek = _FLD2VAL(BACKUP_RTC_TIME_RTC_DAY, rtc_time);
+    date_time->date = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_RTC_DATE_RTC_DATE,
+                                                      rtc_date));
+    date_time->month = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_RTC_DATE_RTC_MON,
+                                                       rtc_date));
+    date_time->year = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_RTC_DATE_RTC_YEAR,
+                                                      rtc_date));
+
+    decode_alarm(alm1_time, alm1_date, &snapshot->alarm1);
+    decode_alarm(alm2_time, alm2_date, &snapshot->alarm2);
+
+    snapshot->dst_active = (NULL != dst) &&
+                           Cy_RTC_GetDstStatus(dst, &snapshot->date_time);
+}
+
+/*******************************************************************************
+* Function Name: rtc_snapshot_get_stats
+********************************************************************************
+* Summary:
+*  Returns the number of snapshots and the cycles of their handshakes.
+*
+* Parameters:
+*  rtc_snapshot_stats_t *out : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_snapshot_get_stats(rtc_snapshot_stats_t *out)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: decode_alarm
+********************************************************************************
+* Summary:
+*  Decodes the time and date registers of an alarm, as
+*  Cy_RTC_GetAlarmDateAndTime() does. ALARM1 and ALARM2 have the same
+*  register layout, so the ALARM1 field definitions are used for both.
+*
+* Parameters:
+*  uint32_t alm_time         : ALMx_TIME register
+*  uint32_t alm_date         : ALMx_DATE register
+*  cy_stc_rtc_alarm_t *alarm : Receives the alarm configuration
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void decode_alarm(uint32_t alm_time, uint32_t alm_date,
+                         cy_stc_rtc_alarm_t *alarm)
+{
+    alarm->sec = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_ALM1_TIME_ALM_SEC,
+                                                 alm_time));
+    alarm->secEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_TIME_ALM_SEC_EN,
+                                         alm_time));
+    alarm->min = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_ALM1_TIME_ALM_MIN,
+                                                 alm_time));
+    alarm->minEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_TIME_ALM_MIN_EN,
+                                         alm_time));
+    alarm->hour = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_ALM1_TIME_ALM_HOUR,
+                                                  alm_time));
+    alarm->hourEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_TIME_ALM_HOUR_EN,
+                                          alm_time));
+    alarm->dayOfWeek = _FLD2VAL(BACKUP_ALM1_TIME_ALM_DAY, alm_time);
+    alarm->dayOfWeekEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_TIME_ALM_DAY_EN,
+                                               alm_time));
+    alarm->date = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_ALM1_DATE_ALM_DATE,
+                                                  alm_date));
+    alarm->dateEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_DATE_ALM_DATE_EN,
+                                          alm_date));
+    alarm->month = Cy_RTC_ConvertBcdToDec(_FLD2VAL(BACKUP_ALM1_DATE_ALM_MON,
+                                                   alm_date));
+    alarm->monthEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_DATE_ALM_MON_EN,
+                                           alm_date));
+    alarm->almEn = alarm_enable(_FLD2VAL(BACKUP_ALM1_DATE_ALM_EN, alm_date));
+}
+
+/*******************************************************************************
+* Function Name: alarm_enable
+********************************************************************************
+* Summary:
+*  Converts an alarm enable bit to its PDL value.
+*
+* Parameters:
+*  uint32_t flag : Enable bit, 0 or 1
+*
+* Return:
+*  CY_RTC_ALARM_ENABLE or CY_RTC_ALARM_DISABLE
+*
+*******************************************************************************/
+static cy_en_rtc_alarm_enable_t alarm_enable(uint32_t flag)
+{
+    return (0u != flag) ? CY_RTC_ALARM_ENABLE : CY_RTC_ALARM_DISABLE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   rtc_snapshot.h
+*
+* Description: Batched RTC register snapshot: date and time, both alarms,
+*              the interrupt state and the DST status captured under one
+*              read-sync of the backup domain.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTC_SNAPSHOT_H
+#define RTC_SNAPSHOT_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Read-sync handshakes the PDL getters need for the same data: one for
+   Cy_RTC_GetDateAndTime() and one per Cy_RTC_GetAlarmDateAndTime() */
+#define RTC_SNAPSHOT_PDL_HANDSHAKES (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    cy_stc_rtc_config_t date_time;
+    cy_stc_rtc_alarm_t alarm1;
+    cy_stc_rtc_alarm_t alarm2;
+    uint32_t rtc_time;          /* RTC_TIME register, BCD */
+    uint32_t rtc_date;          /* RTC_DATE register, BCD */
+    uint32_t intr_status;       /* Pending RTC interrupts */
+    uint32_t intr_mask;         /* Enabled RTC interrupts */
+    bool dst_active;            /* DST rule in effect, false without a rule */
+} rtc_snapshot_t;
+
+typedef struct
+{
+    uint32_t snapshots;         /* Snapshots taken */
+    uint64_t handshake_cycles;  /* Cycles spent in the read-sync handshakes */
+    uint32_t handshake_max;     /* Longest handshake, in cycles */
+} rtc_snapshot_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rtc_snapshot_take(rtc_snapshot_t *snapshot, const cy_stc_rtc_dst_t *dst);
+void rtc_snapshot_get_stats(rtc_snapshot_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTC_SNAPSHOT_H */
+
+/* [] END OF FILE */
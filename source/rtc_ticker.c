@@ -0,0 +1,275 @@
+/******************************************************************************
+* File Name:   rtc_ticker.c
+*
+* Description: Incremental calendar ticker. The RTC second interrupt advances a
+*              cached copy of the RTC date and time and its struct tm by one
+*              second, propagating the carries; the cache is resynced with the
+*              RTC registers on set-time and DST events and periodically.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "rtc_ticker.h"
+#include "calendar.h"
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TM_YEAR_BASE        (1900u)
+#define SECONDS_PER_MINUTE  (60u)
+#define MINUTES_PER_HOUR    (60u)
+#define HOURS_PER_DAY       (24u)
+#define MONTHS_PER_YEAR     (12u)
+#define DAYS_PER_WEEK       (7u)
+#define YEARS_PER_CENTURY   (100u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* RTC registers and struct tm of the current second, 24-hour mode */
+static cy_stc_rtc_config_t cached_rtc;
+static struct tm cached_tm;
+/* false until the first sync */
+static bool cache_valid;
+/* The RTC value read by the last sync already includes a pending tick */
+static bool skip_next;
+/* Seconds advanced since the last sync */
+static uint32_t since_sync;
+static rtc_ticker_stats_t stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void advance_day(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: rtc_ticker_sync
+********************************************************************************
+* Summary:
+*  Replaces the cached time with a fresh RTC read and its conversion. Call
+*  with interrupts disabled, in the same critical section as the RTC read.
+*  The caller samples the ALARM1 pending status before and after the read and
+*  repeats the read until both agree, so that a pending tick is known to be
+*  in the value read and is skipped once.
+*
+* Parameters:
+*  const cy_stc_rtc_config_t *rtc : RTC date and time just read
+*  const struct tm *time          : The same time as a struct tm
+*  bool tick_pending              : ALARM1 was pending before and after the
+*                                   read
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_ticker_sync(const cy_stc_rtc_config_t *rtc, const struct tm *time,
+                     bool tick_pending)
+{
+    /* A periodic sync checks that no tick was lost */
+    if (cache_valid && (since_sync >= RTC_TICKER_RESYNC_SECONDS) &&
+        ((cached_rtc.sec != rtc->sec) || (cached_rtc.min != rtc->min) ||
+         (cached_rtc.hour != rtc->hour) || (cached_rtc.date != rtc->date) ||
+         (cached_rtc.month != rtc->month) || (cached_rtc.year != rtc->year)))
+    {
+        stats.corrections++;
+    }
+
+    cached_rtc = *rtc;
+    cached_tm = *time;
+    cache_valid = true;
+    since_sync = 0u;
+    stats.syncs++;
+
+    /* The second edge of this tick is already in the RTC value */
+    skip_next = tick_pending;
+}
+
+/*******************************************************************************
+* Function Name: rtc_ticker_advance
+********************************************************************************
+* Summary:
+*  Advances the cached time by one second. Called from the RTC interrupt on
+*  every ALARM1 tick. Only a minute, hour or day carry costs more than an
+*  increment; the day carry looks up the month length once per day.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_ticker_advance(void)
+{
+    uint32_t start = cycle_counter_read();
+
+    if (!cache_valid)
+    {
+        return;
+    }
+
+    if (skip_next)
+    {
+        skip_next = false;
+        return;
+    }
+
+    cached_rtc.sec++;
+    if (cached_rtc.sec >= SECONDS_PER_MINUTE)
+    {
+        cached_rtc.sec = 0u;
+        cached_rtc.min++;
+        if (cached_rtc.min >= MINUTES_PER_HOUR)
+        {
+            cached_rtc.min = 0u;
+            cached_rtc.hour++;
+            if (cached_rtc.hour >= HOURS_PER_DAY)
+            {
+                cached_rtc.hour = 0u;
+                advance_day();
+            }
+            cached_tm.tm_hour = (int)cached_rtc.hour;
+        }
+        cached_tm.tm_min = (int)cached_rtc.min;
+    }
+    cached_tm.tm_sec = (int)cached_rtc.sec;
+    since_sync++;
+
+    uint32_t cycles = cycle_counter_read() - start;
+    stats.advances++;
+    stats.advance_cycles += cycles;
+    if (cycles > stats.advance_max)
+    {
+        stats.advance_max = cycles;
+    }
+}
+
+/*******************************************************************************
+* Function Name: rtc_ticker_read
+********************************************************************************
+* Summary:
+*  Copies the cached time. Call with interrupts disabled, so that the copy
+*  does not straddle a tick.
+*
+* Parameters:
+*  cy_stc_rtc_config_t *rtc : Receives the RTC date and time
+*  struct tm *time          : Receives the time as a struct tm
+*
+* Return:
+*  false if the cache has to be synced with rtc_ticker_sync() first; the
+*  outputs are then not written
+*
+*******************************************************************************/
+bool rtc_ticker_read(cy_stc_rtc_config_t *rtc, struct tm *time)
+{
+    if ((!cache_valid) || (since_sync >= RTC_TICKER_RESYNC_SECONDS))
+    {
+        return false;
+    }
+
+    *rtc = cached_rtc;
+    *time = cached_tm;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: rtc_ticker_get_stats
+********************************************************************************
+* Summary:
+*  Returns the number and cost of the advances and syncs.
+*
+* Parameters:
+*  rtc_ticker_stats_t *out : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_ticker_get_stats(rtc_ticker_stats_t *out)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: advance_day
+********************************************************************************
+* Summary:
+*  Carries midnight into the day of the week, day of the year, date, month
+*  and year of the cached time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void advance_day(void)
+{
+    uint32_t year = (uint32_t)cached_tm.tm_year + TM_YEAR_BASE;
+
+    cached_rtc.dayOfWeek = (cached_rtc.dayOfWeek % DAYS_PER_WEEK) + 1u;
+    cached_tm.tm_wday = (cached_tm.tm_wday + 1) % (int)DAYS_PER_WEEK;
+    cached_tm.tm_yday++;
+
+    cached_rtc.date++;
+    if (cached_rtc.date > calendar_days_in_month(cached_rtc.month, year))
+    {
+        cached_rtc.date = 1u;
+        cached_rtc.month++;
+        if (cached_rtc.month > MONTHS_PER_YEAR)
+        {
+            cached_rtc.month = 1u;
+            cached_rtc.year = (cached_rtc.year + 1u) % YEARS_PER_CENTURY;
+            cached_tm.tm_year++;
+            cached_tm.tm_yday = 0;
+        }
+        cached_tm.tm_mon = (int)cached_rtc.month - 1;
+    }
+    cached_tm.tm_mday = (int)cached_rtc.date;
+}
+
+/* [] END OF FILE */
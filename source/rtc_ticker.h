@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   rtc_ticker.h
+*
+* Description: Incremental calendar ticker: the broken-down local time advanced
+*              by one second on each RTC second tick, so that readers do not read
+*              and convert the RTC registers.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTC_TICKER_H
+#define RTC_TICKER_H
+
+#include <time.h>
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Seconds advanced by the ticker before readers are asked to resync it with
+   the RTC registers */
+#ifndef RTC_TICKER_RESYNC_SECONDS
+#define RTC_TICKER_RESYNC_SECONDS (60u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t advances;          /* Seconds advanced since boot */
+    uint64_t advance_cycles;    /* Total cycles taken by the advances */
+    uint32_t advance_max;       /* Longest advance, in cycles */
+    uint32_t syncs;             /* Syncs with the RTC registers */
+    uint32_t corrections;       /* Periodic syncs that found a difference */
+} rtc_ticker_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rtc_ticker_sync(const cy_stc_rtc_config_t *rtc, const struct tm *time,
+                     bool tick_pending);
+void rtc_ticker_advance(void);
+bool rtc_ticker_read(cy_stc_rtc_config_t *rtc, struct tm *time);
+void rtc_ticker_get_stats(rtc_ticker_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTC_TICKER_H */
+
+/* [] END OF FILE */
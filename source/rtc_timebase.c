@@ -0,0 +1,489 @@
+/******************************************************************************
+* File Name:   rtc_timebase.c
+*
+* Description: Sub-second timestamps interpolated between RTC second ticks.
+*              ALARM1 is programmed to fire every second; each tick records the
+*              core cycle count, and readers scale the cycles elapsed since the
+*              last tick into a fraction of an RTC second. Readers are lock-free
+*              (sequence counter) and cost a few tens of cycles.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "rtc_timebase.h"
+#include "alarm_scheduler.h"
+#include "backup_write.h"
+#include "calendar.h"
+#include "cycle_counter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A measured second is accepted within +/-12.5% of the nominal core clock */
+#define CPS_TOLERANCE_SHIFT (3u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Odd while the tick handler updates the state below */
+static volatile uint32_t generation;
+/* RTC seconds counted since start, never goes back */
+static volatile uint32_t mono_seconds;
+/* Wall-clock seconds since 2000 minus mono_seconds */
+static volatile uint32_t wall_offset;
+/* Cycle count at the last RTC second edge */
+static volatile uint32_t tick_cycles;
+/* Core cycles per RTC second, measured between ticks */
+static volatile uint32_t cycles_per_second;
+/* 2^32 * 1000000 / cycles_per_second */
+static volatile uint32_t us_per_cycle_q32;
+/* false until the first tick, the start anchor is not a second edge */
+static bool edge_seen;
+/* Cycles the CPU spent asleep, when the cycle counter does not advance */
+static volatile uint32_t sleep_cycles;
+/* Estimated RTC second used until the first one is measured, 0 if none */
+static uint32_t seed_cycles;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void set_cycles_per_second(uint32_t cycles);
+static uint32_t read_cycles(void);
+static uint32_t read_rtc_seconds(uint32_t century);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: rtc_timebase_start
+********************************************************************************
+* Summary:
+*  Enables the cycle counter, queues ALARM1 to fire every second (no alarm
+*  field enabled) and takes the wall-clock time from the RTC. The alarm is
+*  programmed by the next backup_write_flush().
+*
+* Parameters:
+*  uint32_t century : Century added to the two-digit RTC year
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_timebase_start(uint32_t century)
+{
+    /* Field values must be valid even though none of them is matched */
+    static const cy_stc_rtc_alarm_t every_second =
+    {
+        .sec = 0u, .secEn = CY_RTC_ALARM_DISABLE,
+        .min = 0u, .minEn = CY_RTC_ALARM_DISABLE,
+        .hour = 0u, .hourEn = CY_RTC_ALARM_DISABLE,
+        .dayOfWeek = CY_RTC_SUNDAY, .dayOfWeekEn = CY_RTC_ALARM_DISABLE,
+        .date = 1u, .dateEn = CY_RTC_ALARM_DISABLE,
+        .month = CY_RTC_JANUARY, .monthEn = CY_RTC_ALARM_DISABLE,
+        .almEn = CY_RTC_ALARM_ENABLE,
+    };
+
+    cycle_counter_init();
+
+    if (0u == cycles_per_second)
+    {
+        set_cycles_per_second((0u != seed_cycles) ? seed_cycles :
+                                                    SystemCoreClock);
+        tick_cycles = read_cycles();
+    }
+
+    rtc_timebase_resync(century);
+
+    /* Committed by the caller's backup_write_flush(), together with any other
+       queued RTC update; the DST alarm stays enabled alongside */
+    backup_write_alarm(&every_second, CY_RTC_ALARM_1);
+    backup_write_interrupt_mask(CY_RTC_INTR_ALARM1);
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_resync
+********************************************************************************
+* Summary:
+*  Re-reads the wall-clock time from the RTC. Call after the time was set or a
+*  DST transition moved the clock. The monotonic time is not affected.
+*
+* Parameters:
+*  uint32_t century : Century added to the two-digit RTC year
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_timebase_resync(uint32_t century)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    uint32_t seconds = read_rtc_seconds(century);
+
+    /* A second edge whose tick has not run yet is already in the RTC value */
+    if (0u != (Cy_RTC_GetInterruptStatus() & CY_RTC_INTR_ALARM1))
+    {
+        seconds--;
+    }
+
+    generation++;
+    wall_offset = seconds - mono_seconds;
+    generation++;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_seconds
+********************************************************************************
+* Summary:
+*  Returns the wall-clock time of the last RTC second tick.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Local RTC time in seconds since 2000-01-01 00:00:00
+*
+*******************************************************************************/
+uint32_t rtc_timebase_seconds(void)
+{
+    uint32_t gen;
+    uint32_t seconds;
+
+    do
+    {
+        gen = generation;
+        __DMB();
+        seconds = mono_seconds + wall_offset;
+        __DMB();
+    } while ((gen != generation) || (0u != (gen & 1u)));
+
+    return seconds;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_monotonic_seconds
+********************************************************************************
+* Summary:
+*  Returns the number of RTC second ticks since rtc_timebase_start(). This is
+*  the time base of the alarm scheduler; it is not moved by setting the time
+*  or by DST transitions.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Monotonic time in seconds
+*
+*******************************************************************************/
+uint32_t rtc_timebase_monotonic_seconds(void)
+{
+    return mono_seconds;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_monotonic_us
+********************************************************************************
+* Summary:
+*  Returns the time since rtc_timebase_start() with microsecond resolution.
+*  The time base is the RTC second; the cycle counter only interpolates
+*  within a second, so the result never goes back and does not drift from
+*  the RTC.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Monotonic time in microseconds
+*
+*******************************************************************************/
+uint64_t rtc_timebase_monotonic_us(void)
+{
+    uint32_t micros;
+    uint32_t seconds = rtc_timebase_monotonic_split(&micros);
+
+    return ((uint64_t)seconds * RTC_TIMEBASE_US_PER_SECOND) + micros;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_monotonic_split
+********************************************************************************
+* Summary:
+*  Same time as rtc_timebase_monotonic_us(), returned as whole seconds and
+*  microseconds within the second, so that callers filling a timeval or
+*  timespec do not need a 64-bit division.
+*
+* Parameters:
+*  uint32_t *micros : Microseconds within the second, 0 to 999999
+*
+* Return:
+*  Monotonic time in whole seconds
+*
+*******************************************************************************/
+uint32_t rtc_timebase_monotonic_split(uint32_t *micros)
+{
+    uint32_t gen;
+    uint32_t seconds;
+    uint32_t delta;
+    uint32_t limit;
+    uint32_t scale;
+
+    do
+    {
+        gen = generation;
+        __DMB();
+        seconds = mono_seconds;
+        limit = cycles_per_second;
+        scale = us_per_cycle_q32;
+        delta = read_cycles() - tick_cycles;
+        __DMB();
+    } while ((gen != generation) || (0u != (gen & 1u)));
+
+    /* A late tick must not let the fraction reach the next second */
+    if (delta >= limit)
+    {
+        delta = limit - 1u;
+    }
+
+    *micros = (uint32_t)(((uint64_t)delta * scale) >> 32u);
+
+    return seconds;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_now_us
+********************************************************************************
+* Summary:
+*  Returns the wall-clock time with microsecond resolution.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Local RTC time in microseconds since 2000-01-01 00:00:00
+*
+*******************************************************************************/
+uint64_t rtc_timebase_now_us(void)
+{
+    uint32_t gen;
+    uint64_t now;
+
+    do
+    {
+        gen = generation;
+        __DMB();
+        now = rtc_timebase_monotonic_us() +
+              ((uint64_t)wall_offset * RTC_TIMEBASE_US_PER_SECOND);
+        __DMB();
+    } while ((gen != generation) || (0u != (gen & 1u)));
+
+    return now;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_cycles_per_second
+********************************************************************************
+* Summary:
+*  Returns the number of core cycles in the last RTC second.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Cycles per RTC second
+*
+*******************************************************************************/
+uint32_t rtc_timebase_cycles_per_second(void)
+{
+    return cycles_per_second;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_seed
+********************************************************************************
+* Summary:
+*  Sets the length of an RTC second used until the first full second has been
+*  measured, instead of the nominal core clock. Call before the first
+*  rtc_timebase_start().
+*
+* Parameters:
+*  uint32_t cycles : Estimated core cycles per RTC second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_timebase_seed(uint32_t cycles)
+{
+    seed_cycles = cycles;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_add_sleep
+********************************************************************************
+* Summary:
+*  Accounts for a period in CPU Sleep, during which the cycle counter stops.
+*  Called by the tickless idle of the RTOS port with interrupts disabled,
+*  before the interrupt that ended the sleep runs.
+*
+* Parameters:
+*  uint32_t cycles : Core clock cycles spent asleep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_timebase_add_sleep(uint32_t cycles)
+{
+    generation++;
+    __DMB();
+    sleep_cycles += cycles;
+    __DMB();
+    generation++;
+}
+
+/*******************************************************************************
+* Function Name: Cy_RTC_Alarm1Interrupt
+********************************************************************************
+* Summary:
+*  Overrides the weak PDL handler. Called by Cy_RTC_Interrupt() on every RTC
+*  second; advances the time base and runs the alarm scheduler.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_RTC_Alarm1Interrupt(void)
+{
+    uint32_t now = read_cycles();
+    uint32_t measured = now - tick_cycles;
+    uint32_t nominal = SystemCoreClock;
+
+    generation++;
+    __DMB();
+
+    /* The RTC runs from the ILO, so the length of its second is measured */
+    if (edge_seen && (measured > (nominal - (nominal >> CPS_TOLERANCE_SHIFT))) &&
+        (measured < (nominal + (nominal >> CPS_TOLERANCE_SHIFT))))
+    {
+        set_cycles_per_second(measured);
+    }
+    edge_seen = true;
+    tick_cycles = now;
+    mono_seconds++;
+
+    __DMB();
+    generation++;
+
+    alarm_scheduler_tick(mono_seconds);
+}
+
+/*******************************************************************************
+* Function Name: set_cycles_per_second
+********************************************************************************
+* Summary:
+*  Stores the length of an RTC second and its reciprocal used by readers.
+*
+* Parameters:
+*  uint32_t cycles : Core cycles per RTC second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void set_cycles_per_second(uint32_t cycles)
+{
+    cycles_per_second = cycles;
+    us_per_cycle_q32 = (uint32_t)(((uint64_t)RTC_TIMEBASE_US_PER_SECOND << 32u) /
+                                  cycles);
+}
+
+/*******************************************************************************
+* Function Name: read_cycles
+********************************************************************************
+* Summary:
+*  Returns the cycle counter plus the cycles spent asleep, so that the time
+*  base keeps counting through CPU Sleep.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Cycle count including sleep
+*
+*******************************************************************************/
+static uint32_t read_cycles(void)
+{
+    return cycle_counter_read() + sleep_cycles;
+}
+
+/*******************************************************************************
+* Function Name: read_rtc_seconds
+********************************************************************************
+* Summary:
+*  Reads the RTC and converts it to seconds since 2000.
+*
+* Parameters:
+*  uint32_t century : Century added to the two-digit RTC year
+*
+* Return:
+*  Local RTC time in seconds since 2000-01-01 00:00:00
+*
+*******************************************************************************/
+static uint32_t read_rtc_seconds(uint32_t century)
+{
+    cy_stc_rtc_config_t rtc_time;
+    calendar_date_time_t date_time;
+
+    Cy_RTC_GetDateAndTime(&rtc_time);
+
+    date_time.year = rtc_time.year + century;
+    date_time.month = rtc_time.month;
+    date_time.mday = rtc_time.date;
+    date_time.hour = rtc_time.hour;
+    date_time.min = rtc_time.min;
+    date_time.sec = rtc_time.sec;
+
+    return calendar_to_seconds(&date_time);
+}
+
+/* [] END OF FILE */
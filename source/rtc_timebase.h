@@ -0,0 +1,75 @@
+/******************************************************************************
+* File Name:   rtc_timebase.h
+*
+* Description: Sub-second timestamps interpolated between RTC second ticks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTC_TIMEBASE_H
+#define RTC_TIMEBASE_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RTC_TIMEBASE_US_PER_SECOND (1000000UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void rtc_timebase_start(uint32_t century);
+void rtc_timebase_resync(uint32_t century);
+uint32_t rtc_timebase_seconds(void);
+uint32_t rtc_timebase_monotonic_seconds(void);
+uint64_t rtc_timebase_now_us(void);
+uint64_t rtc_timebase_monotonic_us(void);
+uint32_t rtc_timebase_monotonic_split(uint32_t *micros);
+uint32_t rtc_timebase_cycles_per_second(void);
+void rtc_timebase_seed(uint32_t cycles);
+void rtc_timebase_add_sleep(uint32_t cycles);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTC_TIMEBASE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,346 @@
+/******************************************************************************
+* File Name:   schedule.c
+*
+* Description: Time-triggered schedule table: tasks dispatched at fixed offsets
+*              within the RTC second by a TCPWM counter, re-aligned on every RTC
+*              second, with per-slot jitter and overrun measurement.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "schedule.h"
+
+#if (SCHEDULE_ENABLE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Microseconds to counter ticks */
+#define US_TO_TICKS(us) \
+    ((uint32_t)(((uint64_t)(us) * SCHEDULE_TIMER_HZ) / 1000000UL))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const schedule_entry_t *table;
+static uint32_t table_size;
+static schedule_task_t task_functions[SCHEDULE_TASK_COUNT];
+/* Next slot to dispatch, table_size once the second's slots are done */
+static uint32_t next_slot;
+static bool aligned = false;
+static schedule_stats_t stats;
+static schedule_slot_stats_t slot_stats[SCHEDULE_TABLE_SIZE];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void counter_isr(void);
+static void arm_next_slot(void);
+static void run_slot(uint32_t slot, uint32_t start);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: schedule_start
+********************************************************************************
+* Summary:
+*  Binds the tasks of the table and starts the free-running counter. The
+*  first slots are dispatched after the first schedule_align(). The counter
+*  interrupt must not preempt the RTC interrupt, nor the other way round, so
+*  both use the same priority.
+*
+* Parameters:
+*  const schedule_task_t tasks[] : Function of each SCHEDULE_TASK_* task
+*  uint32_t priority             : Priority of the RTC interrupt
+*
+* Return:
+*  bool : false if the counter could not be configured
+*
+*******************************************************************************/
+bool schedule_start(const schedule_task_t tasks[SCHEDULE_TASK_COUNT],
+                    uint32_t priority)
+{
+    static const cy_stc_tcpwm_counter_config_t counter_config =
+    {
+        .period = 0xFFFFFFFFUL,
+        .clockPrescaler = CY_TCPWM_PRESCALER_DIVBY_1,
+        .runMode = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0 = 0xFFFFFFFFUL,
+        .interruptSources = CY_TCPWM_INT_ON_CC0,
+        .captureInputMode = CY_TCPWM_INPUT_LEVEL,
+        .captureInput = CY_TCPWM_INPUT_0,
+        .reloadInputMode = CY_TCPWM_INPUT_LEVEL,
+        .reloadInput = CY_TCPWM_INPUT_0,
+        .startInputMode = CY_TCPWM_INPUT_LEVEL,
+        .startInput = CY_TCPWM_INPUT_0,
+        .stopInputMode = CY_TCPWM_INPUT_LEVEL,
+        .stopInput = CY_TCPWM_INPUT_0,
+        .countInputMode = CY_TCPWM_INPUT_LEVEL,
+        .countInput = CY_TCPWM_INPUT_1,
+    };
+    const cy_stc_sysint_t counter_irq =
+    {
+        .intrSrc = ((SCHEDULE_NVIC_MUX << 16) | SCHEDULE_COUNTER_IRQn),
+        .intrPriority = priority,
+    };
+
+    table = schedule_table_get(&table_size);
+
+    for (uint32_t i = 0u; i < SCHEDULE_TASK_COUNT; i++)
+    {
+        task_functions[i] = tasks[i];
+    }
+    next_slot = table_size;
+
+    if (CY_TCPWM_SUCCESS != Cy_TCPWM_Counter_Init(SCHEDULE_TCPWM,
+                                                  SCHEDULE_COUNTER,
+                                                  &counter_config))
+    {
+        return false;
+    }
+
+    (void)Cy_SysInt_Init(&counter_irq, &counter_isr);
+    NVIC_EnableIRQ(Cy_SysInt_GetNvicConnection(SCHEDULE_COUNTER_IRQn));
+
+    Cy_TCPWM_Counter_Enable(SCHEDULE_TCPWM, SCHEDULE_COUNTER);
+    Cy_TCPWM_TriggerStart_Single(SCHEDULE_TCPWM, SCHEDULE_COUNTER);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: schedule_align
+********************************************************************************
+* Summary:
+*  Re-aligns the counter to the RTC second edge and restarts the table.
+*  Called from the RTC second interrupt. Slots of the previous second that
+*  were not reached are counted as missed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void schedule_align(void)
+{
+    uint32_t ticks = Cy_TCPWM_Counter_GetCounter(SCHEDULE_TCPWM,
+                                                 SCHEDULE_COUNTER);
+    Cy_TCPWM_Counter_SetCounter(SCHEDULE_TCPWM, SCHEDULE_COUNTER, 0u);
+
+    if (aligned)
+    {
+        stats.second_ticks = ticks;
+        stats.missed += table_size - next_slot;
+    }
+    aligned = true;
+    stats.seconds++;
+
+    next_slot = 0u;
+    arm_next_slot();
+}
+
+/*******************************************************************************
+* Function Name: schedule_get_stats
+********************************************************************************
+* Summary:
+*  Returns the alignment, missed slot and overrun counts.
+*
+* Parameters:
+*  schedule_stats_t *out : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void schedule_get_stats(schedule_stats_t *out)
+{
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = stats;
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: schedule_get_slot_stats
+********************************************************************************
+* Summary:
+*  Returns the runs, start jitter and overruns of one slot.
+*
+* Parameters:
+*  uint32_t slot                : Slot index in schedule_table_get()
+*  schedule_slot_stats_t *out   : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void schedule_get_slot_stats(uint32_t slot, schedule_slot_stats_t *out)
+{
+    CY_ASSERT(slot < table_size);
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+    *out = slot_stats[slot];
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: counter_isr
+********************************************************************************
+* Summary:
+*  Compare interrupt of the counter: dispatches every slot whose offset was
+*  reached, then arms the compare for the next one.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void counter_isr(void)
+{
+    Cy_TCPWM_ClearInterrupt(SCHEDULE_TCPWM, SCHEDULE_COUNTER,
+                            CY_TCPWM_INT_ON_CC0);
+
+    while (next_slot < table_size)
+    {
+        uint32_t now = Cy_TCPWM_Counter_GetCounter(SCHEDULE_TCPWM,
+                                                   SCHEDULE_COUNTER);
+        if (now < US_TO_TICKS(table[next_slot].offset_us))
+        {
+            break;
+        }
+        run_slot(next_slot, now);
+        next_slot++;
+    }
+
+    arm_next_slot();
+}
+
+/*******************************************************************************
+* Function Name: arm_next_slot
+********************************************************************************
+* Summary:
+*  Sets the compare value to the offset of the next slot. If the counter
+*  passed it while being set, the compare cause is raised by software so that
+*  the slot is not lost until the counter wraps. Pending the CPU interrupt
+*  would not do: it is shared (SCHEDULE_NVIC_MUX), and its dispatcher only
+*  runs the handlers of system interrupts with a live cause.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void arm_next_slot(void)
+{
+    if (next_slot >= table_size)
+    {
+        Cy_TCPWM_Counter_SetCompare0Val(SCHEDULE_TCPWM, SCHEDULE_COUNTER,
+                                        0xFFFFFFFFUL);
+        return;
+    }
+
+    uint32_t compare = US_TO_TICKS(table[next_slot].offset_us);
+    Cy_TCPWM_Counter_SetCompare0Val(SCHEDULE_TCPWM, SCHEDULE_COUNTER, compare);
+    if (Cy_TCPWM_Counter_GetCounter(SCHEDULE_TCPWM,
+                                    SCHEDULE_COUNTER) >= compare)
+    {
+        Cy_TCPWM_SetInterrupt(SCHEDULE_TCPWM, SCHEDULE_COUNTER,
+                              CY_TCPWM_INT_ON_CC0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_slot
+********************************************************************************
+* Summary:
+*  Runs the task of a slot and records its start jitter, its duration and
+*  whether it ended after its budget.
+*
+* Parameters:
+*  uint32_t slot  : Slot index
+*  uint32_t start : Counter value at the start
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_slot(uint32_t slot, uint32_t start)
+{
+    const schedule_entry_t *entry = &table[slot];
+    schedule_slot_stats_t *slot_stat = &slot_stats[slot];
+    uint32_t offset = US_TO_TICKS(entry->offset_us);
+    uint32_t jitter = start - offset;
+
+    if (NULL != task_functions[entry->task])
+    {
+        task_functions[entry->task]();
+    }
+
+    uint32_t end = Cy_TCPWM_Counter_GetCounter(SCHEDULE_TCPWM,
+                                               SCHEDULE_COUNTER);
+    uint32_t duration = end - start;
+
+    slot_stat->runs++;
+    slot_stat->jitter_sum += jitter;
+    if (jitter > slot_stat->jitter_max)
+    {
+        slot_stat->jitter_max = jitter;
+    }
+    if (duration > slot_stat->duration_max)
+    {
+        slot_stat->duration_max = duration;
+    }
+    if ((end - offset) > US_TO_TICKS(entry->budget_us))
+    {
+        slot_stat->overruns++;
+        stats.overruns++;
+    }
+}
+
+#endif /* SCHEDULE_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,147 @@
+/******************************************************************************
+* File Name:   schedule.h
+*
+* Description: Time-triggered schedule table: tasks dispatched at fixed offsets
+*              within the RTC second by a TCPWM counter, re-aligned on every RTC
+*              second, with per-slot jitter and overrun measurement.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1 to run the schedule table; the counter needs a SCHEDULE_TIMER_HZ clock
+   assigned in the Device Configurator */
+#ifndef SCHEDULE_ENABLE
+#define SCHEDULE_ENABLE (0)
+#endif
+
+/* TCPWM counter of the schedule, a 32-bit one (group 2) */
+#ifndef SCHEDULE_TCPWM
+#define SCHEDULE_TCPWM TCPWM0
+#endif
+#ifndef SCHEDULE_COUNTER
+#define SCHEDULE_COUNTER (512u)
+#endif
+#ifndef SCHEDULE_COUNTER_IRQn
+#define SCHEDULE_COUNTER_IRQn tcpwm_0_interrupts_512_IRQn
+#endif
+#ifndef SCHEDULE_NVIC_MUX
+#define SCHEDULE_NVIC_MUX NvicMux4_IRQn
+#endif
+
+/* Counter clock; offsets and budgets are in its ticks */
+#ifndef SCHEDULE_TIMER_HZ
+#define SCHEDULE_TIMER_HZ (1000000UL)
+#endif
+
+/* Microseconds of one RTC second the table may use. The rest absorbs an
+   RTC second that is shorter than the counter's, the ILO is not trimmed. */
+#define SCHEDULE_SECOND_US (1000000UL)
+#define SCHEDULE_GUARD_US (5000UL)
+
+/* Slots of the product table, 100 + 10 + 1; schedule_table.cpp checks it
+   against its rules at compile time. Sizes the per-slot statistics. */
+#define SCHEDULE_TABLE_SIZE (111u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Tasks of the product table, bound to functions by schedule_start() */
+typedef enum
+{
+    SCHEDULE_TASK_10MS,
+    SCHEDULE_TASK_100MS,
+    SCHEDULE_TASK_1S,
+    SCHEDULE_TASK_COUNT
+} schedule_task_id_t;
+
+typedef void (*schedule_task_t)(void);
+
+/* One slot: the task runs offset_us after the RTC second edge and must
+   complete within budget_us */
+typedef struct
+{
+    uint32_t offset_us;
+    uint16_t budget_us;
+    uint8_t task;
+} schedule_entry_t;
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t jitter_max;        /* Latest start after the offset, in ticks */
+    uint64_t jitter_sum;
+    uint32_t duration_max;      /* Longest run, in ticks */
+    uint32_t overruns;          /* Runs that ended after offset + budget */
+} schedule_slot_stats_t;
+
+typedef struct
+{
+    uint32_t seconds;           /* RTC seconds the table was aligned to */
+    uint32_t second_ticks;      /* Counter ticks of the last RTC second */
+    uint32_t missed;            /* Slots not reached before the next second */
+    uint32_t overruns;          /* Slots that overran their budget */
+} schedule_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+const schedule_entry_t *schedule_table_get(uint32_t *count);
+bool schedule_start(const schedule_task_t tasks[SCHEDULE_TASK_COUNT],
+                    uint32_t priority);
+void schedule_align(void);
+void schedule_get_stats(schedule_stats_t *stats);
+void schedule_get_slot_stats(uint32_t slot, schedule_slot_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SCHEDULE_H */
+
+/* [] END OF FILE */
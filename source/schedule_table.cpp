@@ -0,0 +1,166 @@
+/******************************************************************************
+* File Name:   schedule_table.cpp
+*
+* Description: Product schedule table. The task rules are expanded, sorted and
+*              checked for overlapping budgets by the compiler, so the table is
+*              generated at build time and placed in flash.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "schedule.h"
+
+namespace
+{
+
+/*******************************************************************************
+* Compile-time table generation
+*******************************************************************************/
+/* Task run every period_us from first_us within the second */
+struct schedule_rule
+{
+    uint32_t first_us;
+    uint32_t period_us;
+    uint16_t budget_us;
+    uint8_t task;
+};
+
+/* Number of slots produced by a set of rules */
+template <std::size_t R>
+constexpr std::size_t slot_count(const std::array<schedule_rule, R> &rules)
+{
+    std::size_t count = 0u;
+    for (const schedule_rule &rule : rules)
+    {
+        count += ((SCHEDULE_SECOND_US - 1u - rule.first_us) / rule.period_us) +
+                 1u;
+    }
+    return count;
+}
+
+/* Expands the rules into slots sorted by offset */
+template <std::size_t N, std::size_t R>
+constexpr std::array<schedule_entry_t, N>
+make_table(const std::array<schedule_rule, R> &rules)
+{
+    std::array<schedule_entry_t, N> table {};
+    std::size_t count = 0u;
+
+    for (const schedule_rule &rule : rules)
+    {
+        for (uint32_t offset = rule.first_us; offset < SCHEDULE_SECOND_US;
+             offset += rule.period_us)
+        {
+            /* Insertion sort, the dispatcher walks the table in order */
+            schedule_entry_t entry = {offset, rule.budget_us, rule.task};
+            std::size_t pos = count;
+            while ((pos > 0u) && (table[pos - 1u].offset_us > offset))
+            {
+                table[pos] = table[pos - 1u];
+                pos--;
+            }
+            table[pos] = entry;
+            count++;
+        }
+    }
+    return table;
+}
+
+/* true if every slot completes before the next one and before the guard
+   time at the end of the second */
+template <std::size_t N>
+constexpr bool budgets_fit(const std::array<schedule_entry_t, N> &table)
+{
+    for (std::size_t i = 0u; i < N; i++)
+    {
+        uint32_t end = table[i].offset_us + table[i].budget_us;
+        uint32_t limit = ((i + 1u) < N) ? table[i + 1u].offset_us :
+                         (SCHEDULE_SECOND_US - SCHEDULE_GUARD_US);
+        if (end > limit)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Product table
+*******************************************************************************/
+/* 10 ms, 100 ms and 1 s tasks, staggered so that their budgets never
+   overlap */
+constexpr std::array<schedule_rule, 3u> SCHEDULE_RULES =
+{{
+    {0u, 10000u, 1000u, SCHEDULE_TASK_10MS},
+    {2000u, 100000u, 3000u, SCHEDULE_TASK_100MS},
+    {6000u, 1000000u, 3000u, SCHEDULE_TASK_1S},
+}};
+
+static_assert(slot_count(SCHEDULE_RULES) == SCHEDULE_TABLE_SIZE,
+              "SCHEDULE_TABLE_SIZE in schedule.h does not match the rules");
+
+constexpr std::array<schedule_entry_t, SCHEDULE_TABLE_SIZE> schedule_table =
+    make_table<SCHEDULE_TABLE_SIZE>(SCHEDULE_RULES);
+
+static_assert(budgets_fit(schedule_table), "slot budgets overlap");
+
+} /* namespace */
+
+/*******************************************************************************
+* Function Name: schedule_table_get
+********************************************************************************
+* Summary:
+*  Returns the product schedule table, sorted by offset.
+*
+* Parameters:
+*  uint32_t *count : Receives the number of slots
+*
+* Return:
+*  const schedule_entry_t * : First slot
+*
+*******************************************************************************/
+const schedule_entry_t *schedule_table_get(uint32_t *count)
+{
+    *count = static_cast<uint32_t>(SCHEDULE_TABLE_SIZE);
+    return schedule_table.data();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,645 @@
+/******************************************************************************
+* File Name:   solar.c
+*
+* Description: Fixed-point sunrise, sunset and civil twilight (NOAA sunrise
+*              equation) with CORDIC trigonometry, and a scheduler that arms the
+*              next solar event of the day in the alarm scheduler. The times are
+*              computed once per day.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "solar.h"
+#include "alarm_scheduler.h"
+#include "calendar.h"
+#include "cycle_counter.h"
+#include "rtc_timebase.h"
+#include "world_clock.h"
+#if !defined(NDEBUG)
+#include <math.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Angles are binary angles: 2^32 is a full turn */
+#define BAM_QUARTER (0x40000000UL)
+#define BAM_HALF (0x80000000UL)
+
+/* Q30 fixed point, 1.0 = 2^30 */
+#define Q30_ONE (0x40000000L)
+#define CORDIC_STEPS (30u)
+#define CORDIC_GAIN_Q30 (652032874L)    /* 1 / 1.64676 */
+#define TWO_OVER_PI_Q30 (683565276L)    /* Radians to binary angle / 4 */
+
+/* Solar declination (radians) and equation of time, Fourier series in the
+   fractional year (NOAA Global Monitoring Division), coefficients in Q30 */
+#define DECL0 (7428146L)
+#define DECL_C1 (429402240L)
+#define DECL_S1 (75437879L)
+#define DECL_C2 (7256347L)
+#define DECL_S2 (973884L)
+#define DECL_C3 (2895882L)
+#define DECL_S3 (1589138L)
+#define EQ0 (80531L)
+#define EQ_C1 (2005750L)
+#define EQ_S1 (34442416L)
+#define EQ_C2 (15692737L)
+#define EQ_S2 (43861280L)
+#define EQ_SCALE_Q16 (901172429L)       /* 229.18 min * 60 s, Q16 */
+
+/* Cosine of the zenith angle of each event, Q30 */
+#define COS_ZENITH_CIVIL (-112236583L)  /* 96 degrees */
+#define COS_ZENITH_HORIZON (-15610145L) /* 90.833 degrees, with refraction */
+
+#define SECONDS_PER_DAY (86400UL)
+#define SOLAR_NOON_Q16 ((int64_t)43200 << 16)
+#define UDEG_PER_TURN (360000000LL)
+#define SECONDS_PER_DEGREE (240)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* atan(2^-i) as binary angles */
+static const uint32_t cordic_atan[CORDIC_STEPS] =
+{
+    536870912UL, 316933406UL, 167458907UL, 85004756UL, 42667331UL,
+    21354465UL, 10679838UL, 5340245UL, 2670163UL, 1335087UL, 667544UL,
+    333772UL, 166886UL, 83443UL, 41722UL, 20861UL, 10430UL, 5215UL, 2608UL,
+    1304UL, 652UL, 326UL, 163UL, 81UL, 41UL, 20UL, 10UL, 5UL, 3UL, 1UL,
+};
+
+static solar_day_t today = { UINT32_MAX, { 0u } };
+static solar_callback_t solar_callback;
+static int32_t alarm_id = ALARM_SCHEDULER_INVALID;
+static solar_event_t armed_event;
+static uint32_t recompute_cycles;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void compute_utc(uint32_t day, uint32_t *utc);
+static void sin_cos(uint32_t angle, int32_t *sine, int32_t *cosine);
+static uint32_t arc_cos(int32_t value);
+static uint32_t isqrt64(uint64_t value);
+static void arm_next(void);
+static void on_solar_alarm(void *context);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: mul_q30
+********************************************************************************
+* Summary:
+*  Multiplies two Q30 values.
+*
+* Parameters:
+*  int32_t a : Q30 factor
+*  int32_t b : Q30 factor
+*
+* Return:
+*  Q30 product
+*
+*******************************************************************************/
+static inline int32_t mul_q30(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b) >> 30u);
+}
+
+/*******************************************************************************
+* Function Name: solar_compute
+********************************************************************************
+* Summary:
+*  Computes dawn, sunrise, sunset and dusk of a day at the configured
+*  location, in integer arithmetic only, and converts them to RTC local time
+*  with the local zone offset of the world clock.
+*
+* Parameters:
+*  uint32_t day        : Days since 2000-01-01
+*  solar_day_t *result : Event times, SOLAR_NO_EVENT where the sun does not
+*                        cross the altitude (polar day or night)
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void solar_compute(uint32_t day, solar_day_t *result)
+{
+    compute_utc(day, result->time);
+
+    for (uint32_t i = 0; i < SOLAR_EVENTS; i++)
+    {
+        if (SOLAR_NO_EVENT != result->time[i])
+        {
+            result->time[i] += (uint32_t)world_clock_local_utc_offset(
+                                   result->time[i]);
+        }
+    }
+
+    result->day = day;
+}
+
+/*******************************************************************************
+* Function Name: solar_init
+********************************************************************************
+* Summary:
+*  Sets the callback of solar events. The times are computed by the next
+*  solar_update().
+*
+* Parameters:
+*  solar_callback_t callback : Called from the RTC interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void solar_init(solar_callback_t callback)
+{
+    solar_callback = callback;
+    today.day = UINT32_MAX;
+}
+
+/*******************************************************************************
+* Function Name: solar_update
+********************************************************************************
+* Summary:
+*  Recomputes the solar events when the date changed and arms the next one.
+*  Called from the main loop; on other days it costs one compare.
+*
+* Parameters:
+*  uint32_t local_seconds : Current RTC time, seconds since 2000
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void solar_update(uint32_t local_seconds)
+{
+    uint32_t day = local_seconds / SECONDS_PER_DAY;
+    solar_day_t fresh;
+
+    if (day == today.day)
+    {
+        return;
+    }
+
+    uint32_t start = cycle_counter_read();
+    solar_compute(day, &fresh);
+    recompute_cycles = cycle_counter_read() - start;
+
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    today = fresh;
+    arm_next();
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: solar_invalidate
+********************************************************************************
+* Summary:
+*  Drops the cached day, for example after the time or the DST rule was
+*  changed. The next solar_update() recomputes and re-arms the events.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void solar_invalidate(void)
+{
+    today.day = UINT32_MAX;
+}
+
+/*******************************************************************************
+* Function Name: solar_get_day
+********************************************************************************
+* Summary:
+*  Returns the solar events of the current day.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Event times of the day
+*
+*******************************************************************************/
+const solar_day_t *solar_get_day(void)
+{
+    return &today;
+}
+
+/*******************************************************************************
+* Function Name: solar_recompute_cycles
+********************************************************************************
+* Summary:
+*  Returns the cycles taken by the last daily recompute.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Cycles of solar_compute()
+*
+*******************************************************************************/
+uint32_t solar_recompute_cycles(void)
+{
+    return recompute_cycles;
+}
+
+/*******************************************************************************
+* Function Name: compute_utc
+********************************************************************************
+* Summary:
+*  NOAA sunrise equation in fixed point: declination and equation of time
+*  from the fractional year, then the hour angle at which the sun reaches
+*  each zenith angle.
+*
+* Parameters:
+*  uint32_t day  : Days since 2000-01-01
+*  uint32_t *utc : SOLAR_EVENTS event times, UTC seconds since 2000
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void compute_utc(uint32_t day, uint32_t *utc)
+{
+    static const int32_t cos_zenith[2] = { COS_ZENITH_CIVIL, COS_ZENITH_HORIZON };
+    calendar_date_time_t date;
+    int32_t s1, c1, s2, c2, s3, c3;
+    int32_t sin_decl, cos_decl, sin_lat, cos_lat;
+
+    calendar_from_seconds(day * SECONDS_PER_DAY, &date);
+    uint32_t year_days = calendar_is_leap_year(date.year) ? 366u : 365u;
+    uint32_t gamma = (uint32_t)(((uint64_t)calendar_day_of_year(date.mday,
+                                                                date.month,
+                                                                date.year)
+                                 << 32u) / year_days);
+
+    sin_cos(gamma, &s1, &c1);
+    sin_cos(gamma * 2u, &s2, &c2);
+    sin_cos(gamma * 3u, &s3, &c3);
+
+    int32_t decl = DECL0 - mul_q30(DECL_C1, c1) + mul_q30(DECL_S1, s1) -
+                   mul_q30(DECL_C2, c2) + mul_q30(DECL_S2, s2) -
+                   mul_q30(DECL_C3, c3) + mul_q30(DECL_S3, s3);
+    int32_t eq = EQ0 + mul_q30(EQ_C1, c1) - mul_q30(EQ_S1, s1) -
+                 mul_q30(EQ_C2, c2) - mul_q30(EQ_S2, s2);
+
+    sin_cos((uint32_t)(((int64_t)decl * TWO_OVER_PI_Q30) >> 30u),
+            &sin_decl, &cos_decl);
+    sin_cos((uint32_t)(((int64_t)SOLAR_LATITUDE_UDEG << 32u) / UDEG_PER_TURN),
+            &sin_lat, &cos_lat);
+
+    /* Solar noon in UTC seconds of the day, Q16 */
+    int64_t noon = SOLAR_NOON_Q16 -
+                   (((int64_t)SOLAR_LONGITUDE_UDEG * SECONDS_PER_DEGREE * 65536)
+                    / 1000000) -
+                   (((int64_t)eq * EQ_SCALE_Q16) >> 30u);
+    int32_t denominator = mul_q30(cos_lat, cos_decl);
+
+    for (uint32_t i = 0; i < 2u; i++)
+    {
+        solar_event_t rise = (0u == i) ? SOLAR_DAWN : SOLAR_SUNRISE;
+        solar_event_t set = (0u == i) ? SOLAR_DUSK : SOLAR_SUNSET;
+        int64_t cos_ha = 0;
+
+        if (0 < denominator)
+        {
+            cos_ha = ((int64_t)(cos_zenith[i] - mul_q30(sin_lat, sin_decl))
+                      << 30u) / denominator;
+        }
+
+        if ((0 >= denominator) || (cos_ha > Q30_ONE) || (cos_ha < -Q30_ONE))
+        {
+            utc[rise] = SOLAR_NO_EVENT;
+            utc[set] = SOLAR_NO_EVENT;
+            continue;
+        }
+
+        /* Hour angle: a full turn is a day */
+        int64_t half_day = (int64_t)(((uint64_t)arc_cos((int32_t)cos_ha) *
+                                      SECONDS_PER_DAY) >> 16u);
+        int64_t day_start = (int64_t)day * SECONDS_PER_DAY;
+
+        utc[rise] = (uint32_t)(day_start + ((noon - half_day + 0x8000) >> 16u));
+        utc[set] = (uint32_t)(day_start + ((noon + half_day + 0x8000) >> 16u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: sin_cos
+********************************************************************************
+* Summary:
+*  CORDIC rotation. The angle is folded into -90..90 degrees first.
+*
+* Parameters:
+*  uint32_t angle  : Binary angle
+*  int32_t *sine   : Q30 sine
+*  int32_t *cosine : Q30 cosine
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sin_cos(uint32_t angle, int32_t *sine, int32_t *cosine)
+{
+    bool flip = ((angle - BAM_QUARTER) < BAM_HALF);
+    int32_t z = (int32_t)(flip ? (angle - BAM_HALF) : angle);
+    int32_t x = CORDIC_GAIN_Q30;
+    int32_t y = 0;
+
+    for (uint32_t i = 0; i < CORDIC_STEPS; i++)
+    {
+        int32_t dx = x >> i;
+        int32_t dy = y >> i;
+
+        if (z >= 0)
+        {
+            x -= dy;
+            y += dx;
+            z -= (int32_t)cordic_atan[i];
+        }
+        else
+        {
+            x += dy;
+            y -= dx;
+            z += (int32_t)cordic_atan[i];
+        }
+    }
+
+    *cosine = flip ? -x : x;
+    *sine = flip ? -y : y;
+}
+
+/*******************************************************************************
+* Function Name: arc_cos
+********************************************************************************
+* Summary:
+*  CORDIC vectoring of (value, sqrt(1 - value^2)).
+*
+* Parameters:
+*  int32_t value : Q30 cosine, -1..1
+*
+* Return:
+*  Binary angle, 0..180 degrees
+*
+*******************************************************************************/
+static uint32_t arc_cos(int32_t value)
+{
+    int32_t x = value;
+    int32_t y = (int32_t)isqrt64(((uint64_t)1u << 60u) -
+                                 (uint64_t)((int64_t)value * value));
+    uint32_t z = 0u;
+
+    if (x < 0)
+    {
+        /* Rotate by -90 degrees into the right half-plane */
+        x = y;
+        y = -value;
+        z = BAM_QUARTER;
+    }
+
+    for (uint32_t i = 0; i < CORDIC_STEPS; i++)
+    {
+        int32_t dx = x >> i;
+        int32_t dy = y >> i;
+
+        if (y > 0)
+        {
+            x += dy;
+            y -= dx;
+            z += cordic_atan[i];
+        }
+        else
+        {
+            x -= dy;
+            y += dx;
+            z -= cordic_atan[i];
+        }
+    }
+
+    return z;
+}
+
+/*******************************************************************************
+* Function Name: isqrt64
+********************************************************************************
+* Summary:
+*  Integer square root, rounded down.
+*
+* Parameters:
+*  uint64_t value : Radicand
+*
+* Return:
+*  floor(sqrt(value))
+*
+*******************************************************************************/
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0u;
+    uint64_t bit = (uint64_t)1u << 62u;
+
+    while (bit > value)
+    {
+        bit >>= 2u;
+    }
+
+    while (0u != bit)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1u) + bit;
+        }
+        else
+        {
+            root >>= 1u;
+        }
+        bit >>= 2u;
+    }
+
+    return (uint32_t)root;
+}
+
+/*******************************************************************************
+* Function Name: arm_next
+********************************************************************************
+* Summary:
+*  Schedules the alarm for the first event of the day after the current
+*  time. Called with interrupts disabled or from the RTC interrupt.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void arm_next(void)
+{
+    uint32_t now = rtc_timebase_seconds();
+    uint32_t next = SOLAR_NO_EVENT;
+
+    (void)alarm_scheduler_cancel(alarm_id);
+    alarm_id = ALARM_SCHEDULER_INVALID;
+
+    for (uint32_t i = 0; i < SOLAR_EVENTS; i++)
+    {
+        if ((SOLAR_NO_EVENT != today.time[i]) && (today.time[i] > now) &&
+            (today.time[i] < next))
+        {
+            next = today.time[i];
+            armed_event = (solar_event_t)i;
+        }
+    }
+
+    if (SOLAR_NO_EVENT != next)
+    {
+        alarm_id = alarm_scheduler_add(rtc_timebase_monotonic_seconds() +
+                                       (next - now), on_solar_alarm, NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: on_solar_alarm
+********************************************************************************
+* Summary:
+*  Alarm scheduler callback, runs in the RTC interrupt.
+*
+* Parameters:
+*  void *context : Unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void on_solar_alarm(void *context)
+{
+    CY_UNUSED_PARAMETER(context);
+    alarm_id = ALARM_SCHEDULER_INVALID;
+
+    if (NULL != solar_callback)
+    {
+        solar_callback(armed_event);
+    }
+
+    arm_next();
+}
+
+#if !defined(NDEBUG)
+/*******************************************************************************
+* Function Name: solar_max_error
+********************************************************************************
+* Summary:
+*  Compares solar_compute() with the same equations in double precision for
+*  every day of a year. Debug builds only.
+*
+* Parameters:
+*  uint32_t year : Year to check
+*
+* Return:
+*  Largest difference of any event, in seconds
+*
+*******************************************************************************/
+uint32_t solar_max_error(uint32_t year)
+{
+    static const double zenith[2] = { 96.0, 90.833 };
+    const double rad = M_PI / 180.0;
+    double lat = (double)SOLAR_LATITUDE_UDEG / 1e6 * rad;
+    double lon = (double)SOLAR_LONGITUDE_UDEG / 1e6;
+    uint32_t first = calendar_days_from_epoch(1u, 1u, year);
+    uint32_t year_days = calendar_is_leap_year(year) ? 366u : 365u;
+    uint32_t max_error = 0u;
+    uint32_t fixed[SOLAR_EVENTS];
+
+    for (uint32_t n = 0; n < year_days; n++)
+    {
+        double g = 2.0 * M_PI * (double)n / (double)year_days;
+        double decl = 0.006918 - (0.399912 * cos(g)) + (0.070257 * sin(g)) -
+                      (0.006758 * cos(2.0 * g)) + (0.000907 * sin(2.0 * g)) -
+                      (0.002697 * cos(3.0 * g)) + (0.00148 * sin(3.0 * g));
+        double eq = 229.18 * (0.000075 + (0.001868 * cos(g)) -
+                              (0.032077 * sin(g)) - (0.014615 * cos(2.0 * g)) -
+                              (0.040849 * sin(2.0 * g)));
+
+        compute_utc(first + n, fixed);
+
+        for (uint32_t i = 0; i < 2u; i++)
+        {
+            double cos_ha = (cos(zenith[i] * rad) - (sin(lat) * sin(decl))) /
+                            (cos(lat) * cos(decl));
+            solar_event_t rise = (0u == i) ? SOLAR_DAWN : SOLAR_SUNRISE;
+            solar_event_t set = (0u == i) ? SOLAR_DUSK : SOLAR_SUNSET;
+
+            if ((cos_ha > 1.0) || (cos_ha < -1.0) ||
+                (SOLAR_NO_EVENT == fixed[rise]))
+            {
+                continue;
+            }
+
+            double ha = acos(cos_ha) / rad;
+            double noon = 43200.0 - (240.0 * lon) - (60.0 * eq);
+            double utc[2] = { noon - (240.0 * ha), noon + (240.0 * ha) };
+            uint32_t day_start = (first + n) * SECONDS_PER_DAY;
+
+            for (uint32_t j = 0; j < 2u; j++)
+            {
+                uint32_t t = fixed[(0u == j) ? rise : set];
+                double error = fabs((double)(int32_t)(t - day_start) -
+                                    utc[j]);
+
+                if ((uint32_t)(error + 0.5) > max_error)
+                {
+                    max_error = (uint32_t)(error + 0.5);
+                }
+            }
+        }
+    }
+
+    return max_error;
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name:   solar.h
+*
+* Description: Public interface of the fixed-point sunrise/sunset module and the
+*              solar event scheduler.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOLAR_H
+#define SOLAR_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Location in millionths of a degree, north and east positive */
+#ifndef SOLAR_LATITUDE_UDEG
+#define SOLAR_LATITUDE_UDEG (48077000L)
+#define SOLAR_LONGITUDE_UDEG (11659000L)
+#endif
+
+/* Event time when the sun does not cross the altitude on that day */
+#define SOLAR_NO_EVENT (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    SOLAR_DAWN = 0u,        /* Civil twilight begins, sun 6 degrees below */
+    SOLAR_SUNRISE = 1u,
+    SOLAR_SUNSET = 2u,
+    SOLAR_DUSK = 3u,        /* Civil twilight ends */
+    SOLAR_EVENTS = 4u,
+} solar_event_t;
+
+typedef struct
+{
+    uint32_t day;                   /* Days since 2000-01-01 */
+    uint32_t time[SOLAR_EVENTS];    /* Local RTC seconds since 2000 */
+} solar_day_t;
+
+/* Called from the RTC interrupt when a solar event is reached */
+typedef void (*solar_callback_t)(solar_event_t event);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void solar_compute(uint32_t day, solar_day_t *result);
+void solar_init(solar_callback_t callback);
+void solar_update(uint32_t local_seconds);
+void solar_invalidate(void);
+const solar_day_t *solar_get_day(void);
+uint32_t solar_recompute_cycles(void);
+#if !defined(NDEBUG)
+uint32_t solar_max_error(uint32_t year);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SOLAR_H */
+
+/* [] END OF FILE */
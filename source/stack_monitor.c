@@ -0,0 +1,232 @@
+/******************************************************************************
+* File Name:   stack_monitor.c
+*
+* Description: Paint-based stack high-water-mark tracking. The unused part of
+*              the main stack is filled with a pattern; the deepest overwritten
+*              word gives the peak usage. Repainting below the current stack
+*              pointer before a handler yields the peak of that handler alone.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "stack_monitor.h"
+
+#if (STACK_MONITOR_ENABLE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Pattern written to unused stack words */
+#define STACK_PAINT_PATTERN (0xC5C5C5C5UL)
+
+/* Bytes left unpainted below the stack pointer for the painting code itself */
+#define STACK_PAINT_GUARD (64u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Linker symbols delimiting the main stack (see cmsis_compiler.h) */
+extern uint32_t __STACK_LIMIT;
+extern uint32_t __INITIAL_SP;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void paint_below_sp(void);
+static uint32_t *lowest_used_word(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: stack_monitor_init
+********************************************************************************
+* Summary:
+*  Paints the whole unused part of the main stack. Call once, early in main().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stack_monitor_init(void)
+{
+    paint_below_sp();
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_size
+********************************************************************************
+* Summary:
+*  Returns the size of the main stack reserved by the linker script.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Stack size in bytes
+*
+*******************************************************************************/
+uint32_t stack_monitor_size(void)
+{
+    return (uint32_t)((uintptr_t)&__INITIAL_SP - (uintptr_t)&__STACK_LIMIT);
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_peak
+********************************************************************************
+* Summary:
+*  Returns the deepest stack usage observed since the last paint of that
+*  region.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Peak stack usage in bytes, measured from the top of the stack
+*
+*******************************************************************************/
+uint32_t stack_monitor_peak(void)
+{
+    return (uint32_t)((uintptr_t)&__INITIAL_SP - (uintptr_t)lowest_used_word());
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_enter
+********************************************************************************
+* Summary:
+*  Repaints the stack below the caller, so that the following
+*  stack_monitor_exit() reports the usage of the code in between.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stack_monitor_enter(void)
+{
+    paint_below_sp();
+}
+
+/*******************************************************************************
+* Function Name: stack_monitor_exit
+********************************************************************************
+* Summary:
+*  Measures the stack depth reached since stack_monitor_enter() and keeps the
+*  maximum in the handler's peak variable. The stack below the caller is then
+*  repainted, so that the next scan sees only what ran after the handler.
+*
+* Parameters:
+*  uint32_t *peak : Peak stack usage of the handler, in bytes from the top
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stack_monitor_exit(uint32_t *peak)
+{
+    uint32_t used = stack_monitor_peak();
+
+    if (used > *peak)
+    {
+        *peak = used;
+    }
+
+    paint_below_sp();
+}
+
+/*******************************************************************************
+* Function Name: paint_below_sp
+********************************************************************************
+* Summary:
+*  Fills the stack from its limit up to the guard below the current stack
+*  pointer with STACK_PAINT_PATTERN.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void paint_below_sp(void)
+{
+    volatile uint32_t *word = &__STACK_LIMIT;
+    uintptr_t end = (uintptr_t)__get_MSP() - STACK_PAINT_GUARD;
+
+    while ((uintptr_t)word < end)
+    {
+        *word = STACK_PAINT_PATTERN;
+        word++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: lowest_used_word
+********************************************************************************
+* Summary:
+*  Scans up from the stack limit for the first word that no longer holds the
+*  paint pattern.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Address of the deepest stack word written since it was painted
+*
+*******************************************************************************/
+static uint32_t *lowest_used_word(void)
+{
+    uint32_t *word = &__STACK_LIMIT;
+
+    while ((word < &__INITIAL_SP) && (STACK_PAINT_PATTERN == *word))
+    {
+        word++;
+    }
+
+    return word;
+}
+
+#endif /* STACK_MONITOR_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   stack_monitor.h
+*
+* Description: Paint-based stack high-water-mark tracking for the main stack.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The monitor paints and scans the main stack. The RTOS build runs the
+   handlers on the stack of the time service task instead, whose headroom the
+   kernel reports (rtos_port_get_stats()), so the monitor is left out. */
+#if defined(COMPONENT_FREERTOS)
+#define STACK_MONITOR_ENABLE (0)
+#else
+#define STACK_MONITOR_ENABLE (1)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if (STACK_MONITOR_ENABLE)
+void stack_monitor_init(void);
+uint32_t stack_monitor_size(void);
+uint32_t stack_monitor_peak(void);
+void stack_monitor_enter(void);
+void stack_monitor_exit(uint32_t *peak);
+#else
+/* Nothing to measure; the handler peaks stay 0 */
+static inline void stack_monitor_init(void)
+{
+}
+
+static inline void stack_monitor_enter(void)
+{
+}
+
+static inline void stack_monitor_exit(uint32_t *peak)
+{
+    (void)peak;
+}
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* STACK_MONITOR_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,889 @@
+/******************************************************************************
+* File Name:   stopwatch.c
+*
+* Description: Named stopwatches with a lap ring and countdown timers, timed with
+*              the interpolated RTC time base. Countdown expiry is raised by the
+*              alarm scheduler and collected by the main loop.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "cy_pdl.h"
+#include "stopwatch.h"
+#include "alarm_scheduler.h"
+#include "binary_command.h"
+#include "rtc_timebase.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define US_PER_MS (1000u)
+
+/* Binary command actions, first payload byte */
+#define STOPWATCH_ACTION_START (0u)
+#define STOPWATCH_ACTION_STOP (1u)
+#define STOPWATCH_ACTION_RESET (2u)
+#define STOPWATCH_ACTION_LAP (3u)
+#define STOPWATCH_ACTION_READ (4u)
+
+#define COUNTDOWN_ACTION_START (0u)
+#define COUNTDOWN_ACTION_CANCEL (1u)
+#define COUNTDOWN_ACTION_READ (2u)
+
+/* Payload: action, name; countdown: action, duration_ms (LE32), name */
+#define STOPWATCH_NAME_OFFSET (1u)
+#define COUNTDOWN_NAME_OFFSET (5u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    char name[STOPWATCH_NAME_LEN];
+    bool running;
+    uint64_t start_us;          /* Monotonic time of the last start */
+    uint64_t accumulated_us;    /* Elapsed time before the last start */
+    uint64_t last_split_us;     /* Elapsed time at the last lap */
+    uint64_t laps[STOPWATCH_LAPS];
+    uint32_t lap_count;
+    bool transient;             /* Opened by a binary command, closed once idle */
+} stopwatch_t;
+
+typedef struct
+{
+    char name[STOPWATCH_NAME_LEN];
+    bool running;
+    volatile bool expired;      /* Set by the alarm scheduler */
+    volatile int32_t alarm_id;
+    uint64_t deadline_us;       /* Monotonic time of expiry */
+    bool transient;             /* Opened by a binary command, closed once idle */
+} countdown_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static stopwatch_t stopwatches[STOPWATCH_COUNT];
+static countdown_t countdowns[COUNTDOWN_COUNT];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int32_t find_name(const char *name, char *names, uint32_t stride,
+                         uint32_t count, bool *created);
+static void on_countdown_alarm(void *context);
+static void put_u64(uint8_t *data, uint64_t value);
+static void get_name(char *name, const uint8_t *payload, uint32_t length);
+static binary_command_status_t stopwatch_command(const uint8_t *payload,
+                                                 uint32_t length,
+                                                 uint8_t *response,
+                                                 uint32_t *response_length);
+static binary_command_status_t countdown_command(const uint8_t *payload,
+                                                 uint32_t length,
+                                                 uint8_t *response,
+                                                 uint32_t *response_length);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: stopwatch_open
+********************************************************************************
+* Summary:
+*  Returns the stopwatch with the given name, creating it if needed. It stays
+*  open until stopwatch_close(), also if a binary command opened it first.
+*
+* Parameters:
+*  const char *name : Name, truncated to STOPWATCH_NAME_LEN - 1 characters
+*
+* Return:
+*  Stopwatch id, or STOPWATCH_INVALID if all stopwatches are in use
+*
+*******************************************************************************/
+int32_t stopwatch_open(const char *name)
+{
+    int32_t id = find_name(name, stopwatches[0].name, sizeof(stopwatch_t),
+                           STOPWATCH_COUNT, NULL);
+
+    if (STOPWATCH_INVALID != id)
+    {
+        stopwatches[id].transient = false;
+    }
+
+    return id;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_close
+********************************************************************************
+* Summary:
+*  Stops a stopwatch and frees its slot for another name.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stopwatch_close(int32_t id)
+{
+    memset(&stopwatches[id], 0, sizeof(stopwatch_t));
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_name
+********************************************************************************
+* Summary:
+*  Returns the name of a stopwatch.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  Name of the stopwatch
+*
+*******************************************************************************/
+const char *stopwatch_name(int32_t id)
+{
+    return stopwatches[id].name;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_start
+********************************************************************************
+* Summary:
+*  Starts or resumes a stopwatch.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stopwatch_start(int32_t id)
+{
+    stopwatch_t *watch = &stopwatches[id];
+
+    if (!watch->running)
+    {
+        watch->start_us = rtc_timebase_monotonic_us();
+        watch->running = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_stop
+********************************************************************************
+* Summary:
+*  Stops a stopwatch, keeping its elapsed time.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stopwatch_stop(int32_t id)
+{
+    stopwatch_t *watch = &stopwatches[id];
+
+    if (watch->running)
+    {
+        watch->accumulated_us += rtc_timebase_monotonic_us() - watch->start_us;
+        watch->running = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_reset
+********************************************************************************
+* Summary:
+*  Clears the elapsed time and the laps. A running stopwatch keeps running.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stopwatch_reset(int32_t id)
+{
+    stopwatch_t *watch = &stopwatches[id];
+
+    watch->start_us = rtc_timebase_monotonic_us();
+    watch->accumulated_us = 0u;
+    watch->last_split_us = 0u;
+    watch->lap_count = 0u;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_running
+********************************************************************************
+* Summary:
+*  Returns whether a stopwatch is running.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  true if running
+*
+*******************************************************************************/
+bool stopwatch_running(int32_t id)
+{
+    return stopwatches[id].running;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_elapsed_us
+********************************************************************************
+* Summary:
+*  Returns the elapsed time of a stopwatch. Costs one time base read.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  Elapsed time in microseconds
+*
+*******************************************************************************/
+uint64_t stopwatch_elapsed_us(int32_t id)
+{
+    const stopwatch_t *watch = &stopwatches[id];
+    uint64_t elapsed = watch->accumulated_us;
+
+    if (watch->running)
+    {
+        elapsed += rtc_timebase_monotonic_us() - watch->start_us;
+    }
+
+    return elapsed;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_lap
+********************************************************************************
+* Summary:
+*  Records the time since the previous lap. Once the ring is full the oldest
+*  lap is overwritten.
+*
+* Parameters:
+*  int32_t id : Stopwatch id
+*
+* Return:
+*  true if recorded, false if the stopwatch is not running
+*
+*******************************************************************************/
+bool stopwatch_lap(int32_t id)
+{
+    stopwatch_t *watch = &stopwatches[id];
+    uint64_t split;
+
+    if (!watch->running)
+    {
+        return false;
+    }
+
+    split = stopwatch_elapsed_us(id);
+    watch->laps[watch->lap_count % STOPWATCH_LAPS] = split - watch->last_split_us;
+    watch->last_split_us = split;
+    watch->lap_count++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_get_laps
+********************************************************************************
+* Summary:
+*  Copies the recorded laps, oldest first.
+*
+* Parameters:
+*  int32_t id        : Stopwatch id
+*  uint64_t *laps    : Lap times in microseconds
+*  uint32_t max_laps : Capacity of laps
+*
+* Return:
+*  Number of laps copied
+*
+*******************************************************************************/
+uint32_t stopwatch_get_laps(int32_t id, uint64_t *laps, uint32_t max_laps)
+{
+    const stopwatch_t *watch = &stopwatches[id];
+    uint32_t count = watch->lap_count;
+    uint32_t first = 0u;
+
+    if (count > STOPWATCH_LAPS)
+    {
+        first = count - STOPWATCH_LAPS;
+    }
+    if ((count - first) > max_laps)
+    {
+        first = count - max_laps;
+    }
+
+    for (uint32_t i = first; i < count; i++)
+    {
+        laps[i - first] = watch->laps[i % STOPWATCH_LAPS];
+    }
+
+    return count - first;
+}
+
+/*******************************************************************************
+* Function Name: countdown_open
+********************************************************************************
+* Summary:
+*  Returns the countdown with the given name, creating it if needed. It stays
+*  open until countdown_close(), also if a binary command opened it first.
+*
+* Parameters:
+*  const char *name : Name, truncated to STOPWATCH_NAME_LEN - 1 characters
+*
+* Return:
+*  Countdown id, or STOPWATCH_INVALID if all countdowns are in use
+*
+*******************************************************************************/
+int32_t countdown_open(const char *name)
+{
+    int32_t id = find_name(name, countdowns[0].name, sizeof(countdown_t),
+                           COUNTDOWN_COUNT, NULL);
+
+    if (STOPWATCH_INVALID != id)
+    {
+        if (!countdowns[id].running)
+        {
+            countdowns[id].alarm_id = ALARM_SCHEDULER_INVALID;
+        }
+        countdowns[id].transient = false;
+    }
+
+    return id;
+}
+
+/*******************************************************************************
+* Function Name: countdown_close
+********************************************************************************
+* Summary:
+*  Cancels a countdown and frees its slot for another name.
+*
+* Parameters:
+*  int32_t id : Countdown id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void countdown_close(int32_t id)
+{
+    countdown_cancel(id);
+    memset(&countdowns[id], 0, sizeof(countdown_t));
+    countdowns[id].alarm_id = ALARM_SCHEDULER_INVALID;
+}
+
+/*******************************************************************************
+* Function Name: countdown_name
+********************************************************************************
+* Summary:
+*  Returns the name of a countdown.
+*
+* Parameters:
+*  int32_t id : Countdown id
+*
+* Return:
+*  Name of the countdown
+*
+*******************************************************************************/
+const char *countdown_name(int32_t id)
+{
+    return countdowns[id].name;
+}
+
+/*******************************************************************************
+* Function Name: countdown_start
+********************************************************************************
+* Summary:
+*  Starts a countdown, restarting it if it is already running. The alarm
+*  scheduler flags it at the first RTC second after the deadline, which is
+*  the only way a countdown expires.
+*
+* Parameters:
+*  int32_t id           : Countdown id
+*  uint32_t duration_ms : Duration in milliseconds
+*
+* Return:
+*  true on success, false if no alarm slot is free
+*
+*******************************************************************************/
+bool countdown_start(int32_t id, uint32_t duration_ms)
+{
+    countdown_t *timer = &countdowns[id];
+    uint64_t deadline;
+    uint32_t due_seconds;
+
+    countdown_cancel(id);
+
+    deadline = rtc_timebase_monotonic_us() + ((uint64_t)duration_ms * US_PER_MS);
+    due_seconds = (uint32_t)((deadline + (RTC_TIMEBASE_US_PER_SECOND - 1u)) /
+                             RTC_TIMEBASE_US_PER_SECOND);
+
+    timer->deadline_us = deadline;
+    timer->expired = false;
+    timer->alarm_id = alarm_scheduler_add(due_seconds, on_countdown_alarm, timer);
+    timer->running = (ALARM_SCHEDULER_INVALID != timer->alarm_id);
+
+    return timer->running;
+}
+
+/*******************************************************************************
+* Function Name: countdown_cancel
+********************************************************************************
+* Summary:
+*  Stops a countdown without reporting it as expired.
+*
+* Parameters:
+*  int32_t id : Countdown id
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void countdown_cancel(int32_t id)
+{
+    countdown_t *timer = &countdowns[id];
+    uint32_t savedIntrStatus = Cy_SysLib_EnterCriticalSection();
+
+    (void)alarm_scheduler_cancel(timer->alarm_id);
+    timer->alarm_id = ALARM_SCHEDULER_INVALID;
+    timer->running = false;
+    timer->expired = false;
+
+    Cy_SysLib_ExitCriticalSection(savedIntrStatus);
+}
+
+/*******************************************************************************
+* Function Name: countdown_remaining_us
+********************************************************************************
+* Summary:
+*  Returns the time left on a countdown.
+*
+* Parameters:
+*  int32_t id : Countdown id
+*
+* Return:
+*  Remaining time in microseconds, 0 if expired or not running
+*
+*******************************************************************************/
+uint64_t countdown_remaining_us(int32_t id)
+{
+    const countdown_t *timer = &countdowns[id];
+    uint64_t now;
+
+    if (!timer->running)
+    {
+        return 0u;
+    }
+
+    now = rtc_timebase_monotonic_us();
+
+    return (now < timer->deadline_us) ? (timer->deadline_us - now) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: countdown_take_expired
+********************************************************************************
+* Summary:
+*  Returns a countdown flagged by the alarm scheduler and stops it, so each
+*  expiry is reported once. A countdown opened by a binary command is closed,
+*  so its name is returned as a copy. Called from the main loop.
+*
+* Parameters:
+*  char *name : Receives the name, STOPWATCH_NAME_LEN bytes
+*
+* Return:
+*  Countdown id, or STOPWATCH_INVALID if none has expired
+*
+*******************************************************************************/
+int32_t countdown_take_expired(char *name)
+{
+    for (uint32_t i = 0; i < COUNTDOWN_COUNT; i++)
+    {
+        if (countdowns[i].running && countdowns[i].expired)
+        {
+            memcpy(name, countdowns[i].name, STOPWATCH_NAME_LEN);
+            if (countdowns[i].transient)
+            {
+                countdown_close((int32_t)i);
+            }
+            else
+            {
+                countdown_cancel((int32_t)i);
+            }
+            return (int32_t)i;
+        }
+    }
+
+    return STOPWATCH_INVALID;
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_register_commands
+********************************************************************************
+* Summary:
+*  Registers the stopwatch and countdown binary commands.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stopwatch_register_commands(void)
+{
+    (void)binary_command_register(BINARY_COMMAND_STOPWATCH, stopwatch_command);
+    (void)binary_command_register(BINARY_COMMAND_COUNTDOWN, countdown_command);
+}
+
+/*******************************************************************************
+* Function Name: find_name
+********************************************************************************
+* Summary:
+*  Finds a named slot in a table, or claims the first unnamed one.
+*
+* Parameters:
+*  const char *name : Name to find
+*  char *names      : Name of the first table entry
+*  uint32_t stride  : Size of a table entry
+*  uint32_t count   : Number of table entries
+*  bool *created    : Set if the entry was claimed, may be NULL
+*
+* Return:
+*  Index of the entry, or STOPWATCH_INVALID if the table is full
+*
+*******************************************************************************/
+static int32_t find_name(const char *name, char *names, uint32_t stride,
+                         uint32_t count, bool *created)
+{
+    int32_t free_slot = STOPWATCH_INVALID;
+
+    if (NULL != created)
+    {
+        *created = false;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        char *entry = names + (i * stride);
+
+        if ('\0' == entry[0])
+        {
+            if (STOPWATCH_INVALID == free_slot)
+            {
+                free_slot = (int32_t)i;
+            }
+        }
+        else if (0 == strncmp(entry, name, STOPWATCH_NAME_LEN - 1u))
+        {
+            return (int32_t)i;
+        }
+    }
+
+    if ((STOPWATCH_INVALID != free_slot) && ('\0' != name[0]))
+    {
+        char *entry = names + ((uint32_t)free_slot * stride);
+
+        strncpy(entry, name, STOPWATCH_NAME_LEN - 1u);
+        entry[STOPWATCH_NAME_LEN - 1u] = '\0';
+        if (NULL != created)
+        {
+            *created = true;
+        }
+        return free_slot;
+    }
+
+    return STOPWATCH_INVALID;
+}
+
+/*******************************************************************************
+* Function Name: on_countdown_alarm
+********************************************************************************
+* Summary:
+*  Alarm scheduler callback, runs in the RTC interrupt.
+*
+* Parameters:
+*  void *context : The countdown
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void on_countdown_alarm(void *context)
+{
+    countdown_t *timer = (countdown_t *)context;
+
+    timer->alarm_id = ALARM_SCHEDULER_INVALID;
+    timer->expired = true;
+}
+
+/*******************************************************************************
+* Function Name: put_u64
+********************************************************************************
+* Summary:
+*  Stores a value little-endian.
+*
+* Parameters:
+*  uint8_t *data  : Destination, 8 bytes
+*  uint64_t value : Value to store
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void put_u64(uint8_t *data, uint64_t value)
+{
+    for (uint32_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = (uint8_t)(value >> (8u * i));
+    }
+}
+
+/*******************************************************************************
+* Function Name: get_name
+********************************************************************************
+* Summary:
+*  Copies an unterminated name from a payload.
+*
+* Parameters:
+*  char *name             : Destination, STOPWATCH_NAME_LEN bytes
+*  const uint8_t *payload : Name bytes
+*  uint32_t length        : Number of name bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void get_name(char *name, const uint8_t *payload, uint32_t length)
+{
+    if (length > (STOPWATCH_NAME_LEN - 1u))
+    {
+        length = STOPWATCH_NAME_LEN - 1u;
+    }
+
+    memcpy(name, payload, length);
+    name[length] = '\0';
+}
+
+/*******************************************************************************
+* Function Name: stopwatch_command
+********************************************************************************
+* Summary:
+*  Binary command handler. Payload: action, name. Response: id, elapsed time
+*  in microseconds (LE64), number of laps recorded. A stopwatch the command
+*  opened is closed once it is stopped at zero, e.g. after a reset.
+*
+* Parameters:
+*  const uint8_t *payload    : Request payload
+*  uint32_t length           : Payload length
+*  uint8_t *response         : Response data
+*  uint32_t *response_length : Number of response bytes
+*
+* Return:
+*  Command status
+*
+*******************************************************************************/
+static binary_command_status_t stopwatch_command(const uint8_t *payload,
+                                                 uint32_t length,
+                                                 uint8_t *response,
+                                                 uint32_t *response_length)
+{
+    char name[STOPWATCH_NAME_LEN];
+    binary_command_status_t status = BINARY_COMMAND_OK;
+    bool created;
+    int32_t id;
+
+    if (length <= STOPWATCH_NAME_OFFSET)
+    {
+        return BINARY_COMMAND_BAD_LENGTH;
+    }
+
+    get_name(name, &payload[STOPWATCH_NAME_OFFSET],
+             length - STOPWATCH_NAME_OFFSET);
+    id = find_name(name, stopwatches[0].name, sizeof(stopwatch_t),
+                   STOPWATCH_COUNT, &created);
+    if (STOPWATCH_INVALID == id)
+    {
+        return BINARY_COMMAND_FAILED;
+    }
+    if (created)
+    {
+        stopwatches[id].transient = true;
+    }
+
+    switch (payload[0])
+    {
+        case STOPWATCH_ACTION_START:
+            stopwatch_start(id);
+            break;
+        case STOPWATCH_ACTION_STOP:
+            stopwatch_stop(id);
+            break;
+        case STOPWATCH_ACTION_RESET:
+            stopwatch_reset(id);
+            break;
+        case STOPWATCH_ACTION_LAP:
+            if (!stopwatch_lap(id))
+            {
+                status = BINARY_COMMAND_FAILED;
+            }
+            break;
+        case STOPWATCH_ACTION_READ:
+            break;
+        default:
+            status = BINARY_COMMAND_FAILED;
+            break;
+    }
+
+    if (BINARY_COMMAND_OK == status)
+    {
+        response[0] = (uint8_t)id;
+        put_u64(&response[1], stopwatch_elapsed_us(id));
+        response[9] = (uint8_t)stopwatches[id].lap_count;
+        *response_length = 10u;
+    }
+
+    /* Nothing left to read: the slot is free for another name */
+    if (stopwatches[id].transient && !stopwatches[id].running &&
+        (0u == stopwatch_elapsed_us(id)))
+    {
+        stopwatch_close(id);
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: countdown_command
+********************************************************************************
+* Summary:
+*  Binary command handler. Payload: action, duration in milliseconds (LE32,
+*  used by start only), name. Response: id, remaining time in microseconds
+*  (LE64). A countdown the command opened is closed once it is not running;
+*  one that expires is closed when the main loop reports it.
+*
+* Parameters:
+*  const uint8_t *payload    : Request payload
+*  uint32_t length           : Payload length
+*  uint8_t *response         : Response data
+*  uint32_t *response_length : Number of response bytes
+*
+* Return:
+*  Command status
+*
+*******************************************************************************/
+static binary_command_status_t countdown_command(const uint8_t *payload,
+                                                 uint32_t length,
+                                                 uint8_t *response,
+                                                 uint32_t *response_length)
+{
+    char name[STOPWATCH_NAME_LEN];
+    binary_command_status_t status = BINARY_COMMAND_OK;
+    uint32_t duration_ms;
+    bool created;
+    int32_t id;
+
+    if (length <= COUNTDOWN_NAME_OFFSET)
+    {
+        return BINARY_COMMAND_BAD_LENGTH;
+    }
+
+    get_name(name, &payload[COUNTDOWN_NAME_OFFSET],
+             length - COUNTDOWN_NAME_OFFSET);
+    id = find_name(name, countdowns[0].name, sizeof(countdown_t),
+                   COUNTDOWN_COUNT, &created);
+    if (STOPWATCH_INVALID == id)
+    {
+        return BINARY_COMMAND_FAILED;
+    }
+    if (created)
+    {
+        countdowns[id].alarm_id = ALARM_SCHEDULER_INVALID;
+        countdowns[id].transient = true;
+    }
+
+    duration_ms = (uint32_t)payload[1] | ((uint32_t)payload[2] << 8u) |
+                  ((uint32_t)payload[3] << 16u) | ((uint32_t)payload[4] << 24u);
+
+    switch (payload[0])
+    {
+        case COUNTDOWN_ACTION_START:
+            if (!countdown_start(id, duration_ms))
+            {
+                status = BINARY_COMMAND_FAILED;
+            }
+            break;
+        case COUNTDOWN_ACTION_CANCEL:
+            countdown_cancel(id);
+            break;
+        case COUNTDOWN_ACTION_READ:
+            break;
+        default:
+            status = BINARY_COMMAND_FAILED;
+            break;
+    }
+
+    if (BINARY_COMMAND_OK == status)
+    {
+        response[0] = (uint8_t)id;
+        put_u64(&response[1], countdown_remaining_us(id));
+        *response_length = 9u;
+    }
+
+    if (countdowns[id].transient && !countdowns[id].running)
+    {
+        countdown_close(id);
+    }
+
+    return status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   stopwatch.h
+*
+* Description: Public interface of the named stopwatches and countdown timers.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STOPWATCH_H
+#define STOPWATCH_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define STOPWATCH_COUNT (4u)
+#define STOPWATCH_LAPS (8u)     /* Ring of the most recent lap times */
+#define COUNTDOWN_COUNT (4u)
+/* Longest countdown in whole seconds, countdown_start() takes 32-bit ms */
+#define COUNTDOWN_MAX_SECONDS (UINT32_MAX / 1000u)
+#define STOPWATCH_NAME_LEN (12u) /* Including the terminator */
+/* Returned when no slot is free or nothing has expired */
+#define STOPWATCH_INVALID (-1)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int32_t stopwatch_open(const char *name);
+void stopwatch_close(int32_t id);
+const char *stopwatch_name(int32_t id);
+void stopwatch_start(int32_t id);
+void stopwatch_stop(int32_t id);
+void stopwatch_reset(int32_t id);
+bool stopwatch_running(int32_t id);
+uint64_t stopwatch_elapsed_us(int32_t id);
+bool stopwatch_lap(int32_t id);
+uint32_t stopwatch_get_laps(int32_t id, uint64_t *laps, uint32_t max_laps);
+
+int32_t countdown_open(const char *name);
+void countdown_close(int32_t id);
+const char *countdown_name(int32_t id);
+bool countdown_start(int32_t id, uint32_t duration_ms);
+void countdown_cancel(int32_t id);
+uint64_t countdown_remaining_us(int32_t id);
+int32_t countdown_take_expired(char *name);
+
+void stopwatch_register_commands(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* STOPWATCH_H */
+
+/* [] END OF FILE */
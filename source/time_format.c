@@ -0,0 +1,291 @@
+/******************************************************************************
+* File Name:   time_format.c
+*
+* Description: Fast fixed-layout date and time formatter. Digits come from a
+*              200-byte pair table, so a field costs two loads and two stores.
+*              A BCD variant writes the text straight from the RTC registers,
+*              and a render cache keeps the date fields for the whole day.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "time_format.h"
+#include "string.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Packs a date into a non-zero key of the render cache */
+#define CACHE_DAY(year, month, mday) (((year) << 9u) | ((month) << 5u) | (mday))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+const char time_format_digits[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Three-letter names, indexed by CY_RTC_SUNDAY - 1 and CY_RTC_JANUARY - 1 */
+static const char weekday_names[7][3] =
+{
+    {'S', 'u', 'n'}, {'M', 'o', 'n'}, {'T', 'u', 'e'}, {'W', 'e', 'd'},
+    {'T', 'h', 'u'}, {'F', 'r', 'i'}, {'S', 'a', 't'},
+};
+
+static const char month_names[12][3] =
+{
+    {'J', 'a', 'n'}, {'F', 'e', 'b'}, {'M', 'a', 'r'}, {'A', 'p', 'r'},
+    {'M', 'a', 'y'}, {'J', 'u', 'n'}, {'J', 'u', 'l'}, {'A', 'u', 'g'},
+    {'S', 'e', 'p'}, {'O', 'c', 't'}, {'N', 'o', 'v'}, {'D', 'e', 'c'},
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: time_format_c_date
+********************************************************************************
+* Summary:
+*  Writes the date fields of the "%c" layout (weekday, month, day, year) and
+*  the separating spaces. The time field is left untouched.
+*
+* Parameters:
+*  char *dst                             : TIME_FORMAT_C_LEN byte line
+*  const calendar_date_time_t *date_time : Date to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void time_format_c_date(char *dst, const calendar_date_time_t *date_time)
+{
+    memcpy(&dst[TIME_FORMAT_C_WDAY_OFFSET],
+           weekday_names[date_time->wday - 1u], 3u);
+    dst[TIME_FORMAT_C_WDAY_OFFSET + 3u] = ' ';
+    memcpy(&dst[TIME_FORMAT_C_MONTH_OFFSET],
+           month_names[date_time->month - 1u], 3u);
+    dst[TIME_FORMAT_C_MONTH_OFFSET + 3u] = ' ';
+
+    /* %e pads the day with a space */
+    time_format_2d(&dst[TIME_FORMAT_C_MDAY_OFFSET], date_time->mday);
+    if ('0' == dst[TIME_FORMAT_C_MDAY_OFFSET])
+    {
+        dst[TIME_FORMAT_C_MDAY_OFFSET] = ' ';
+    }
+    dst[TIME_FORMAT_C_MDAY_OFFSET + 2u] = ' ';
+    dst[TIME_FORMAT_C_YEAR_OFFSET - 1u] = ' ';
+
+    time_format_2d(&dst[TIME_FORMAT_C_YEAR_OFFSET], date_time->year / 100u);
+    time_format_2d(&dst[TIME_FORMAT_C_YEAR_OFFSET + 2u],
+                   date_time->year % 100u);
+}
+
+/*******************************************************************************
+* Function Name: time_format_c_time
+********************************************************************************
+* Summary:
+*  Writes the "HH:MM:SS" field of the "%c" layout.
+*
+* Parameters:
+*  char *dst     : TIME_FORMAT_C_LEN byte line
+*  uint32_t hour : Hour, 0..23
+*  uint32_t min  : Minute, 0..59
+*  uint32_t sec  : Second, 0..59
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void time_format_c_time(char *dst, uint32_t hour, uint32_t min, uint32_t sec)
+{
+    time_format_2d(&dst[TIME_FORMAT_C_HOUR_OFFSET], hour);
+    dst[TIME_FORMAT_C_MIN_OFFSET - 1u] = ':';
+    time_format_2d(&dst[TIME_FORMAT_C_MIN_OFFSET], min);
+    dst[TIME_FORMAT_C_SEC_OFFSET - 1u] = ':';
+    time_format_2d(&dst[TIME_FORMAT_C_SEC_OFFSET], sec);
+}
+
+/*******************************************************************************
+* Function Name: time_format_c
+********************************************************************************
+* Summary:
+*  Writes the full "%c" text and a terminating NUL.
+*
+* Parameters:
+*  char *dst                             : TIME_FORMAT_C_LEN + 1 byte buffer
+*  const calendar_date_time_t *date_time : Date and time to write
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void time_format_c(char *dst, const calendar_date_time_t *date_time)
+{
+    time_format_c_date(dst, date_time);
+    time_format_c_time(dst, date_time->hour, date_time->min, date_time->sec);
+    dst[TIME_FORMAT_C_LEN] = '\0';
+}
+
+/*******************************************************************************
+* Function Name: time_format_c_bcd
+********************************************************************************
+* Summary:
+*  Writes the full "%c" text and a terminating NUL straight from the BCD
+*  RTC_TIME and RTC_DATE registers, without converting the fields to binary.
+*  The RTC must be in 24-hour mode.
+*
+* Parameters:
+*  char *dst         : TIME_FORMAT_C_LEN + 1 byte buffer
+*  uint32_t rtc_time : Value of the RTC_TIME register
+*  uint32_t rtc_date : Value of the RTC_DATE register
+*  uint32_t century  : Century added to the two-digit RTC year, e.g. 2000
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void time_format_c_bcd(char *dst, uint32_t rtc_time, uint32_t rtc_date,
+                       uint32_t century)
+{
+    uint32_t wday = _FLD2VAL(BACKUP_RTC_TIME_RTC_DAY, rtc_time);
+    uint32_t month = _FLD2VAL(BACKUP_RTC_DATE_RTC_MON, rtc_date);
+    uint32_t mday = _FLD2VAL(BACKUP_RTC_DATE_RTC_DATE, rtc_date);
+
+    memcpy(&dst[TIME_FORMAT_C_WDAY_OFFSET], weekday_names[wday - 1u], 3u);
+    dst[TIME_FORMAT_C_WDAY_OFFSET + 3u] = ' ';
+
+    /* BCD months 0x10..0x12 are 6 above their binary value */
+    memcpy(&dst[TIME_FORMAT_C_MONTH_OFFSET],
+           month_names[month - 1u - (6u * (month >> 4u))], 3u);
+    dst[TIME_FORMAT_C_MONTH_OFFSET + 3u] = ' ';
+
+    /* %e pads the day with a space */
+    time_format_bcd(&dst[TIME_FORMAT_C_MDAY_OFFSET], mday);
+    if (0u == (mday >> 4u))
+    {
+        dst[TIME_FORMAT_C_MDAY_OFFSET] = ' ';
+    }
+    dst[TIME_FORMAT_C_MDAY_OFFSET + 2u] = ' ';
+
+    time_format_bcd(&dst[TIME_FORMAT_C_HOUR_OFFSET],
+                    _FLD2VAL(BACKUP_RTC_TIME_RTC_HOUR, rtc_time));
+    dst[TIME_FORMAT_C_MIN_OFFSET - 1u] = ':';
+    time_format_bcd(&dst[TIME_FORMAT_C_MIN_OFFSET],
+                    _FLD2VAL(BACKUP_RTC_TIME_RTC_MIN, rtc_time));
+    dst[TIME_FORMAT_C_SEC_OFFSET - 1u] = ':';
+    time_format_bcd(&dst[TIME_FORMAT_C_SEC_OFFSET],
+                    _FLD2VAL(BACKUP_RTC_TIME_RTC_SEC, rtc_time));
+    dst[TIME_FORMAT_C_YEAR_OFFSET - 1u] = ' ';
+
+    time_format_2d(&dst[TIME_FORMAT_C_YEAR_OFFSET], century / 100u);
+    time_format_bcd(&dst[TIME_FORMAT_C_YEAR_OFFSET + 2u],
+                    _FLD2VAL(BACKUP_RTC_DATE_RTC_YEAR, rtc_date));
+    dst[TIME_FORMAT_C_LEN] = '\0';
+}
+
+/*******************************************************************************
+* Function Name: time_format_cache_invalidate
+********************************************************************************
+* Summary:
+*  Forces the next render to write the date fields. Call when the time was
+*  set or the DST feature was changed.
+*
+* Parameters:
+*  time_format_cache_t *cache : Render cache
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void time_format_cache_invalidate(time_format_cache_t *cache)
+{
+    cache->day = 0u;
+}
+
+/*******************************************************************************
+* Function Name: time_format_cache_render
+********************************************************************************
+* Summary:
+*  Updates cache->text to the "%c" text of a date and time. While the day is
+*  the one already rendered, only the eight "HH:MM:SS" characters are
+*  written; a new day, including the midnight rollover, rewrites the date
+*  fields.
+*
+* Parameters:
+*  time_format_cache_t *cache            : Render cache
+*  const calendar_date_time_t *date_time : Date and time to render
+*
+* Return:
+*  true if the date fields were reused
+*
+*******************************************************************************/
+bool time_format_cache_render(time_format_cache_t *cache,
+                              const calendar_date_time_t *date_time)
+{
+    uint32_t day = CACHE_DAY(date_time->year, date_time->month,
+                             date_time->mday);
+    bool hit = (day == cache->day);
+
+    if (hit)
+    {
+        cache->hits++;
+    }
+    else
+    {
+        time_format_c_date(cache->text, date_time);
+        cache->text[TIME_FORMAT_C_LEN] = '\0';
+        cache->day = day;
+        cache->misses++;
+    }
+
+    time_format_c_time(cache->text, date_time->hour, date_time->min,
+                       date_time->sec);
+
+    return hit;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name:   time_format.h
+*
+* Description: Fast fixed-layout date and time formatter for the console
+*              display. Produces the same text as strftime("%c") without
+*              format-string parsing.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "calendar.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Layout of the "%c" text: "Www Mmm dd HH:MM:SS yyyy" */
+#define TIME_FORMAT_C_LEN (24u)
+#define TIME_FORMAT_C_WDAY_OFFSET (0u)
+#define TIME_FORMAT_C_MONTH_OFFSET (4u)
+#define TIME_FORMAT_C_MDAY_OFFSET (8u)
+#define TIME_FORMAT_C_HOUR_OFFSET (11u)
+#define TIME_FORMAT_C_MIN_OFFSET (14u)
+#define TIME_FORMAT_C_SEC_OFFSET (17u)
+#define TIME_FORMAT_C_YEAR_OFFSET (20u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* "%c" text whose date fields are rendered once per day */
+typedef struct
+{
+    char text[TIME_FORMAT_C_LEN + 1u];
+    uint32_t day;       /* Packed year, month and day of text, 0 if none */
+    uint32_t hits;      /* Renders that reused the date fields */
+    uint32_t misses;    /* Renders that wrote the date fields */
+} time_format_cache_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* "00" to "99" as consecutive character pairs */
+extern const char time_format_digits[200];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: time_format_2d
+********************************************************************************
+* Summary:
+*  Writes a value 0..99 as two decimal digits, without a terminator.
+*
+* Parameters:
+*  char *dst      : Destination of the two characters
+*  uint32_t value : Value to write, 0..99
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void time_format_2d(char *dst, uint32_t value)
+{
+    dst[0] = time_format_digits[2u * value];
+    dst[1] = time_format_digits[(2u * value) + 1u];
+}
+
+/*******************************************************************************
+* Function Name: time_format_bcd
+********************************************************************************
+* Summary:
+*  Writes a two-digit BCD value as two decimal digits, without a terminator.
+*  Each nibble is already a digit, so no table or division is needed.
+*
+* Parameters:
+*  char *dst    : Destination of the two characters
+*  uint32_t bcd : BCD value to write, 0x00..0x99
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void time_format_bcd(char *dst, uint32_t bcd)
+{
+    dst[0] = (char)('0' + (bcd >> 4u));
+    dst[1] = (char)('0' + (bcd & 0x0Fu));
+}
+
+void time_format_c_date(char *dst, const calendar_date_time_t *date_time);
+void time_format_c_time(char *dst, uint32_t hour, uint32_t min, uint32_t sec);
+void time_format_c(char *dst, const calendar_date_time_t *date_time);
+void time_format_c_bcd(char *dst, uint32_t rtc_time, uint32_t rtc_date,
+                       uint32_t century);
+void time_format_cache_invalidate(time_format_cache_t *cache);
+bool time_format_cache_render(time_format_cache_t *cache,
+                              const calendar_date_time_t *date_time);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIME_FORMAT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name:   timestamp_codec.c
+*
+* Description: Delta-of-delta bit-packed codec of timestamp series.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "timestamp_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Prefixes of the dod classes, see timestamp_codec.h */
+#define PREFIX_ZERO (0x0u)
+#define PREFIX_1 (0x2u)
+#define PREFIX_2 (0x6u)
+#define PREFIX_3 (0xEu)
+#define PREFIX_RAW (0x1Eu)
+#define PREFIX_END (0x1Fu)
+
+#define BITS_PER_BYTE (8u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static inline bool fits(uint64_t dod, uint32_t bits);
+static inline void put_bits(timestamp_codec_t *codec, uint32_t value,
+                            uint32_t bits);
+static inline void put_u64(timestamp_codec_t *codec, uint64_t value);
+static inline bool has_room(const timestamp_codec_t *codec, uint32_t bits);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: fits
+********************************************************************************
+* Summary:
+*  Tells whether a dod, read as two's complement, fits a two's complement
+*  field.
+*
+* Parameters:
+*  uint64_t dod  : Delta of delta, modulo 2^64
+*  uint32_t bits : Field width, less than 64
+*
+* Return:
+*  true if -2^(bits-1) <= dod < 2^(bits-1)
+*
+*******************************************************************************/
+static inline bool fits(uint64_t dod, uint32_t bits)
+{
+    uint64_t half = 1ULL << (bits - 1u);
+
+    return (dod + half) < (half << 1u);
+}
+
+/*******************************************************************************
+* Function Name: put_bits
+********************************************************************************
+* Summary:
+*  Appends the low bits of a value and moves the complete bytes to the
+*  buffer. Room has been checked by the caller.
+*
+* Parameters:
+*  timestamp_codec_t *codec : Codec
+*  uint32_t value           : Bits to append, in the low bits
+*  uint32_t bits            : Number of bits, at most 32
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void put_bits(timestamp_codec_t *codec, uint32_t value,
+                            uint32_t bits)
+{
+    uint32_t pending_bits = codec->pending_bits + bits;
+    uint64_t pending = (codec->pending << bits) |
+                       (value & (uint32_t)((1ULL << bits) - 1u));
+    uint32_t used = codec->used;
+
+    while (pending_bits >= BITS_PER_BYTE)
+    {
+        pending_bits -= BITS_PER_BYTE;
+        codec->buffer[used] = (uint8_t)(pending >> pending_bits);
+        used++;
+    }
+
+    codec->pending = pending;
+    codec->pending_bits = pending_bits;
+    codec->used = used;
+}
+
+/*******************************************************************************
+* Function Name: put_u64
+********************************************************************************
+* Summary:
+*  Appends 64 bits.
+*
+* Parameters:
+*  timestamp_codec_t *codec : Codec
+*  uint64_t value           : Value to append
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static inline void put_u64(timestamp_codec_t *codec, uint64_t value)
+{
+    put_bits(codec, (uint32_t)(value >> 32u), 32u);
+    put_bits(codec, (uint32_t)value, 32u);
+}
+
+/*******************************************************************************
+* Function Name: has_room
+********************************************************************************
+* Summary:
+*  Tells whether a code fits while keeping room for the end marker.
+*
+* Parameters:
+*  const timestamp_codec_t *codec : Codec
+*  uint32_t bits                  : Bits of the code
+*
+* Return:
+*  true if the code fits
+*
+*******************************************************************************/
+static inline bool has_room(const timestamp_codec_t *codec, uint32_t bits)
+{
+    uint32_t total = (codec->used * BITS_PER_BYTE) + codec->pending_bits +
+                     bits + TIMESTAMP_CODEC_END_BITS;
+
+    return total <= (codec->capacity * BITS_PER_BYTE);
+}
+
+/*******************************************************************************
+* Function Name: timestamp_codec_init
+********************************************************************************
+* Summary:
+*  Starts an empty stream in a buffer.
+*
+* Parameters:
+*  timestamp_codec_t *codec : Codec
+*  uint8_t *buffer          : Stream buffer
+*  uint32_t capacity        : Bytes of buffer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timestamp_codec_init(timestamp_codec_t *codec, uint8_t *buffer,
+                          uint32_t capacity)
+{
+    codec->buffer = buffer;
+    codec->capacity = capacity;
+    codec->used = 0u;
+    codec->pending = 0u;
+    codec->pending_bits = 0u;
+    codec->last = 0u;
+    codec->last_delta = 0u;
+    codec->count = 0u;
+    codec->dropped = 0u;
+    codec->finished = false;
+}
+
+/*******************************************************************************
+* Function Name: timestamp_codec_append
+********************************************************************************
+* Summary:
+*  Appends a timestamp in bounded time: at most four range checks and nine
+*  byte stores. Not reentrant; append from one context only.
+*
+* Parameters:
+*  timestamp_codec_t *codec : Codec
+*  uint64_t timestamp       : Timestamp, any unit
+*
+* Return:
+*  false if the stream is full or finished; the timestamp is dropped
+*
+*******************************************************************************/
+bool timestamp_codec_append(timestamp_codec_t *codec, uint64_t timestamp)
+{
+    if (0u == codec->count)
+    {
+        if ((codec->finished) || (!has_room(codec, TIMESTAMP_CODEC_BITS_RAW)))
+        {
+            codec->dropped++;
+            return false;
+        }
+        put_u64(codec, timestamp);
+        codec->last = timestamp;
+        codec->count = 1u;
+        return true;
+    }
+
+    /* Modulo 2^64: a step back or a jump of any size does not overflow */
+    uint64_t delta = timestamp - codec->last;
+    uint64_t dod = delta - codec->last_delta;
+    uint32_t prefix;
+    uint32_t prefix_bits;
+    uint32_t bits;
+
+    if (0u == dod)
+    {
+        prefix = PREFIX_ZERO;
+        prefix_bits = 1u;
+        bits = 0u;
+    }
+    else if (fits(dod, TIMESTAMP_CODEC_BITS_1))
+    {
+        prefix = PREFIX_1;
+        prefix_bits = 2u;
+        bits = TIMESTAMP_CODEC_BITS_1;
+    }
+    else if (fits(dod, TIMESTAMP_CODEC_BITS_2))
+    {
+        prefix = PREFIX_2;
+        prefix_bits = 3u;
+        bits = TIMESTAMP_CODEC_BITS_2;
+    }
+    else if (fits(dod, TIMESTAMP_CODEC_BITS_3))
+    {
+        prefix = PREFIX_3;
+        prefix_bits = 4u;
+        bits = TIMESTAMP_CODEC_BITS_3;
+    }
+    else
+    {
+        prefix = PREFIX_RAW;
+        prefix_bits = 5u;
+        bits = TIMESTAMP_CODEC_BITS_RAW;
+    }
+
+    if ((codec->finished) || (!has_room(codec, prefix_bits + bits)))
+    {
+        codec->dropped++;
+        return false;
+    }
+
+    if (TIMESTAMP_CODEC_BITS_RAW == bits)
+    {
+        put_bits(codec, prefix, prefix_bits);
+        put_u64(codec, dod);
+    }
+    else
+    {
+        /* At most 4 + 24 bits, one call */
+        put_bits(codec, (prefix << bits) | ((uint32_t)dod &
+                 (uint32_t)((1ULL << bits) - 1u)), prefix_bits + bits);
+    }
+
+    codec->last = timestamp;
+    codec->last_delta = delta;
+    codec->count++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: timestamp_codec_finish
+********************************************************************************
+* Summary:
+*  Ends the stream with the end marker and pads it to a byte. Further
+*  appends are dropped.
+*
+* Parameters:
+*  timestamp_codec_t *codec : Codec
+*
+* Return:
+*  Bytes of the stream
+*
+*******************************************************************************/
+uint32_t timestamp_codec_finish(timestamp_codec_t *codec)
+{
+    if (!codec->finished)
+    {
+        put_bits(codec, PREFIX_END, TIMESTAMP_CODEC_END_BITS);
+        if (0u != codec->pending_bits)
+        {
+            put_bits(codec, 0u, BITS_PER_BYTE - codec->pending_bits);
+        }
+        codec->finished = true;
+    }
+
+    return codec->used;
+}
+
+/*******************************************************************************
+* Function Name: timestamp_codec_bits
+********************************************************************************
+* Summary:
+*  Returns the bits written so far, pending bits included, for the bits per
+*  timestamp of the stream.
+*
+* Parameters:
+*  const timestamp_codec_t *codec : Codec
+*
+* Return:
+*  Bits of the stream
+*
+*******************************************************************************/
+uint64_t timestamp_codec_bits(const timestamp_codec_t *codec)
+{
+    return ((uint64_t)codec->used * BITS_PER_BYTE) + codec->pending_bits;
+}
+
+/* [] END OF FILE */
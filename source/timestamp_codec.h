@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   timestamp_codec.h
+*
+* Description: Delta-of-delta bit-packed codec of timestamp series, after
+*              the Gorilla time series format: nearly periodic timestamps
+*              cost one or a few bits each. Append is O(1); the host tool
+*              tools/ts_codec.c decodes the stream.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TIMESTAMP_CODEC_H
+#define TIMESTAMP_CODEC_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Stream format, bits most significant first:
+     first timestamp, 64 bits
+   then for each further timestamp, dod = delta - previous delta, with the
+   delta before the first one taken as 0:
+     '0'                          dod = 0
+     '10'    + 7-bit dod          -64 .. 63
+     '110'   + 12-bit dod         -2048 .. 2047
+     '1110'  + 24-bit dod         -2^23 .. 2^23 - 1
+     '11110' + 64-bit dod         any
+   and after timestamp_codec_finish():
+     '11111', then 0 bits up to the byte boundary
+   The dod fields are two's complement. */
+#define TIMESTAMP_CODEC_BITS_1 (7u)
+#define TIMESTAMP_CODEC_BITS_2 (12u)
+#define TIMESTAMP_CODEC_BITS_3 (24u)
+#define TIMESTAMP_CODEC_BITS_RAW (64u)
+
+/* Largest code and the end marker; the buffer always keeps room for the
+   end marker */
+#define TIMESTAMP_CODEC_MAX_CODE_BITS (5u + TIMESTAMP_CODEC_BITS_RAW)
+#define TIMESTAMP_CODEC_END_BITS (5u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Only buffer[0 .. used - 1] is complete; bytes below used do not change
+   after they are written, so a reader may copy them while appends go on */
+typedef struct
+{
+    uint8_t *buffer;
+    uint32_t capacity;          /* Bytes of buffer */
+    volatile uint32_t used;     /* Complete bytes in buffer */
+    uint64_t pending;           /* Bits not yet in buffer, low bits */
+    uint32_t pending_bits;      /* 0 .. 7 between appends */
+    uint64_t last;              /* Last timestamp appended */
+    uint64_t last_delta;        /* Last delta, modulo 2^64 */
+    uint32_t count;             /* Timestamps appended */
+    uint32_t dropped;           /* Timestamps that did not fit */
+    bool finished;
+} timestamp_codec_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void timestamp_codec_init(timestamp_codec_t *codec, uint8_t *buffer,
+                          uint32_t capacity);
+bool timestamp_codec_append(timestamp_codec_t *codec, uint64_t timestamp);
+uint32_t timestamp_codec_finish(timestamp_codec_t *codec);
+uint64_t timestamp_codec_bits(const timestamp_codec_t *codec);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIMESTAMP_CODEC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,603 @@
+/******************************************************************************
+* File Name:   world_clock.c
+*
+* Description: Multi-zone world clock. The RTC is read once per refresh, each
+*              zone applies a cached UTC offset that is only recomputed when a
+*              DST transition is crossed, the shared minutes and seconds are
+*              formatted once for all zones, and only changed characters are
+*              sent to the terminal.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "world_clock.h"
+#include "calendar.h"
+#include "time_format.h"
+#include "string.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECONDS_PER_MINUTE (60)
+#define SECONDS_PER_HOUR (3600)
+#define SECONDS_PER_DAY (86400u)
+
+/* Screen layout: title on row 1, one zone per row from ZONE_FIRST_ROW */
+#define ZONE_FIRST_ROW (3u)
+#define ZONE_NAME_WIDTH (12u)
+#define ZONE_TIME_COLUMN (ZONE_NAME_WIDTH + 1u)
+#define ZONE_DST_COLUMN (ZONE_TIME_COLUMN + TIME_FORMAT_C_LEN)
+#define ZONE_LINE_LEN (ZONE_DST_COLUMN + 4u)
+
+#define WORLD_CLOCK_ZONES (3u)
+#define ZONE_LOCAL (0u)
+
+/* Cache window that forces a recompute on the next refresh */
+#define WINDOW_EXPIRED (0u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    int32_t std_offset;                 /* standard-time offset, seconds */
+    const cy_stc_rtc_dst_t *dst_rule;   /* NULL: zone does not observe DST */
+} zone_config_t;
+
+typedef struct
+{
+    int32_t offset;       /* current UTC offset including DST, seconds */
+    bool dst_active;
+    uint32_t valid_from;  /* UTC seconds, offset is valid in [from, until) */
+    uint32_t valid_until;
+    uint32_t day;         /* day number of the rendered date */
+    char line[ZONE_LINE_LEN];
+    char shown[ZONE_LINE_LEN];
+} zone_state_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Central European rule for the head office: 02:00 last Sunday of March to
+   03:00 (DST time) last Sunday of October */
+static const cy_stc_rtc_dst_t hq_dst_rule =
+{
+    .startDst = {CY_RTC_DST_RELATIVE, 2u, 1u, CY_RTC_LAST_WEEK_OF_MONTH,
+                 CY_RTC_SUNDAY, CY_RTC_MARCH},
+    .stopDst = {CY_RTC_DST_RELATIVE, 3u, 1u, CY_RTC_LAST_WEEK_OF_MONTH,
+                CY_RTC_SUNDAY, CY_RTC_OCTOBER},
+};
+
+static zone_config_t zones[WORLD_CLOCK_ZONES] =
+{
+    {"Local", WORLD_CLOCK_LOCAL_UTC_OFFSET_MIN * SECONDS_PER_MINUTE, NULL},
+    {"UTC", 0, NULL},
+    {WORLD_CLOCK_HQ_NAME, WORLD_CLOCK_HQ_UTC_OFFSET_MIN * SECONDS_PER_MINUTE,
+     &hq_dst_rule},
+};
+
+static zone_state_t zone_state[WORLD_CLOCK_ZONES];
+
+/* Offset returned by world_clock_local_utc_offset(), cached separately from
+   the rendered local zone */
+static zone_state_t local_query;
+
+/* DST state of the RTC, told by the application; decides the UTC offset in
+   the hour that the local time repeats after the DST stop */
+static volatile bool local_dst_active = false;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t local_to_utc(zone_state_t *state, uint32_t local);
+static void update_offset(const zone_config_t *zone, zone_state_t *state,
+                          uint32_t utc);
+static uint32_t transition_seconds(uint32_t year, uint32_t month,
+                                   uint32_t mday, uint32_t hour);
+static void to_calendar_rule(const cy_stc_rtc_dst_format_t *format,
+                             calendar_dst_rule_t *rule);
+static void redraw_line(uint32_t row, zone_state_t *state);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: world_clock_start
+********************************************************************************
+* Summary:
+*  Clears the terminal and draws the static part of the world clock. The next
+*  refresh draws every zone in full.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void world_clock_start(void)
+{
+    /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
+    printf("\x1b[2J\x1b[;H");
+    printf("World clock (press any key to return)\r\n");
+
+    for (uint32_t i = 0u; i < WORLD_CLOCK_ZONES; i++)
+    {
+        zone_state_t *state = &zone_state[i];
+
+        memset(state->line, ' ', ZONE_LINE_LEN);
+        memcpy(state->line, zones[i].name, strlen(zones[i].name));
+        memset(state->shown, '\0', ZONE_LINE_LEN);
+    }
+
+    /* The zone lines were reset, so the DST markers must be rewritten */
+    world_clock_invalidate();
+}
+
+/*******************************************************************************
+* Function Name: world_clock_refresh
+********************************************************************************
+* Summary:
+*  Renders all zones from one local RTC time. The minutes and seconds are the
+*  same in every whole-hour zone and are formatted once; per zone only the
+*  hour is written, and the date only when the zone's day changes.
+*
+* Parameters:
+*  const cy_stc_rtc_config_t *local_time : RTC time read by the caller
+*  uint32_t century                      : Century added to the RTC year
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void world_clock_refresh(const cy_stc_rtc_config_t *local_time,
+                         uint32_t century)
+{
+    calendar_date_time_t local =
+    {
+        .year = local_time->year + century,
+        .month = local_time->month,
+        .mday = local_time->date,
+        .hour = local_time->hour,
+        .min = local_time->min,
+        .sec = local_time->sec,
+    };
+    uint32_t utc = local_to_utc(&zone_state[ZONE_LOCAL],
+                                calendar_to_seconds(&local));
+    char shared[TIME_FORMAT_C_LEN];
+
+    /* Shared "MM:SS" of all whole-hour zones, formatted once */
+    time_format_c_time(shared, 0u,
+                       (utc % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE,
+                       utc % SECONDS_PER_MINUTE);
+
+    for (uint32_t i = 0u; i < WORLD_CLOCK_ZONES; i++)
+    {
+        zone_state_t *state = &zone_state[i];
+        char *text = &state->line[ZONE_TIME_COLUMN];
+        uint32_t seconds;
+
+        if ((utc < state->valid_from) || (utc >= state->valid_until))
+        {
+            update_offset(&zones[i], state, utc);
+        }
+
+        seconds = utc + (uint32_t)state->offset;
+
+        if ((seconds / SECONDS_PER_DAY) != state->day)
+        {
+            calendar_date_time_t date;
+
+            calendar_from_seconds(seconds, &date);
+            time_format_c_date(text, &date);
+            state->day = seconds / SECONDS_PER_DAY;
+        }
+
+        if (0 == (state->offset % SECONDS_PER_HOUR))
+        {
+            memcpy(&text[TIME_FORMAT_C_MIN_OFFSET - 1u],
+                   &shared[TIME_FORMAT_C_MIN_OFFSET - 1u], 6u);
+            time_format_2d(&text[TIME_FORMAT_C_HOUR_OFFSET],
+                           (seconds % SECONDS_PER_DAY) / SECONDS_PER_HOUR);
+        }
+        else
+        {
+            time_format_c_time(text,
+                               (seconds % SECONDS_PER_DAY) / SECONDS_PER_HOUR,
+                               (seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE,
+                               seconds % SECONDS_PER_MINUTE);
+        }
+
+        redraw_line(ZONE_FIRST_ROW + i, state);
+    }
+}
+
+/*******************************************************************************
+* Function Name: world_clock_set_local_dst
+********************************************************************************
+* Summary:
+*  Sets the DST rule the RTC follows, so that local time converts to UTC
+*  correctly, and drops all cached offsets.
+*
+* Parameters:
+*  const cy_stc_rtc_dst_t *dst_rule : Active DST rule, NULL if DST is disabled
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void world_clock_set_local_dst(const cy_stc_rtc_dst_t *dst_rule)
+{
+    zones[ZONE_LOCAL].dst_rule = dst_rule;
+    world_clock_invalidate();
+}
+
+/*******************************************************************************
+* Function Name: world_clock_set_local_dst_active
+********************************************************************************
+* Summary:
+*  Tells whether the RTC is in DST. Only the hour after the DST stop, which
+*  the local time repeats, depends on it. Call at boot, after the time or the
+*  DST rule was set, and at each DST transition, followed by
+*  world_clock_invalidate().
+*
+* Parameters:
+*  bool dst_active : true if the RTC time is DST time
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void world_clock_set_local_dst_active(bool dst_active)
+{
+    local_dst_active = dst_active;
+}
+
+/*******************************************************************************
+* Function Name: world_clock_invalidate
+********************************************************************************
+* Summary:
+*  Drops all cached zone offsets, for example after the RTC time was set.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void world_clock_invalidate(void)
+{
+    for (uint32_t i = 0u; i < WORLD_CLOCK_ZONES; i++)
+    {
+        zone_state[i].valid_from = WINDOW_EXPIRED;
+        zone_state[i].valid_until = WINDOW_EXPIRED;
+        zone_state[i].day = UINT32_MAX;
+    }
+
+    local_query.valid_from = WINDOW_EXPIRED;
+    local_query.valid_until = WINDOW_EXPIRED;
+}
+
+/*******************************************************************************
+* Function Name: world_clock_local_utc_offset
+********************************************************************************
+* Summary:
+*  Returns the UTC offset of the zone the RTC is set to at an instant,
+*  including DST when the local rule is active. The offset is only recomputed
+*  when the instant is outside the window of the previous call.
+*
+* Parameters:
+*  uint32_t utc : Instant, UTC seconds since 2000
+*
+* Return:
+*  Offset to add to UTC to get the RTC time, in seconds
+*
+*******************************************************************************/
+int32_t world_clock_local_utc_offset(uint32_t utc)
+{
+    if ((utc < local_query.valid_from) || (utc >= local_query.valid_until))
+    {
+        update_offset(&zones[ZONE_LOCAL], &local_query, utc);
+    }
+
+    return local_query.offset;
+}
+
+/*******************************************************************************
+* Function Name: world_clock_local_to_utc
+********************************************************************************
+* Summary:
+*  Converts an RTC time to UTC. In the hour repeated after the DST stop, the
+*  DST state set with world_clock_set_local_dst_active() picks the offset.
+*
+* Parameters:
+*  uint32_t local : RTC time, seconds since 2000
+*
+* Return:
+*  UTC seconds since 2000
+*
+*******************************************************************************/
+uint32_t world_clock_local_to_utc(uint32_t local)
+{
+    return local_to_utc(&local_query, local);
+}
+
+/*******************************************************************************
+* Function Name: local_to_utc
+********************************************************************************
+* Summary:
+*  Converts an RTC time to UTC with the cached offset of a local zone state.
+*  The offset is recomputed outside its window, and in the last DST hour and
+*  the first standard hour of a window, where a local time can map to both.
+*  There, a local time that is valid in DST and in standard time is resolved
+*  with the DST state of the RTC. A local time skipped at the DST start is
+*  taken as standard time.
+*
+* Parameters:
+*  zone_state_t *state : Local zone cache to use and update
+*  uint32_t local      : RTC time, seconds since 2000
+*
+* Return:
+*  UTC seconds since 2000
+*
+*******************************************************************************/
+static uint32_t local_to_utc(zone_state_t *state, uint32_t local)
+{
+    const zone_config_t *zone = &zones[ZONE_LOCAL];
+    uint32_t utc = local - (uint32_t)state->offset;
+    uint32_t utc_std;
+    uint32_t utc_dst;
+    bool std_fits;
+    bool dst_fits;
+
+    if ((utc >= state->valid_from) && (utc < state->valid_until) &&
+        ((NULL == zone->dst_rule) ||
+         (state->dst_active ? ((state->valid_until - utc) > SECONDS_PER_HOUR) :
+                              ((utc - state->valid_from) >= SECONDS_PER_HOUR))))
+    {
+        return utc;
+    }
+
+    utc_std = local - (uint32_t)zone->std_offset;
+    utc_dst = utc_std - SECONDS_PER_HOUR;
+
+    update_offset(zone, state, utc_dst);
+    dst_fits = state->dst_active;
+    update_offset(zone, state, utc_std);
+    std_fits = !state->dst_active;
+
+    if (dst_fits && (!std_fits || local_dst_active))
+    {
+        update_offset(zone, state, utc_dst);
+        utc = utc_dst;
+    }
+    else
+    {
+        utc = utc_std;
+    }
+
+    return utc;
+}
+
+/*******************************************************************************
+* Function Name: update_offset
+********************************************************************************
+* Summary:
+*  Computes the UTC offset of a zone at the given instant and the window in
+*  which it stays valid. Transitions follow the PDL DST engine: DST starts at
+*  the start hour in standard time and ends at the stop hour in DST time.
+*
+* Parameters:
+*  const zone_config_t *zone : Zone configuration
+*  zone_state_t *state       : Zone cache to update
+*  uint32_t utc              : Instant, UTC seconds since 2000
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void update_offset(const zone_config_t *zone, zone_state_t *state,
+                          uint32_t utc)
+{
+    calendar_dst_transition_t dst;
+    calendar_date_time_t date;
+    uint32_t std_local = utc + (uint32_t)zone->std_offset;
+    uint32_t year_start;
+    uint32_t year_end;
+    uint32_t start;
+    uint32_t stop;
+    uint32_t from;
+    uint32_t until;
+
+    state->offset = zone->std_offset;
+    state->dst_active = false;
+
+    calendar_from_seconds(std_local, &date);
+    year_start = transition_seconds(date.year, 1u, 1u, 0u);
+    year_end = transition_seconds(date.year + 1u, 1u, 1u, 0u);
+
+    if (NULL == zone->dst_rule)
+    {
+        from = year_start;
+        until = year_end;
+    }
+    else
+    {
+        calendar_dst_rule_t rule_start;
+        calendar_dst_rule_t rule_stop;
+
+        to_calendar_rule(&zone->dst_rule->startDst, &rule_start);
+        to_calendar_rule(&zone->dst_rule->stopDst, &rule_stop);
+        calendar_resolve_dst(&rule_start, &rule_stop, date.year, &dst);
+        start = transition_seconds(date.year, dst.start_month,
+                                   dst.start_mday, dst.start_hour);
+        stop = transition_seconds(date.year, dst.stop_month,
+                                  dst.stop_mday, dst.stop_hour) -
+               SECONDS_PER_HOUR;
+
+        if (start < stop)
+        {
+            /* Northern hemisphere: DST inside the year */
+            state->dst_active = (std_local >= start) && (std_local < stop);
+            from = (std_local < start) ? year_start :
+                   ((std_local < stop) ? start : stop);
+            until = (std_local < start) ? start :
+                    ((std_local < stop) ? stop : year_end);
+        }
+        else
+        {
+            /* Southern hemisphere: DST across the new year */
+            state->dst_active = (std_local < stop) || (std_local >= start);
+            from = (std_local < stop) ? year_start :
+                   ((std_local < start) ? stop : start);
+            until = (std_local < stop) ? stop :
+                    ((std_local < start) ? start : year_end);
+        }
+    }
+
+    if (state->dst_active)
+    {
+        state->offset += SECONDS_PER_HOUR;
+    }
+    memcpy(&state->line[ZONE_DST_COLUMN], state->dst_active ? " DST" : "    ",
+           4u);
+
+    state->valid_from = from - (uint32_t)zone->std_offset;
+    state->valid_until = until - (uint32_t)zone->std_offset;
+}
+
+/*******************************************************************************
+* Function Name: transition_seconds
+********************************************************************************
+* Summary:
+*  Seconds since 2000 of a date at a full hour.
+*
+* Parameters:
+*  uint32_t year  : The year value
+*  uint32_t month : The month of the year, 1..12
+*  uint32_t mday  : The day of the month
+*  uint32_t hour  : The hour, 0..23
+*
+* Return:
+*  Seconds since CALENDAR_EPOCH_YEAR
+*
+*******************************************************************************/
+static uint32_t transition_seconds(uint32_t year, uint32_t month,
+                                   uint32_t mday, uint32_t hour)
+{
+    calendar_date_time_t date =
+    {
+        .year = year,
+        .month = month,
+        .mday = mday,
+        .hour = hour,
+    };
+
+    return calendar_to_seconds(&date);
+}
+
+/*******************************************************************************
+* Function Name: to_calendar_rule
+********************************************************************************
+* Summary:
+*  Copies a PDL DST rule edge into the calendar library representation.
+*
+* Parameters:
+*  const cy_stc_rtc_dst_format_t *format : PDL rule edge
+*  calendar_dst_rule_t *rule             : Calendar rule edge
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void to_calendar_rule(const cy_stc_rtc_dst_format_t *format,
+                             calendar_dst_rule_t *rule)
+{
+    rule->format = (uint32_t)format->format;
+    rule->hour = format->hour;
+    rule->day_of_month = format->dayOfMonth;
+    rule->week_of_month = format->weekOfMonth;
+    rule->day_of_week = format->dayOfWeek;
+    rule->month = format->month;
+}
+
+/*******************************************************************************
+* Function Name: redraw_line
+********************************************************************************
+* Summary:
+*  Sends only the span of a zone line that differs from what the terminal
+*  shows, using absolute cursor positioning.
+*
+* Parameters:
+*  uint32_t row        : Terminal row of the zone
+*  zone_state_t *state : Zone with the new and the shown line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void redraw_line(uint32_t row, zone_state_t *state)
+{
+    uint32_t first = 0u;
+    uint32_t last = ZONE_LINE_LEN;
+
+    while ((first < ZONE_LINE_LEN) && (state->line[first] == state->shown[first]))
+    {
+        first++;
+    }
+
+    if (first < ZONE_LINE_LEN)
+    {
+        while (state->line[last - 1u] == state->shown[last - 1u])
+        {
+            last--;
+        }
+
+        /* Columns are 1-based in the ANSI cursor position sequence */
+        printf("\x1b[%" PRIu32 ";%" PRIu32 "H%.*s", row, first + 1u,
+               (int)(last - first), &state->line[first]);
+        memcpy(&state->shown[first], &state->line[first], last - first);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   world_clock.h
+*
+* Description: Multi-zone world clock display rendered from one RTC read.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef WORLD_CLOCK_H
+#define WORLD_CLOCK_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Standard-time UTC offset of the zone the RTC is set to, in minutes */
+#ifndef WORLD_CLOCK_LOCAL_UTC_OFFSET_MIN
+#define WORLD_CLOCK_LOCAL_UTC_OFFSET_MIN (0)
+#endif
+
+/* Head office zone: name, standard-time UTC offset in minutes */
+#ifndef WORLD_CLOCK_HQ_NAME
+#define WORLD_CLOCK_HQ_NAME "Head office"
+#define WORLD_CLOCK_HQ_UTC_OFFSET_MIN (60)
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void world_clock_start(void);
+void world_clock_refresh(const cy_stc_rtc_config_t *local_time,
+                         uint32_t century);
+void world_clock_set_local_dst(const cy_stc_rtc_dst_t *dst_rule);
+void world_clock_set_local_dst_active(bool dst_active);
+void world_clock_invalidate(void);
+int32_t world_clock_local_utc_offset(uint32_t utc);
+uint32_t world_clock_local_to_utc(uint32_t local);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* WORLD_CLOCK_H */
+
+/* [] END OF FILE */
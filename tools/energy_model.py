@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Estimates the charge per operation and per hour of each firmware feature.
+
+Reads the energy lines printed by the status command ('3' on the console),
+captured from the terminal, and replays them through the current model of
+source/energy_profile.h. The capture gives the cycles per operation and the
+operations per hour of each stage; the model and the workload can then be
+changed on the host to compare features before deployment:
+
+  energy_model.py status.log
+  energy_model.py status.log --mhz 100 --active-ua-per-mhz 90
+  energy_model.py status.log --rate "Display refresh=60" --sleep-idle
+
+The cycles per operation do not depend on the core clock, so --mhz rescales
+the time of every stage. The time not spent in a stage is idle: asleep in the
+share measured by the capture, or always asleep with --sleep-idle, which
+models the tickless idle of the RTOS port on a capture of the super-loop.
+
+Usage: energy_model.py <status capture> [options]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir,
+                      "source", "energy_profile.h")
+
+SECONDS_PER_HOUR = 3600.0
+
+MODEL_LINE = re.compile(r"Energy model\s*:.*?(\d+) MHz, (\d+) ms up")
+STAGE_LINE = re.compile(r"^\s+(.+?)\s*: (\d+) ops, (\d+) cycles/op")
+
+# Stages whose time is idle time rather than work
+SLEEP_STAGE = "Sleep"
+IDLE_STAGE = "Idle"
+
+
+def header_defaults(path):
+    """Returns the ENERGY_* current model macros of energy_profile.h."""
+    defaults = {}
+    with open(path) as header:
+        for line in header:
+            match = re.match(r"#define (ENERGY_\w+_UA\w*) \((\d+)u\)", line)
+            if match:
+                defaults[match.group(1)] = int(match.group(2))
+    return defaults
+
+
+def parse_capture(path):
+    """Returns (mhz, uptime in s, {stage: (ops, cycles per op)}) of the last
+    status report in the capture."""
+    mhz = None
+    uptime = None
+    stages = {}
+    with open(path, errors="replace") as capture:
+        for line in capture:
+            line = line.rstrip("\r\n")
+            match = MODEL_LINE.search(line)
+            if match:
+                mhz = int(match.group(1))
+                uptime = int(match.group(2)) / 1000.0
+                stages = {}
+                continue
+            match = STAGE_LINE.match(line)
+            if match and mhz is not None:
+                stages[match.group(1)] = (int(match.group(2)),
+                                          int(match.group(3)))
+    if mhz is None or not stages or uptime <= 0:
+        raise SystemExit("%s: no energy report found" % path)
+    return mhz, uptime, stages
+
+
+def simulate(stages, uptime, args):
+    """Returns [(stage, ops per hour, cycles per op, nC per op, uAh per hour)]
+    and the total charge per hour in uAh."""
+    active_ua = args.active_base_ua + args.active_ua_per_mhz * args.mhz
+    sleep_ua = args.sleep_base_ua + args.sleep_ua_per_mhz * args.mhz
+    hz = args.mhz * 1e6
+
+    rows = []
+    busy = 0.0
+    for name, (ops, cycles) in stages.items():
+        if name in (SLEEP_STAGE, IDLE_STAGE):
+            continue
+        per_hour = args.rate.get(name, ops * SECONDS_PER_HOUR / uptime)
+        seconds = cycles / hz
+        busy += per_hour * seconds
+        rows.append((name, per_hour, cycles, active_ua * seconds * 1e3,
+                     active_ua * per_hour * seconds / SECONDS_PER_HOUR))
+
+    # Share of the idle time spent asleep, as measured on the target
+    sleep_ops, sleep_cycles = stages.get(SLEEP_STAGE, (0, 0))
+    slept = sleep_ops * sleep_cycles / (args.capture_mhz * 1e6)
+    idle = uptime - sum(ops * cycles / (args.capture_mhz * 1e6)
+                        for name, (ops, cycles) in stages.items()
+                        if name not in (SLEEP_STAGE, IDLE_STAGE))
+    asleep = 1.0 if args.sleep_idle else (slept / idle if idle > 0 else 0.0)
+
+    idle_hour = max(SECONDS_PER_HOUR - busy, 0.0)
+    rows.append((SLEEP_STAGE, 0, 0, 0.0,
+                 sleep_ua * idle_hour * asleep / SECONDS_PER_HOUR))
+    rows.append((IDLE_STAGE, 0, 0, 0.0,
+                 active_ua * idle_hour * (1.0 - asleep) / SECONDS_PER_HOUR))
+
+    return rows, sum(row[4] for row in rows)
+
+
+def rate(text):
+    """Parses a 'stage=operations per hour' option."""
+    name, _, value = text.partition("=")
+    if not value:
+        raise argparse.ArgumentTypeError("expected STAGE=OPS_PER_HOUR")
+    return name.strip(), float(value)
+
+
+def main():
+    defaults = header_defaults(HEADER)
+    parser = argparse.ArgumentParser(
+        description=__doc__.split("\n\n")[0])
+    parser.add_argument("capture", help="terminal log with a status report")
+    parser.add_argument("--mhz", type=float,
+                        help="core clock to model (default: as captured)")
+    parser.add_argument("--active-base-ua", type=float,
+                        default=defaults.get("ENERGY_ACTIVE_BASE_UA"))
+    parser.add_argument("--active-ua-per-mhz", type=float,
+                        default=defaults.get("ENERGY_ACTIVE_UA_PER_MHZ"))
+    parser.add_argument("--sleep-base-ua", type=float,
+                        default=defaults.get("ENERGY_SLEEP_BASE_UA"))
+    parser.add_argument("--sleep-ua-per-mhz", type=float,
+                        default=defaults.get("ENERGY_SLEEP_UA_PER_MHZ"))
+    parser.add_argument("--rate", type=rate, action="append", default=[],
+                        metavar="STAGE=OPS_PER_HOUR",
+                        help="override the operations per hour of a stage")
+    parser.add_argument("--sleep-idle", action="store_true",
+                        help="spend all idle time in CPU Sleep")
+    parser.add_argument("--battery-mah", type=float,
+                        help="also print the battery life")
+    args = parser.parse_args()
+
+    capture_mhz, uptime, stages = parse_capture(args.capture)
+    args.capture_mhz = capture_mhz
+    if args.mhz is None:
+        args.mhz = capture_mhz
+    args.rate = dict(args.rate)
+    for name in args.rate:
+        if name not in stages:
+            raise SystemExit("unknown stage '%s', expected one of: %s" %
+                             (name, ", ".join(stages)))
+
+    rows, total = simulate(stages, uptime, args)
+
+    print("%-18s %10s %10s %10s %12s" %
+          ("Stage", "ops/h", "cycles/op", "nC/op", "uAh/h"))
+    for name, per_hour, cycles, charge, hourly in rows:
+        print("%-18s %10.0f %10d %10.1f %12.3f" %
+              (name, per_hour, cycles, charge, hourly))
+    print("%-18s %10s %10s %10s %12.3f" % ("Total", "", "", "", total))
+
+    if args.battery_mah:
+        print("Battery life: %.1f days" %
+              (args.battery_mah * 1000.0 / total / 24.0))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
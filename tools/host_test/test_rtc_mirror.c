@@ -0,0 +1,201 @@
+/******************************************************************************
+* File Name:   test_rtc_mirror.c
+*
+* Description: Host test of the RTC mirror descriptor chain on the DataWire model
+*              of the PDL shim: each trigger must run the chain exactly once, leave
+*              the channel disabled and a consistent copy of the RTC registers, and
+*              a trigger is skipped while the RTC or the previous chain is busy.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "rtc_mirror.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Descriptors of the chain, see rtc_mirror.c */
+#define CHAIN_LENGTH (6u)
+
+/* RTC seconds simulated */
+#define SECONDS (5u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t errors;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void check(bool condition, const char *what, uint32_t second);
+static void check_second(uint32_t second, uint32_t generation,
+                         uint32_t skipped);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+*  Counts and reports a failed check.
+*
+* Parameters:
+*  bool condition   : The check
+*  const char *what : What was checked
+*  uint32_t second  : Simulated second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check(bool condition, const char *what, uint32_t second)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "second %" PRIu32 ": %s\n", second, what);
+        errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: check_second
+********************************************************************************
+* Summary:
+*  Checks the DataWire channel and the mirror after the chain of a second
+*  ran.
+*
+* Parameters:
+*  uint32_t second     : Simulated second
+*  uint32_t generation : Generation the mirror must hold
+*  uint32_t skipped    : Seconds skipped so far
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check_second(uint32_t second, uint32_t generation,
+                         uint32_t skipped)
+{
+    const pdl_shim_dw_channel_t *ch = &DW0->channel[RTC_MIRROR_CHANNEL];
+    rtc_mirror_sample_t sample = { 0u };
+    rtc_mirror_stats_t stats;
+
+    rtc_mirror_get_stats(&stats);
+
+    check(ch->chains == generation, "chain runs", second);
+    check(ch->descriptors == (generation * CHAIN_LENGTH),
+          "descriptors executed", second);
+    check(0u == ch->faults, "NULL descriptor fetched", second);
+    check(0u == ch->runaways, "endless chain", second);
+    check(0u == ch->lost_triggers, "trigger lost", second);
+    check(!ch->enabled, "channel left enabled", second);
+    check(0u == BACKUP_RTC_RW, "read bit left set", second);
+    check(stats.triggers == generation, "triggers", second);
+    check(stats.skipped == skipped, "skipped seconds", second);
+    check(rtc_mirror_read(&sample), "mirror read", second);
+    check(sample.generation == generation, "mirror generation", second);
+    check((sample.rtc_time == pdl_shim_backup.counter_time) &&
+          (sample.rtc_date == pdl_shim_backup.counter_date),
+          "mirror registers", second);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Builds the chain and runs the RTC second interrupt's trigger for a few
+*  seconds, then with the RTC busy, and twice before the DataWire ran.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int : 0 if all checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+    rtc_mirror_sample_t sample;
+    uint32_t generation = 0u;
+    uint32_t skipped = 0u;
+    uint32_t second = 0u;
+
+    check(rtc_mirror_init(), "init", second);
+    check(!DW0->channel[RTC_MIRROR_CHANNEL].enabled, "enabled by init",
+          second);
+    check(!rtc_mirror_read(&sample), "mirror read before a copy", second);
+
+    for (second = 1u; second <= SECONDS; second++)
+    {
+        pdl_shim_backup.counter_time = 0x00120000u + second;
+        pdl_shim_backup.counter_date = 0x00241027u;
+        rtc_mirror_trigger();
+        pdl_shim_dw_run(DW0);
+        check_second(second, ++generation, skipped);
+    }
+
+    /* A write transfer of the RTC skips the second */
+    pdl_shim_backup.busy = true;
+    rtc_mirror_trigger();
+    pdl_shim_dw_run(DW0);
+    pdl_shim_backup.busy = false;
+    check_second(second++, generation, ++skipped);
+
+    /* The DataWire has not run the previous chain yet */
+    rtc_mirror_trigger();
+    rtc_mirror_trigger();
+    pdl_shim_dw_run(DW0);
+    check_second(second++, ++generation, ++skipped);
+
+    /* And the next second starts a chain again */
+    pdl_shim_backup.counter_time++;
+    rtc_mirror_trigger();
+    pdl_shim_dw_run(DW0);
+    check_second(second, ++generation, skipped);
+
+    fprintf(stderr, "RTC mirror chain: %s\n", (0u == errors) ? "PASS" : "FAIL");
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/* [] END OF FILE */
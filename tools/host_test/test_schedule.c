@@ -0,0 +1,553 @@
+/******************************************************************************
+* File Name:   test_schedule.c
+*
+* Description: Host test of the schedule table dispatcher in virtual time, on
+*              the TCPWM counter and interrupt models of the PDL shim: a
+*              compare set after the counter passed it, slots missed when the
+*              RTC second is shorter than the table, and overrun accounting.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "schedule.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Counter ticks of a nominal RTC second */
+#define SECOND_TICKS (SCHEDULE_TIMER_HZ)
+
+/* Ticks of one counter register access, and of a task that fits its budget */
+#define ACCESS_TICKS (2u)
+#define TASK_TICKS (10u)
+
+/* Longest start delay of a slot reached on time, and error of a second
+   measured by the counter */
+#define JITTER_LIMIT (20u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Statistics at the start of a scenario, to check what it added */
+typedef struct
+{
+    schedule_stats_t stats;
+    schedule_slot_stats_t slot[SCHEDULE_TABLE_SIZE];
+    uint32_t sw_sets;
+} snapshot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const schedule_entry_t *table;
+static uint32_t table_size;
+/* Ticks each task runs for, and for its next run only if not 0 */
+static uint32_t task_ticks[SCHEDULE_TASK_COUNT];
+static uint32_t next_run_ticks[SCHEDULE_TASK_COUNT];
+/* Virtual time of the last RTC second edge */
+static uint64_t second_edge;
+static uint32_t errors;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void run_task(uint32_t task);
+static void task_10ms(void);
+static void task_100ms(void);
+static void task_1s(void);
+static void run_seconds(uint32_t count, uint32_t ticks, uint32_t first_ticks);
+static void take_snapshot(snapshot_t *snapshot);
+static void check(bool condition, const char *scenario, const char *what);
+static uint32_t find_slot(uint32_t offset_us);
+static void test_nominal(void);
+static void test_late_compare(void);
+static void test_short_second(void);
+static void test_overruns(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: run_task
+********************************************************************************
+* Summary:
+*  Body of the test tasks: lets the virtual time of the run pass.
+*
+* Parameters:
+*  uint32_t task : SCHEDULE_TASK_* task
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_task(uint32_t task)
+{
+    uint32_t ticks = (0u != next_run_ticks[task]) ? next_run_ticks[task] :
+                                                    task_ticks[task];
+
+    next_run_ticks[task] = 0u;
+    pdl_shim_advance(ticks);
+}
+
+/*******************************************************************************
+* Function Name: task_10ms
+********************************************************************************
+* Summary:
+*  10 ms task of the table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void task_10ms(void)
+{
+    run_task(SCHEDULE_TASK_10MS);
+}
+
+/*******************************************************************************
+* Function Name: task_100ms
+********************************************************************************
+* Summary:
+*  100 ms task of the table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void task_100ms(void)
+{
+    run_task(SCHEDULE_TASK_100MS);
+}
+
+/*******************************************************************************
+* Function Name: task_1s
+********************************************************************************
+* Summary:
+*  1 s task of the table.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void task_1s(void)
+{
+    run_task(SCHEDULE_TASK_1S);
+}
+
+/*******************************************************************************
+* Function Name: run_seconds
+********************************************************************************
+* Summary:
+*  Runs RTC seconds of the given length; each ends with the RTC second
+*  interrupt, which calls schedule_align().
+*
+* Parameters:
+*  uint32_t count       : Seconds
+*  uint32_t ticks       : Counter ticks of one RTC second
+*  uint32_t first_ticks : Ticks of the 10 ms task in slot 0 after each edge,
+*                         0 for the usual
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_seconds(uint32_t count, uint32_t ticks, uint32_t first_ticks)
+{
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        second_edge += ticks;
+        if (pdl_shim_tcpwm0.elapsed < second_edge)
+        {
+            pdl_shim_advance((uint32_t)(second_edge -
+                                        pdl_shim_tcpwm0.elapsed));
+        }
+        next_run_ticks[SCHEDULE_TASK_10MS] = first_ticks;
+        pdl_shim_run_handler(schedule_align);
+    }
+}
+
+/*******************************************************************************
+* Function Name: take_snapshot
+********************************************************************************
+* Summary:
+*  Copies the schedule statistics and the software interrupt count.
+*
+* Parameters:
+*  snapshot_t *snapshot : Receives the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void take_snapshot(snapshot_t *snapshot)
+{
+    schedule_get_stats(&snapshot->stats);
+    for (uint32_t i = 0u; i < table_size; i++)
+    {
+        schedule_get_slot_stats(i, &snapshot->slot[i]);
+    }
+    snapshot->sw_sets = pdl_shim_tcpwm0.sw_sets;
+}
+
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+*  Counts and reports a failed check.
+*
+* Parameters:
+*  bool condition       : The check
+*  const char *scenario : Scenario name
+*  const char *what     : What was checked
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check(bool condition, const char *scenario, const char *what)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "%s: %s\n", scenario, what);
+        errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: find_slot
+********************************************************************************
+* Summary:
+*  Returns the index of the slot at an offset.
+*
+* Parameters:
+*  uint32_t offset_us : Offset in the second
+*
+* Return:
+*  Slot index, table_size if there is none
+*
+*******************************************************************************/
+static uint32_t find_slot(uint32_t offset_us)
+{
+    uint32_t slot = 0u;
+
+    while ((slot < table_size) && (table[slot].offset_us != offset_us))
+    {
+        slot++;
+    }
+
+    return slot;
+}
+
+/*******************************************************************************
+* Function Name: test_nominal
+********************************************************************************
+* Summary:
+*  Nominal RTC seconds, and seconds slightly longer than the counter's: every
+*  slot runs once per second, close to its offset, and none is missed or
+*  overruns.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_nominal(void)
+{
+    const char *name = "nominal seconds";
+    snapshot_t before;
+    schedule_stats_t after;
+    bool once = true;
+    bool on_time = true;
+
+    take_snapshot(&before);
+    run_seconds(3u, SECOND_TICKS, 0u);
+    run_seconds(2u, SECOND_TICKS + (SECOND_TICKS / 100u), 0u);
+    schedule_get_stats(&after);
+
+    for (uint32_t i = 0u; i < table_size; i++)
+    {
+        schedule_slot_stats_t slot;
+
+        schedule_get_slot_stats(i, &slot);
+        once = once && ((slot.runs - before.slot[i].runs) == 5u) &&
+               (slot.overruns == before.slot[i].overruns);
+        on_time = on_time && (slot.jitter_max <= JITTER_LIMIT);
+    }
+
+    check(once, name, "every slot runs once per second");
+    check(on_time, name, "start jitter");
+    check(after.seconds == (before.stats.seconds + 5u), name, "alignments");
+    check(after.missed == before.stats.missed, name, "missed slots");
+    check(after.overruns == before.stats.overruns, name, "overruns");
+    check((after.second_ticks >= (SECOND_TICKS + (SECOND_TICKS / 100u) -
+                                  JITTER_LIMIT)) &&
+          (after.second_ticks <= (SECOND_TICKS + (SECOND_TICKS / 100u) +
+                                  JITTER_LIMIT)), name, "second ticks");
+}
+
+/*******************************************************************************
+* Function Name: test_late_compare
+********************************************************************************
+* Summary:
+*  The first 10 ms task overruns until just before or after the offset of
+*  the next slot, one tick more each second. In some seconds the dispatcher
+*  finds the next slot not reached yet, but the counter passes its offset
+*  while the compare is written; arm_next_slot() must then raise the
+*  interrupt by software, or that slot and the rest of the second are lost.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_late_compare(void)
+{
+    const char *name = "late compare";
+    const uint32_t next = find_slot(table[0].offset_us + 2000u);
+    snapshot_t before;
+    schedule_stats_t after;
+    schedule_slot_stats_t first;
+    schedule_slot_stats_t second;
+    uint32_t seconds = 0u;
+
+    take_snapshot(&before);
+    for (uint32_t ticks = 1980u; ticks <= 2010u; ticks++)
+    {
+        run_seconds(1u, SECOND_TICKS, ticks);
+        seconds++;
+    }
+    /* A last second in which slot 0 does not overrun, so that both slots
+       ran as often since the snapshot */
+    run_seconds(1u, SECOND_TICKS, 0u);
+    schedule_get_stats(&after);
+    schedule_get_slot_stats(0u, &first);
+    schedule_get_slot_stats(next, &second);
+
+    check(next < table_size, name, "slot 2 ms after the first");
+    check(after.missed == before.stats.missed, name, "missed slots");
+    check((second.runs - before.slot[next].runs) ==
+          (first.runs - before.slot[0].runs), name, "next slot runs");
+    check((first.overruns - before.slot[0].overruns) == seconds, name,
+          "first slot overruns");
+    check((after.overruns - before.stats.overruns) == seconds, name,
+          "overruns");
+    /* One software compare cause per second arms slot 0 at the alignment;
+       more show that the late compare was hit. A pend of the shared CPU
+       interrupt runs no handler, so none may be used. */
+    check((pdl_shim_tcpwm0.sw_sets - before.sw_sets) > seconds, name,
+          "compare passed while written");
+    check(pdl_shim_nvic.sw_pends == 0u, name, "CPU interrupt pended");
+}
+
+/*******************************************************************************
+* Function Name: test_short_second
+********************************************************************************
+* Summary:
+*  RTC seconds shorter than the table, as from a fast ILO: the slots after
+*  the second edge are not reached and count as missed, and the table
+*  restarts from slot 0 at each edge.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_short_second(void)
+{
+    const char *name = "short second";
+    const uint32_t short_ticks = SECOND_TICKS - (SECOND_TICKS / 66u);
+    const uint32_t half_ticks = SECOND_TICKS / 2u;
+    uint32_t short_missed = 0u;
+    uint32_t half_missed = 0u;
+    snapshot_t before;
+    schedule_stats_t after;
+    schedule_slot_stats_t first;
+
+    for (uint32_t i = 0u; i < table_size; i++)
+    {
+        short_missed += (table[i].offset_us >= short_ticks) ? 1u : 0u;
+        half_missed += (table[i].offset_us >= half_ticks) ? 1u : 0u;
+    }
+
+    take_snapshot(&before);
+    run_seconds(3u, short_ticks, 0u);
+    schedule_get_stats(&after);
+    check(short_missed > 0u, name, "slots after a short second");
+    check((after.missed - before.stats.missed) == (3u * short_missed), name,
+          "missed slots, short second");
+    check((after.second_ticks >= (short_ticks - JITTER_LIMIT)) &&
+          (after.second_ticks <= (short_ticks + JITTER_LIMIT)), name,
+          "second ticks");
+
+    take_snapshot(&before);
+    run_seconds(2u, half_ticks, 0u);
+    schedule_get_stats(&after);
+    schedule_get_slot_stats(0u, &first);
+    check((after.missed - before.stats.missed) == (2u * half_missed), name,
+          "missed slots, half second");
+    check((first.runs - before.slot[0].runs) == 2u, name,
+          "slot 0 runs every second");
+    check(after.overruns == before.stats.overruns, name, "overruns");
+
+    /* Back to nominal seconds, nothing is missed */
+    take_snapshot(&before);
+    run_seconds(2u, SECOND_TICKS, 0u);
+    schedule_get_stats(&after);
+    check(after.missed == before.stats.missed, name, "missed after recovery");
+}
+
+/*******************************************************************************
+* Function Name: test_overruns
+********************************************************************************
+* Summary:
+*  The 100 ms task runs one tick longer than its budget: each of its slots,
+*  and only those, counts one overrun per second, and no slot is missed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_overruns(void)
+{
+    const char *name = "overruns";
+    uint32_t slots_100ms = 0u;
+    bool per_slot = true;
+    snapshot_t before;
+    schedule_stats_t after;
+
+    take_snapshot(&before);
+    for (uint32_t i = 0u; i < table_size; i++)
+    {
+        if (SCHEDULE_TASK_100MS == table[i].task)
+        {
+            task_ticks[SCHEDULE_TASK_100MS] = table[i].budget_us + 1u;
+            slots_100ms++;
+        }
+    }
+    run_seconds(2u, SECOND_TICKS, 0u);
+    task_ticks[SCHEDULE_TASK_100MS] = TASK_TICKS;
+    schedule_get_stats(&after);
+
+    for (uint32_t i = 0u; i < table_size; i++)
+    {
+        schedule_slot_stats_t slot;
+        uint32_t expected = (SCHEDULE_TASK_100MS == table[i].task) ? 2u : 0u;
+
+        schedule_get_slot_stats(i, &slot);
+        per_slot = per_slot &&
+                   ((slot.overruns - before.slot[i].overruns) == expected) &&
+                   ((0u == expected) ||
+                    (slot.duration_max > table[i].budget_us));
+    }
+
+    check(10u == slots_100ms, name, "100 ms slots");
+    check(per_slot, name, "overruns of each slot");
+    check((after.overruns - before.stats.overruns) == (2u * slots_100ms),
+          name, "overruns");
+    check(after.missed == before.stats.missed, name, "missed slots");
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Starts the schedule on the counter model, aligns it to a first RTC second
+*  edge and runs the scenarios in turn; each checks what it added to the
+*  statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int : 0 if all checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+    static const schedule_task_t tasks[SCHEDULE_TASK_COUNT] =
+    {
+        [SCHEDULE_TASK_10MS] = task_10ms,
+        [SCHEDULE_TASK_100MS] = task_100ms,
+        [SCHEDULE_TASK_1S] = task_1s,
+    };
+
+    table = schedule_table_get(&table_size);
+    check(SCHEDULE_TABLE_SIZE == table_size, "table", "size");
+    for (uint32_t i = 0u; i < SCHEDULE_TASK_COUNT; i++)
+    {
+        task_ticks[i] = TASK_TICKS;
+    }
+
+    pdl_shim_tcpwm0.access_ticks = ACCESS_TICKS;
+    check(schedule_start(tasks, 0u), "start", "counter");
+    pdl_shim_run_handler(schedule_align);
+    second_edge = pdl_shim_tcpwm0.elapsed;
+
+    test_nominal();
+    test_late_compare();
+    test_short_second();
+    test_overruns();
+
+    fprintf(stderr, "Schedule table: %s\n", (0u == errors) ? "PASS" : "FAIL");
+
+    return (0u == errors) ? 0 : 1;
+}
+
+/* [] END OF FILE */
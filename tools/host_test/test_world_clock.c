@@ -0,0 +1,394 @@
+/******************************************************************************
+* File Name:   test_world_clock.c
+*
+* Description: Host test of the world clock across the DST transitions of the
+*              local rule. The RTC is modelled second by second, the application
+*              toggles the DST state at the transition as the RTC interrupt does,
+*              and the UTC and head office rows drawn on a model of the terminal
+*              are checked against the C library.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "world_clock.h"
+#include "calendar.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECONDS_PER_HOUR (3600u)
+/* Seconds from 1970-01-01 to 2000-01-01 */
+#define EPOCH_2000 (946684800)
+
+/* Terminal model, large enough for the world clock screen */
+#define SCREEN_ROWS (8u)
+#define SCREEN_COLUMNS (64u)
+
+/* Rows and time column of the world clock zones, see world_clock.c */
+#define ROW_UTC (4u)
+#define ROW_HQ (5u)
+#define TIME_COLUMN (13u)
+#define TIME_LEN (24u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t transition_utc;   /* UTC seconds since 2000 of the transition */
+    bool dst_before;           /* DST state of the RTC before it */
+} crossing_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Local rule of the RTC, the same central European rule as the head office */
+static const cy_stc_rtc_dst_t local_rule =
+{
+    .startDst = {CY_RTC_DST_RELATIVE, 2u, 1u, CY_RTC_LAST_WEEK_OF_MONTH,
+                 CY_RTC_SUNDAY, CY_RTC_MARCH},
+    .stopDst = {CY_RTC_DST_RELATIVE, 3u, 1u, CY_RTC_LAST_WEEK_OF_MONTH,
+                CY_RTC_SUNDAY, CY_RTC_OCTOBER},
+};
+
+static char screen[SCREEN_ROWS][SCREEN_COLUMNS];
+static char *output;
+static size_t output_len;
+static size_t output_parsed;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t utc_seconds(uint32_t year, uint32_t month, uint32_t mday,
+                            uint32_t hour);
+static void to_rtc(uint32_t local, cy_stc_rtc_config_t *rtc);
+static void parse_output(void);
+static bool check_row(uint32_t row, uint32_t seconds, const char *zone);
+static bool run_crossing(const crossing_t *crossing);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: utc_seconds
+********************************************************************************
+* Summary:
+*  Seconds since 2000 of a date at a full hour.
+*
+* Parameters:
+*  uint32_t year  : The year value
+*  uint32_t month : The month of the year, 1..12
+*  uint32_t mday  : The day of the month
+*  uint32_t hour  : The hour, 0..23
+*
+* Return:
+*  Seconds since CALENDAR_EPOCH_YEAR
+*
+*******************************************************************************/
+static uint32_t utc_seconds(uint32_t year, uint32_t month, uint32_t mday,
+                            uint32_t hour)
+{
+    calendar_date_time_t date =
+    {
+        .year = year,
+        .month = month,
+        .mday = mday,
+        .hour = hour,
+    };
+
+    return calendar_to_seconds(&date);
+}
+
+/*******************************************************************************
+* Function Name: to_rtc
+********************************************************************************
+* Summary:
+*  Fills an RTC date and time, as Cy_RTC_GetDateAndTime() returns it with
+*  the century 2000, from a local time.
+*
+* Parameters:
+*  uint32_t local           : Local time, seconds since 2000
+*  cy_stc_rtc_config_t *rtc : Receives the RTC date and time
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void to_rtc(uint32_t local, cy_stc_rtc_config_t *rtc)
+{
+    calendar_date_time_t date;
+
+    calendar_from_seconds(local, &date);
+    memset(rtc, 0, sizeof(*rtc));
+    rtc->sec = date.sec;
+    rtc->min = date.min;
+    rtc->hour = date.hour;
+    rtc->hrFormat = CY_RTC_24_HOURS;
+    rtc->dayOfWeek = Cy_RTC_ConvertDayOfWeek(date.mday, date.month,
+                                             date.year);
+    rtc->date = date.mday;
+    rtc->month = date.month;
+    rtc->year = date.year - 2000u;
+}
+
+/*******************************************************************************
+* Function Name: parse_output
+********************************************************************************
+* Summary:
+*  Applies the output written since the last call to the terminal model. The
+*  world clock only uses the clear screen, the cursor position and CR LF.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void parse_output(void)
+{
+    static uint32_t row = 1u;
+    static uint32_t column = 1u;
+
+    fflush(stdout);
+    while (output_parsed < output_len)
+    {
+        char c = output[output_parsed++];
+
+        if ('\x1b' == c)
+        {
+            char *end;
+            uint32_t new_row = (uint32_t)strtoul(&output[output_parsed + 1u],
+                                                 &end, 10);
+
+            if ('J' == end[0])
+            {
+                memset(screen, ' ', sizeof(screen));
+                end++;
+            }
+            else
+            {
+                uint32_t new_column = 1u;
+
+                if (';' == end[0])
+                {
+                    new_column = (uint32_t)strtoul(&end[1], &end, 10);
+                }
+                row = (0u == new_row) ? 1u : new_row;
+                column = (0u == new_column) ? 1u : new_column;
+                end++;
+            }
+            output_parsed = (size_t)(end - output);
+        }
+        else if ('\r' == c)
+        {
+            column = 1u;
+        }
+        else if ('\n' == c)
+        {
+            row++;
+        }
+        else if ((row <= SCREEN_ROWS) && (column <= SCREEN_COLUMNS))
+        {
+            screen[row - 1u][column - 1u] = c;
+            column++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: check_row
+********************************************************************************
+* Summary:
+*  Compares the time of a zone row of the terminal model with the C library
+*  formatting of the expected time.
+*
+* Parameters:
+*  uint32_t row     : Terminal row of the zone
+*  uint32_t seconds : Expected zone time, seconds since 2000
+*  const char *zone : Zone name for the failure message
+*
+* Return:
+*  bool : true if the row shows the expected time
+*
+*******************************************************************************/
+static bool check_row(uint32_t row, uint32_t seconds, const char *zone)
+{
+    time_t posix = (time_t)seconds + EPOCH_2000;
+    char expected[TIME_LEN + 1u];
+    const char *shown = &screen[row - 1u][TIME_COLUMN];
+    struct tm date;
+
+    gmtime_r(&posix, &date);
+    strftime(expected, sizeof(expected), "%a %b %e %H:%M:%S %Y", &date);
+
+    if (0 != memcmp(shown, expected, TIME_LEN))
+    {
+        fprintf(stderr, "%s shows \"%.*s\", expected \"%s\"\n", zone,
+                (int)TIME_LEN, shown, expected);
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: run_crossing
+********************************************************************************
+* Summary:
+*  Runs the RTC second by second from two hours before to two hours after a
+*  DST transition of the local rule. At the transition the local time jumps
+*  as the PDL DST interrupt moves it, and the DST state is toggled and the
+*  world clock invalidated, as the RTC interrupt of the application does.
+*  Every second, UTC found from the local time, the local UTC offset and the
+*  UTC and head office rows are checked.
+*
+* Parameters:
+*  const crossing_t *crossing : The transition
+*
+* Return:
+*  bool : true if every second is correct
+*
+*******************************************************************************/
+static bool run_crossing(const crossing_t *crossing)
+{
+    const int32_t std_offset = WORLD_CLOCK_LOCAL_UTC_OFFSET_MIN * 60;
+    uint32_t first = crossing->transition_utc - (2u * SECONDS_PER_HOUR);
+    uint32_t last = crossing->transition_utc + (2u * SECONDS_PER_HOUR);
+    bool dst_active = crossing->dst_before;
+    uint32_t errors = 0u;
+
+    world_clock_set_local_dst_active(dst_active);
+    world_clock_set_local_dst(&local_rule);
+    world_clock_start();
+
+    for (uint32_t utc = first; (utc < last) && (errors < 10u); utc++)
+    {
+        cy_stc_rtc_config_t rtc;
+        int32_t offset;
+        uint32_t local;
+
+        if (utc == crossing->transition_utc)
+        {
+            dst_active = !dst_active;
+            world_clock_set_local_dst_active(dst_active);
+            world_clock_invalidate();
+        }
+
+        offset = std_offset + (dst_active ? (int32_t)SECONDS_PER_HOUR : 0);
+        local = utc + (uint32_t)offset;
+
+        if (world_clock_local_to_utc(local) != utc)
+        {
+            fprintf(stderr, "%s: UTC %" PRIu32 " from local %" PRIu32
+                    " is %" PRIu32 "\n", crossing->name, utc, local,
+                    world_clock_local_to_utc(local));
+            errors++;
+        }
+
+        if (world_clock_local_utc_offset(utc) != offset)
+        {
+            fprintf(stderr, "%s: offset at %" PRIu32 " is %" PRId32
+                    ", expected %" PRId32 "\n", crossing->name, utc,
+                    world_clock_local_utc_offset(utc), offset);
+            errors++;
+        }
+
+        to_rtc(local, &rtc);
+        world_clock_refresh(&rtc, 2000u);
+        parse_output();
+        errors += check_row(ROW_UTC, utc, "UTC") ? 0u : 1u;
+        errors += check_row(ROW_HQ,
+                            utc + (uint32_t)(WORLD_CLOCK_HQ_UTC_OFFSET_MIN *
+                                             60) +
+                            (dst_active ? SECONDS_PER_HOUR : 0u),
+                            WORLD_CLOCK_HQ_NAME) ? 0u : 1u;
+    }
+
+    fprintf(stderr, "%s: %s\n", crossing->name,
+            (0u == errors) ? "PASS" : "FAIL");
+
+    return (0u == errors);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the world clock across the 2024 DST start and stop of the local rule,
+*  the last Sundays of March and October. The screen output is captured in
+*  memory for the terminal model.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int : 0 if all checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+    const crossing_t crossings[] =
+    {
+        {"DST start 2024-03-31", utc_seconds(2024u, 3u, 31u, 1u), false},
+        {"DST stop 2024-10-27", utc_seconds(2024u, 10u, 27u, 1u), true},
+    };
+    bool passed = true;
+
+    stdout = open_memstream(&output, &output_len);
+    if (NULL == stdout)
+    {
+        return 1;
+    }
+
+    for (uint32_t i = 0u; i < (sizeof(crossings) / sizeof(crossings[0])); i++)
+    {
+        passed = run_crossing(&crossings[i]) && passed;
+    }
+
+    return passed ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,775 @@
+/******************************************************************************
+* File Name:   log_merge.c
+*
+* Description: Host tool that merges timestamped log exports of many devices
+*              and cores into one globally ordered log, correcting each
+*              device clock with the offset and drift learned from sync
+*              sessions.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Usage
+********************************************************************************
+*  cc -O2 -o log_merge tools/log_merge.c
+*  log_merge [-s sync.txt] [-o merged.log] unit001.core0.log unit001.core1.log
+*
+*  Each input line starts with a decimal timestamp in microseconds, as read
+*  from rtc_timebase_now_us(), followed by a space; each input is sorted by
+*  it. Lines that do not start with a timestamp stay with the line before.
+*  A line whose timestamp is over INT64_MAX is rejected and counted.
+*  The device of an input is its file name up to the first '.', so the cores
+*  of one unit share a clock correction.
+*
+*  The sync file has one "device local_us reference_us" sample per line. For
+*  each device, a least-squares line through its samples maps local time to
+*  reference time; one sample gives an offset only. Devices without samples
+*  are not corrected.
+*
+*  Output lines are "<corrected_us> <input name> <rest of the line>". The
+*  throughput is printed on stderr.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Output is written in blocks of this size */
+#define OUTPUT_BUFFER_SIZE (1u << 20)
+
+/* Consumed input is dropped from the page cache mapping in steps of this
+   size, so the resident memory stays bounded however large the inputs are */
+#define RELEASE_STEP (8u << 20)
+
+#define NAME_SIZE (64u)
+#define LINE_SIZE (256u)
+/* Digits of a printed key, INT64_MIN with its sign */
+#define MAX_DIGITS (20u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Maps local device time to reference time: reference = ref_mean +
+   slope * (local - local_mean) */
+typedef struct
+{
+    char name[NAME_SIZE];
+    uint32_t samples;
+    double sum_local;       /* Sums relative to the first sample */
+    double sum_ref;
+    double sum_local_sq;
+    double sum_cross;
+    int64_t local_base;
+    int64_t ref_base;
+    int64_t local_mean;
+    int64_t ref_mean;
+    double slope;
+} device_clock_t;
+
+typedef struct
+{
+    const char *data;       /* Mapped file */
+    size_t size;
+    size_t pos;             /* Start of the next line */
+    size_t released;        /* Bytes returned to the kernel */
+    const char *line;       /* Current line, without the timestamp */
+    size_t line_len;
+    int64_t key;            /* Corrected timestamp of the current line */
+    char name[NAME_SIZE];
+    size_t name_len;
+    const device_clock_t *clock;
+} merge_input_t;
+
+typedef struct
+{
+    int fd;
+    char *data;
+    size_t used;
+    uint64_t written;
+} output_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static device_clock_t *devices;
+static uint32_t device_count;
+/* Lines dropped because their timestamp does not fit int64_t */
+static uint64_t rejected_lines;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static device_clock_t *find_device(const char *name, bool create);
+static void load_sync(const char *path);
+static void fit_device(device_clock_t *device);
+static int64_t correct(const device_clock_t *clock, int64_t local);
+static bool open_input(merge_input_t *input, const char *path);
+static bool next_line(merge_input_t *input);
+static void sift_down(merge_input_t **heap, uint32_t count, uint32_t i);
+static void emit(output_t *out, const merge_input_t *input);
+static void flush_output(output_t *out);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Maps all inputs, builds a min-heap of their first lines keyed by the
+*  corrected timestamp and writes the smallest line until all inputs are
+*  exhausted. The heap top is replaced in place, so a run of lines from one
+*  input costs two comparisons per line.
+*
+* Parameters:
+*  int argc    : Argument count
+*  char **argv : Options and input files
+*
+* Return:
+*  0 on success, 1 on an error
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    const char *sync_path = NULL;
+    const char *out_path = NULL;
+    merge_input_t *inputs;
+    merge_input_t **heap;
+    uint32_t count = 0u;
+    uint64_t bytes_in = 0u;
+    uint64_t lines = 0u;
+    struct timespec start;
+    struct timespec end;
+    output_t out;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "s:o:")))
+    {
+        switch (opt)
+        {
+            case 's':
+                sync_path = optarg;
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-s sync] [-o output] input...\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        fprintf(stderr, "%s: no inputs\n", argv[0]);
+        return 1;
+    }
+
+    if (NULL != sync_path)
+    {
+        load_sync(sync_path);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    inputs = calloc((size_t)(argc - optind), sizeof(*inputs));
+    heap = calloc((size_t)(argc - optind), sizeof(*heap));
+    out.data = malloc(OUTPUT_BUFFER_SIZE);
+    if ((NULL == inputs) || (NULL == heap) || (NULL == out.data))
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    out.fd = (NULL == out_path) ? STDOUT_FILENO :
+             open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    out.used = 0u;
+    out.written = 0u;
+    if (out.fd < 0)
+    {
+        fprintf(stderr, "%s: %s: %s\n", argv[0], out_path, strerror(errno));
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++)
+    {
+        merge_input_t *input = &inputs[count];
+
+        if (!open_input(input, argv[i]))
+        {
+            return 1;
+        }
+        bytes_in += input->size;
+        if (next_line(input))
+        {
+            heap[count++] = input;
+        }
+    }
+
+    for (uint32_t i = count / 2u; i-- > 0u;)
+    {
+        sift_down(heap, count, i);
+    }
+
+    while (0u != count)
+    {
+        emit(&out, heap[0]);
+        lines++;
+
+        if (!next_line(heap[0]))
+        {
+            heap[0] = heap[--count];
+        }
+        sift_down(heap, count, 0u);
+    }
+
+    flush_output(&out);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (double)(end.tv_sec - start.tv_sec) +
+                     ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+    fprintf(stderr, "%d inputs, %" PRIu64 " lines, %" PRIu64 " rejected, "
+            "%.3f GB in, %.3f GB out, %.3f s, %.2f GB/s\n", argc - optind,
+            lines, rejected_lines, (double)bytes_in / 1e9,
+            (double)out.written / 1e9, seconds,
+            (seconds > 0.0) ? ((double)bytes_in / 1e9 / seconds) : 0.0);
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: find_device
+********************************************************************************
+* Summary:
+*  Returns the clock correction of a device.
+*
+* Parameters:
+*  const char *name : Device name
+*  bool create      : Adds the device if it is not known
+*
+* Return:
+*  Device clock, or NULL if not known and not created
+*
+*******************************************************************************/
+static device_clock_t *find_device(const char *name, bool create)
+{
+    for (uint32_t i = 0u; i < device_count; i++)
+    {
+        if (0 == strcmp(devices[i].name, name))
+        {
+            return &devices[i];
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    device_clock_t *grown = realloc(devices,
+                                    (device_count + 1u) * sizeof(*devices));
+    if (NULL == grown)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    devices = grown;
+
+    device_clock_t *device = &devices[device_count++];
+    memset(device, 0, sizeof(*device));
+    snprintf(device->name, sizeof(device->name), "%s", name);
+    device->slope = 1.0;
+
+    return device;
+}
+
+/*******************************************************************************
+* Function Name: load_sync
+********************************************************************************
+* Summary:
+*  Reads the sync samples and fits the clock correction of each device.
+*
+* Parameters:
+*  const char *path : Sync file, "device local_us reference_us" per line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void load_sync(const char *path)
+{
+    char line[LINE_SIZE];
+    char name[NAME_SIZE];
+    int64_t local;
+    int64_t ref;
+    FILE *file = fopen(path, "r");
+
+    if (NULL == file)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        exit(1);
+    }
+
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        if (('#' == line[0]) ||
+            (3 != sscanf(line, "%63s %" SCNd64 " %" SCNd64, name, &local, &ref)))
+        {
+            continue;
+        }
+
+        device_clock_t *device = find_device(name, true);
+        if (0u == device->samples)
+        {
+            device->local_base = local;
+            device->ref_base = ref;
+        }
+
+        double x = (double)(local - device->local_base);
+        double y = (double)(ref - device->ref_base);
+        device->samples++;
+        device->sum_local += x;
+        device->sum_ref += y;
+        device->sum_local_sq += x * x;
+        device->sum_cross += x * y;
+    }
+
+    fclose(file);
+
+    for (uint32_t i = 0u; i < device_count; i++)
+    {
+        fit_device(&devices[i]);
+        fprintf(stderr, "%s: %u samples, offset %" PRId64 " us, drift %.3f ppm\n",
+                devices[i].name, devices[i].samples,
+                devices[i].ref_mean - devices[i].local_mean,
+                (devices[i].slope - 1.0) * 1e6);
+    }
+}
+
+/*******************************************************************************
+* Function Name: fit_device
+********************************************************************************
+* Summary:
+*  Fits reference = ref_mean + slope * (local - local_mean) by least squares.
+*  The means are kept as integers so that the correction stays exact to the
+*  microsecond far from the samples.
+*
+* Parameters:
+*  device_clock_t *device : Device with at least one sample
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fit_device(device_clock_t *device)
+{
+    double n = (double)device->samples;
+    double mean_x = device->sum_local / n;
+    double mean_y = device->sum_ref / n;
+    double var = device->sum_local_sq - (n * mean_x * mean_x);
+
+    device->slope = 1.0;
+    if ((device->samples > 1u) && (var > 0.0))
+    {
+        device->slope = (device->sum_cross - (n * mean_x * mean_y)) / var;
+    }
+
+    device->local_mean = device->local_base + (int64_t)mean_x;
+    device->ref_mean = device->ref_base + (int64_t)mean_y;
+}
+
+/*******************************************************************************
+* Function Name: correct
+********************************************************************************
+* Summary:
+*  Converts a local device timestamp to reference time.
+*
+* Parameters:
+*  const device_clock_t *clock : Device correction, NULL for none
+*  int64_t local               : Device timestamp in microseconds
+*
+* Return:
+*  Reference timestamp in microseconds
+*
+*******************************************************************************/
+static int64_t correct(const device_clock_t *clock, int64_t local)
+{
+    if (NULL == clock)
+    {
+        return local;
+    }
+
+    int64_t delta = local - clock->local_mean;
+
+    return clock->ref_mean + delta + (int64_t)((double)delta *
+                                               (clock->slope - 1.0));
+}
+
+/*******************************************************************************
+* Function Name: open_input
+********************************************************************************
+* Summary:
+*  Maps an input file read-only and looks up the clock of its device.
+*
+* Parameters:
+*  merge_input_t *input : Input to set up
+*  const char *path     : File to map
+*
+* Return:
+*  true on success
+*
+*******************************************************************************/
+static bool open_input(merge_input_t *input, const char *path)
+{
+    struct stat st;
+    const char *base = strrchr(path, '/');
+    int fd = open(path, O_RDONLY);
+
+    if ((fd < 0) || (0 != fstat(fd, &st)))
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    input->size = (size_t)st.st_size;
+    input->data = NULL;
+    if (0u != input->size)
+    {
+        input->data = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == input->data)
+        {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            close(fd);
+            return false;
+        }
+        (void)madvise((void *)input->data, input->size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    /* "dir/unit001.core0.log" is input unit001.core0 of device unit001 */
+    base = (NULL == base) ? path : (base + 1);
+    snprintf(input->name, sizeof(input->name), "%s", base);
+    char *dot = strrchr(input->name, '.');
+    if ((NULL != dot) && (dot != input->name))
+    {
+        *dot = '\0';
+    }
+
+    char device[NAME_SIZE];
+    snprintf(device, sizeof(device), "%s", input->name);
+    dot = strchr(device, '.');
+    if (NULL != dot)
+    {
+        *dot = '\0';
+    }
+    input->clock = find_device(device, false);
+    input->name_len = strlen(input->name);
+
+    input->pos = 0u;
+    input->released = 0u;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: next_line
+********************************************************************************
+* Summary:
+*  Advances an input to its next line and parses the timestamp. Lines without
+*  a timestamp keep the key of the line before, so they stay attached to it.
+*  Lines with a timestamp over INT64_MAX are skipped and counted in
+*  rejected_lines. Fully consumed parts of the mapping are released in
+*  RELEASE_STEP blocks.
+*
+* Parameters:
+*  merge_input_t *input : Input to advance
+*
+* Return:
+*  false when the input is exhausted
+*
+*******************************************************************************/
+static bool next_line(merge_input_t *input)
+{
+    const char *start;
+    const char *p;
+    const char *eol;
+    uint64_t value;
+    uint32_t digits;
+    bool rejected;
+
+    do
+    {
+        const char *end;
+        bool overflow = false;
+
+        if (input->pos >= input->size)
+        {
+            if (0u != input->size)
+            {
+                (void)munmap((void *)input->data, input->size);
+                input->size = 0u;
+            }
+            return false;
+        }
+
+        if ((input->pos - input->released) >= RELEASE_STEP)
+        {
+            size_t page = (size_t)sysconf(_SC_PAGESIZE);
+            size_t upto = input->pos & ~(page - 1u);
+
+            (void)madvise((void *)(input->data + input->released),
+                          upto - input->released, MADV_DONTNEED);
+            input->released = upto;
+        }
+
+        start = input->data + input->pos;
+        p = start;
+        end = input->data + input->size;
+        eol = memchr(p, '\n', (size_t)(end - p));
+        eol = (NULL == eol) ? end : (eol + 1);
+        input->pos = (size_t)(eol - input->data);
+
+        value = 0u;
+        digits = 0u;
+        while ((p < eol) && (*p >= '0') && (*p <= '9'))
+        {
+            uint64_t digit = (uint64_t)(*p - '0');
+
+            if (value > (((uint64_t)INT64_MAX - digit) / 10u))
+            {
+                overflow = true;
+            }
+            else
+            {
+                value = (value * 10u) + digit;
+            }
+            p++;
+            digits++;
+        }
+
+        rejected = overflow && (p < eol) && (' ' == *p);
+        if (rejected)
+        {
+            rejected_lines++;
+        }
+    } while (rejected);
+
+    if ((0u != digits) && (p < eol) && (' ' == *p))
+    {
+        input->key = correct(input->clock, (int64_t)value);
+        p++;
+    }
+    else
+    {
+        /* Continuation line: copied whole, with the previous key */
+        p = start;
+    }
+
+    input->line = p;
+    input->line_len = (size_t)(eol - p);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: sift_down
+********************************************************************************
+* Summary:
+*  Restores the min-heap order below an entry.
+*
+* Parameters:
+*  merge_input_t **heap : Heap of inputs keyed by their current line
+*  uint32_t count       : Entries in the heap
+*  uint32_t i           : Entry to move down
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sift_down(merge_input_t **heap, uint32_t count, uint32_t i)
+{
+    merge_input_t *entry = heap[i];
+
+    for (;;)
+    {
+        uint32_t child = (2u * i) + 1u;
+
+        if (child >= count)
+        {
+            break;
+        }
+        if (((child + 1u) < count) && (heap[child + 1u]->key < heap[child]->key))
+        {
+            child++;
+        }
+        if (entry->key <= heap[child]->key)
+        {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = entry;
+}
+
+/*******************************************************************************
+* Function Name: emit
+********************************************************************************
+* Summary:
+*  Appends the current line of an input to the output, prefixed with the
+*  corrected timestamp and the input name.
+*
+* Parameters:
+*  output_t *out               : Output buffer
+*  const merge_input_t *input  : Input whose line is written
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void emit(output_t *out, const merge_input_t *input)
+{
+    char digits[MAX_DIGITS + 1u];
+    uint32_t n = 0u;
+    size_t name_len = input->name_len;
+    size_t need = MAX_DIGITS + 3u + name_len + input->line_len;
+    uint64_t value = (input->key < 0) ? (uint64_t)(-input->key) :
+                                        (uint64_t)input->key;
+
+    if ((out->used + need) > OUTPUT_BUFFER_SIZE)
+    {
+        flush_output(out);
+    }
+
+    if (need > OUTPUT_BUFFER_SIZE)
+    {
+        /* A line longer than the buffer is written directly */
+        char prefix[MAX_DIGITS + 3u + NAME_SIZE];
+        int len = snprintf(prefix, sizeof(prefix), "%" PRId64 " %s ",
+                           input->key, input->name);
+        if ((write(out->fd, prefix, (size_t)len) < 0) ||
+            (write(out->fd, input->line, input->line_len) < 0))
+        {
+            perror("write");
+            exit(1);
+        }
+        out->written += (uint64_t)len + input->line_len;
+        return;
+    }
+
+    char *dst = out->data + out->used;
+
+    if (input->key < 0)
+    {
+        *dst++ = '-';
+    }
+    do
+    {
+        digits[n++] = (char)('0' + (value % 10u));
+        value /= 10u;
+    } while (0u != value);
+    while (0u != n)
+    {
+        *dst++ = digits[--n];
+    }
+    *dst++ = ' ';
+    memcpy(dst, input->name, name_len);
+    dst += name_len;
+    *dst++ = ' ';
+    memcpy(dst, input->line, input->line_len);
+    dst += input->line_len;
+
+    /* The last line of a file may have no newline */
+    if ((0u == input->line_len) || ('\n' != input->line[input->line_len - 1u]))
+    {
+        *dst++ = '\n';
+    }
+
+    out->used = (size_t)(dst - out->data);
+}
+
+/*******************************************************************************
+* Function Name: flush_output
+********************************************************************************
+* Summary:
+*  Writes the buffered output.
+*
+* Parameters:
+*  output_t *out : Output buffer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void flush_output(output_t *out)
+{
+    size_t done = 0u;
+
+    while (done < out->used)
+    {
+        ssize_t n = write(out->fd, out->data + done, out->used - done);
+
+        if (n < 0)
+        {
+            perror("write");
+            exit(1);
+        }
+        done += (size_t)n;
+    }
+
+    out->written += out->used;
+    out->used = 0u;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,930 @@
+/******************************************************************************
+* File Name:   bench.c
+*
+* Description: Benchmark suite of the calendar, parsing and formatting hot paths
+*              of main.c, the per-second work of the RTC interrupt, and the
+*              event store. Runs one benchmark for a number of iterations, so
+*              that the instructions per call can be taken from two runs.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cy_pdl.h"
+#include "calendar.h"
+#include "business_calendar.h"
+#include "event_store.h"
+#include "alarm_scheduler.h"
+#include "rtc_ticker.h"
+#include "binary_command.h"
+#include "rtc_timebase.h"
+#include "time_format.h"
+#include "timestamp_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DEFAULT_ITERATIONS (1000u)
+
+/* 2024-01-01 00:00:00 in seconds since 2000, start of the benchmark dates */
+#define START_SECONDS (757382400UL)
+
+/* Working days counted by the business benchmark */
+#define BUSINESS_SPAN_DAYS (90u)
+
+/* Length of the recorded console session, in seconds; replayed in a loop */
+#define SESSION_SECONDS (600u)
+
+/* Stream buffer of the timestamp benchmark, the size of the tick log */
+#define TICK_LOG_BYTES (4096u)
+#define US_PER_SECOND (1000000ULL)
+
+/* Events of the event store benchmarks: starts spread over a week after
+   START_SECONDS, up to two hours long, every fourth one weekly */
+#define EVENT_SPREAD_SECONDS (EVENT_STORE_WEEKLY)
+#define EVENT_MAX_SECONDS (7200u)
+/* Active events returned per query */
+#define EVENT_QUERY_HANDLES (8u)
+
+/* Period of the alarm of the RTC second benchmark, as a minute countdown */
+#define ALARM_PERIOD_SECONDS (60u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*run)(uint32_t iterations);
+} benchmark_t;
+
+/* A line typed on the console, at its second of the session */
+typedef struct
+{
+    uint32_t second;
+    const char *line;
+} session_input_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Results are written here so that the compiler keeps the calls */
+static volatile uint32_t sink;
+/* Monotonic second of the RTC second benchmark */
+static uint32_t rtc_second_now;
+static char text[64];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void bench_day_of_week(uint32_t iterations);
+static void bench_from_seconds(uint32_t iterations);
+static void bench_to_seconds(uint32_t iterations);
+static void bench_validate(uint32_t iterations);
+static void bench_parse_time(uint32_t iterations);
+static void bench_format_c(uint32_t iterations);
+static void bench_format_c_bcd(uint32_t iterations);
+static void bench_render_cache(uint32_t iterations);
+static void bench_strftime(uint32_t iterations);
+static void bench_working_days(uint32_t iterations);
+static void bench_session(uint32_t iterations);
+static void bench_ts_append(uint32_t iterations);
+static void bench_rtc_second(uint32_t iterations);
+static void on_period_alarm(void *context);
+static void bench_event_insert_64(uint32_t iterations);
+static void bench_event_insert_512(uint32_t iterations);
+static void bench_event_insert_2048(uint32_t iterations);
+static void bench_event_query_64(uint32_t iterations);
+static void bench_event_query_512(uint32_t iterations);
+static void bench_event_query_2048(uint32_t iterations);
+static void event_at(uint32_t index, event_t *event);
+static void event_fill(uint32_t count);
+static void event_insert(uint32_t size, uint32_t iterations);
+static void event_query(uint32_t size, uint32_t iterations);
+
+static const benchmark_t benchmarks[] =
+{
+    {"day_of_week", bench_day_of_week},
+    {"from_seconds", bench_from_seconds},
+    {"to_seconds", bench_to_seconds},
+    {"validate", bench_validate},
+    {"parse_time", bench_parse_time},
+    {"format_c", bench_format_c},
+    {"format_c_bcd", bench_format_c_bcd},
+    {"render_cache", bench_render_cache},
+    {"strftime", bench_strftime},
+    {"working_days", bench_working_days},
+    {"session", bench_session},
+    {"ts_append", bench_ts_append},
+    {"rtc_second", bench_rtc_second},
+    {"event_insert_64", bench_event_insert_64},
+    {"event_insert_512", bench_event_insert_512},
+    {"event_insert_2048", bench_event_insert_2048},
+    {"event_query_64", bench_event_query_64},
+    {"event_query_512", bench_event_query_512},
+    {"event_query_2048", bench_event_query_2048},
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs one benchmark. With no argument, lists the benchmarks.
+*
+* Parameters:
+*  argv[1] : Benchmark name
+*  argv[2] : Iterations, DEFAULT_ITERATIONS if omitted; 0 measures the
+*            start-up and exit only
+*
+* Return:
+*  int : 0 on success
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        for (uint32_t i = 0u; i < BENCHMARK_COUNT; i++)
+        {
+            printf("%s\n", benchmarks[i].name);
+        }
+        return 0;
+    }
+
+    uint32_t iterations = (argc > 2) ?
+                          (uint32_t)strtoul(argv[2], NULL, 10) :
+                          DEFAULT_ITERATIONS;
+
+    for (uint32_t i = 0u; i < BENCHMARK_COUNT; i++)
+    {
+        if (0 == strcmp(argv[1], benchmarks[i].name))
+        {
+            benchmarks[i].run(iterations);
+            printf("%s %" PRIu32 " %08" PRIX32 "\n", benchmarks[i].name,
+                   iterations, (uint32_t)sink);
+            return 0;
+        }
+    }
+
+    printf("unknown benchmark %s\n", argv[1]);
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: bench_day_of_week
+********************************************************************************
+* Summary:
+*  calendar_day_of_week() over consecutive dates.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_day_of_week(uint32_t iterations)
+{
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        sink += calendar_day_of_week((i % 28u) + 1u, (i % 12u) + 1u,
+                                     2000u + (i % 100u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_from_seconds
+********************************************************************************
+* Summary:
+*  calendar_from_seconds(), the conversion behind the POSIX time and the
+*  world clock, over times one hour and one second apart.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_from_seconds(uint32_t iterations)
+{
+    calendar_date_time_t date_time;
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        calendar_from_seconds(START_SECONDS + (i * 3601u), &date_time);
+        sink += date_time.mday;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_to_seconds
+********************************************************************************
+* Summary:
+*  calendar_to_seconds() over consecutive dates.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_to_seconds(uint32_t iterations)
+{
+    calendar_date_time_t date_time = {2024u, 1u, 1u, 12u, 30u, 15u, 2u};
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        date_time.mday = (i % 28u) + 1u;
+        date_time.month = (i % 12u) + 1u;
+        sink += calendar_to_seconds(&date_time);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_validate
+********************************************************************************
+* Summary:
+*  calendar_validate_date_time(), as the set-time command checks its input.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_validate(uint32_t iterations)
+{
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        sink += calendar_validate_date_time(i % 60u, i % 60u, i % 24u,
+                                            (i % 31u) + 1u, (i % 12u) + 1u,
+                                            2000u + (i % 100u)) ? 1u : 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_parse_time
+********************************************************************************
+* Summary:
+*  The parsing of the set-time command: sscanf() of "HH MM SS dd mm yyyy",
+*  as in set_new_time(), then the validation.
+*
+* Parameters:
+*  uint32_t iterations : Lines to parse
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_parse_time(uint32_t iterations)
+{
+    static const char *const lines[] =
+    {
+        "12 30 15 29 02 2024",
+        "23 59 59 31 12 2099",
+        "00 00 00 01 01 2000",
+        "07 45 30 15 06 2031",
+    };
+    uint32_t hour, min, sec, mday, month, year;
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        sscanf(lines[i % 4u], "%" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32
+               " %" PRIu32 " %" PRIu32 "", &hour, &min, &sec, &mday, &month,
+               &year);
+        sink += calendar_validate_date_time(sec, min, hour, mday, month,
+                                            year) ? year : 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_format_c
+********************************************************************************
+* Summary:
+*  time_format_c(), the "%c" text of the clock display.
+*
+* Parameters:
+*  uint32_t iterations : Lines to format
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_format_c(uint32_t iterations)
+{
+    calendar_date_time_t date_time;
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        calendar_from_seconds(START_SECONDS + (i * 3601u), &date_time);
+        time_format_c(text, &date_time);
+        sink += (uint8_t)text[TIME_FORMAT_C_SEC_OFFSET + 1u];
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_format_c_bcd
+********************************************************************************
+* Summary:
+*  time_format_c_bcd(), the "%c" text straight from the RTC registers.
+*
+* Parameters:
+*  uint32_t iterations : Lines to format
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_format_c_bcd(uint32_t iterations)
+{
+    /* 12:30:15, Thursday 29.02.24 */
+    uint32_t rtc_time = 0x05123015UL;
+    uint32_t rtc_date = 0x00240229UL;
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        time_format_c_bcd(text, rtc_time ^ (i & 0x7u), rtc_date, 2000u);
+        sink += (uint8_t)text[TIME_FORMAT_C_SEC_OFFSET + 1u];
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_render_cache
+********************************************************************************
+* Summary:
+*  time_format_cache_render() on consecutive seconds, as the display
+*  renders the clock line.
+*
+* Parameters:
+*  uint32_t iterations : Seconds to render
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_render_cache(uint32_t iterations)
+{
+    static time_format_cache_t cache;
+    calendar_date_time_t date_time;
+
+    time_format_cache_invalidate(&cache);
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        calendar_from_seconds(START_SECONDS + i, &date_time);
+        sink += time_format_cache_render(&cache, &date_time) ? 1u : 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_strftime
+********************************************************************************
+* Summary:
+*  strftime("%c") of a struct tm, the display path before the calendar
+*  ticker and the render cache.
+*
+* Parameters:
+*  uint32_t iterations : Lines to format
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_strftime(uint32_t iterations)
+{
+    struct tm tm_time;
+
+    memset(&tm_time, 0, sizeof(tm_time));
+    tm_time.tm_year = 124;
+    tm_time.tm_mday = 1;
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        tm_time.tm_sec = (int)(i % 60u);
+        tm_time.tm_mon = (int)(i % 12u);
+        tm_time.tm_wday = (int)(i % 7u);
+        sink += (uint32_t)strftime(text, sizeof(text), "%c", &tm_time);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_working_days
+********************************************************************************
+* Summary:
+*  business_calendar_working_days_between() over a quarter.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_working_days(uint32_t iterations)
+{
+    uint32_t first = calendar_days_from_epoch(1u, 1u, 2024u);
+
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        uint32_t day = first + (i % 365u);
+        sink += business_calendar_working_days_between(
+                    day, day + BUSINESS_SPAN_DAYS);
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_session
+********************************************************************************
+* Summary:
+*  Replays a recorded console session in virtual time: each iteration is one
+*  second, in which the clock line is rendered, and the set-time lines typed
+*  in the session are parsed, validated and applied at their second. This is
+*  the mix of the super-loop, and the workload of the profile-guided build.
+*
+* Parameters:
+*  uint32_t iterations : Seconds to replay
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_session(uint32_t iterations)
+{
+    /* Sorted by second; invalid lines are rejected as by set_new_time() */
+    static const session_input_t inputs[] =
+    {
+        {12u, "12 30 15 29 02 2024"},
+        {95u, "23 59 50 31 12 2024"},
+        {140u, "25 00 00 01 01 2025"},
+        {141u, "01 00 00 01 01 2025"},
+        {300u, "02 59 55 30 03 2025"},
+        {480u, "00 00 00 29 02 2025"},
+        {481u, "00 00 00 28 02 2025"},
+    };
+    static time_format_cache_t cache;
+    calendar_date_time_t date_time;
+    uint32_t now = START_SECONDS;
+    uint32_t next = 0u;
+    uint32_t hour, min, sec, mday, month, year;
+
+    time_format_cache_invalidate(&cache);
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        uint32_t second = i % SESSION_SECONDS;
+
+        if (0u == second)
+        {
+            next = 0u;
+        }
+        while ((next < (sizeof(inputs) / sizeof(inputs[0]))) &&
+               (inputs[next].second == second))
+        {
+            sscanf(inputs[next].line, "%" PRIu32 " %" PRIu32 " %" PRIu32
+                   " %" PRIu32 " %" PRIu32 " %" PRIu32 "", &hour, &min, &sec,
+                   &mday, &month, &year);
+            if (calendar_validate_date_time(sec, min, hour, mday, month, year))
+            {
+                calendar_date_time_t set_time =
+                    {year, month, mday, hour, min, sec, 0u};
+                now = calendar_to_seconds(&set_time);
+                time_format_cache_invalidate(&cache);
+            }
+            next++;
+        }
+
+        calendar_from_seconds(now, &date_time);
+        sink += time_format_cache_render(&cache, &date_time) ? 1u : 0u;
+        now++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_ts_append
+********************************************************************************
+* Summary:
+*  timestamp_codec_append() of second ticks in microseconds with a few
+*  microseconds of interrupt latency, as the tick log of main.c appends
+*  them. The stream restarts when the buffer is full.
+*
+* Parameters:
+*  uint32_t iterations : Timestamps to append
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_ts_append(uint32_t iterations)
+{
+    static uint8_t buffer[TICK_LOG_BYTES];
+    static timestamp_codec_t codec;
+    uint64_t second_us = (uint64_t)START_SECONDS * US_PER_SECOND;
+
+    timestamp_codec_init(&codec, buffer, sizeof(buffer));
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        /* Latency of 3 to 9 us, from a small LCG */
+        uint64_t latency = 3u + (((i * 1103515245u) + 12345u) >> 16u) % 7u;
+
+        if (!timestamp_codec_append(&codec, second_us + latency))
+        {
+            sink += codec.used;
+            timestamp_codec_init(&codec, buffer, sizeof(buffer));
+            (void)timestamp_codec_append(&codec, second_us + latency);
+        }
+        second_us += US_PER_SECOND;
+    }
+    sink += codec.count;
+}
+
+/*******************************************************************************
+* Function Name: bench_rtc_second
+********************************************************************************
+* Summary:
+*  The per-second work of the RTC interrupt handler: rtc_ticker_advance() of
+*  the calendar ticker and alarm_scheduler_tick(), with an alarm due once a
+*  minute that schedules itself again, as a running countdown does. The
+*  ticker starts at 23:59:00 on 31.12.2024, so the year carry is included.
+*
+* Parameters:
+*  uint32_t iterations : Seconds to advance
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_rtc_second(uint32_t iterations)
+{
+    cy_stc_rtc_config_t rtc =
+        {0u, 59u, 23u, CY_RTC_AM, CY_RTC_24_HOURS, 3u, 31u, 12u, 24u};
+    struct tm time;
+
+    memset(&time, 0, sizeof(time));
+    time.tm_min = 59;
+    time.tm_hour = 23;
+    time.tm_mday = 31;
+    time.tm_mon = 11;
+    time.tm_year = 124;
+    time.tm_wday = 2;
+    time.tm_yday = 365;
+    rtc_ticker_sync(&rtc, &time, false);
+
+    rtc_second_now = 0u;
+    (void)alarm_scheduler_add(ALARM_PERIOD_SECONDS, on_period_alarm, NULL);
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        rtc_second_now++;
+        rtc_ticker_advance();
+        alarm_scheduler_tick(rtc_second_now);
+    }
+
+    (void)rtc_ticker_read(&rtc, &time);
+    sink += rtc.sec + rtc.min + rtc.date;
+}
+
+/*******************************************************************************
+* Function Name: on_period_alarm
+********************************************************************************
+* Summary:
+*  Alarm of the RTC second benchmark; schedules itself again.
+*
+* Parameters:
+*  void *context : Unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void on_period_alarm(void *context)
+{
+    (void)context;
+    sink++;
+    (void)alarm_scheduler_add(rtc_second_now + ALARM_PERIOD_SECONDS,
+                              on_period_alarm, NULL);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_insert_64
+********************************************************************************
+* Summary:
+*  event_insert() with 64 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_insert_64(uint32_t iterations)
+{
+    event_insert(64u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_insert_512
+********************************************************************************
+* Summary:
+*  event_insert() with 512 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_insert_512(uint32_t iterations)
+{
+    event_insert(512u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_insert_2048
+********************************************************************************
+* Summary:
+*  event_insert() with 2048 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_insert_2048(uint32_t iterations)
+{
+    event_insert(2048u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_query_64
+********************************************************************************
+* Summary:
+*  event_query() with 64 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_query_64(uint32_t iterations)
+{
+    event_query(64u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_query_512
+********************************************************************************
+* Summary:
+*  event_query() with 512 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_query_512(uint32_t iterations)
+{
+    event_query(512u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: bench_event_query_2048
+********************************************************************************
+* Summary:
+*  event_query() with 2048 events in the store.
+*
+* Parameters:
+*  uint32_t iterations : Calls to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_query_2048(uint32_t iterations)
+{
+    event_query(2048u, iterations);
+}
+
+/*******************************************************************************
+* Function Name: event_at
+********************************************************************************
+* Summary:
+*  Returns the event of an index of the benchmark set, from a small LCG.
+*
+* Parameters:
+*  uint32_t index : Index of the event
+*  event_t *event : Receives the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void event_at(uint32_t index, event_t *event)
+{
+    uint32_t random = (index * 1103515245u) + 12345u;
+
+    event->start = START_SECONDS + ((random >> 8u) % EVENT_SPREAD_SECONDS);
+    event->end = event->start + ((random >> 4u) % EVENT_MAX_SECONDS);
+    event->period = (0u == (index % 4u)) ? EVENT_STORE_WEEKLY :
+                                          EVENT_STORE_ONCE;
+}
+
+/*******************************************************************************
+* Function Name: event_fill
+********************************************************************************
+* Summary:
+*  Empties the event store and inserts the first events of the benchmark
+*  set. The same for any iterations, so its cost cancels out of the per-call
+*  count.
+*
+* Parameters:
+*  uint32_t count : Events to insert
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void event_fill(uint32_t count)
+{
+    event_t event;
+
+    event_store_init(NULL);
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        event_at(i, &event);
+        (void)event_store_insert(&event);
+    }
+}
+
+/*******************************************************************************
+* Function Name: event_insert
+********************************************************************************
+* Summary:
+*  event_store_insert() of one more event into a store of size - 1 events,
+*  and event_store_delete() of it, so that the size stays the same.
+*
+* Parameters:
+*  uint32_t size       : Events in the store during the insert
+*  uint32_t iterations : Inserts to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void event_insert(uint32_t size, uint32_t iterations)
+{
+    event_t event;
+
+    event_fill(size - 1u);
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        event_at(size + i, &event);
+        event_handle_t handle = event_store_insert(&event);
+        sink += handle;
+        (void)event_store_delete(handle);
+    }
+    sink += event_store_count();
+}
+
+/*******************************************************************************
+* Function Name: event_query
+********************************************************************************
+* Summary:
+*  event_store_next_after() and event_store_find_active() at times spread
+*  over the week of the events, as the console queries the store.
+*
+* Parameters:
+*  uint32_t size       : Events in the store
+*  uint32_t iterations : Query pairs to make
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void event_query(uint32_t size, uint32_t iterations)
+{
+    event_handle_t handles[EVENT_QUERY_HANDLES];
+    event_t event;
+
+    event_fill(size);
+    for (uint32_t i = 0u; i < iterations; i++)
+    {
+        uint32_t time = START_SECONDS +
+                        (((i * 2654435761UL) >> 8u) % EVENT_SPREAD_SECONDS);
+
+        sink += event_store_next_after(time, &event);
+        sink += event_store_find_active(time, handles, EVENT_QUERY_HANDLES);
+    }
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_seconds
+********************************************************************************
+* Summary:
+*  Time base of the event store in place of rtc_timebase.c: the start of the
+*  benchmark dates, so that the stored events are in the future.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Local RTC seconds since 2000
+*
+*******************************************************************************/
+uint32_t rtc_timebase_seconds(void)
+{
+    return START_SECONDS;
+}
+
+/*******************************************************************************
+* Function Name: rtc_timebase_monotonic_seconds
+********************************************************************************
+* Summary:
+*  Monotonic seconds in place of rtc_timebase.c, the due times of the alarm
+*  scheduler.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  Seconds since the start
+*
+*******************************************************************************/
+uint32_t rtc_timebase_monotonic_seconds(void)
+{
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: binary_command_register
+********************************************************************************
+* Summary:
+*  The event store registers no commands in the benchmarks.
+*
+* Parameters:
+*  uint8_t opcode                   : Unused
+*  binary_command_handler_t handler : Unused
+*
+* Return:
+*  false
+*
+*******************************************************************************/
+bool binary_command_register(uint8_t opcode, binary_command_handler_t handler)
+{
+    (void)opcode;
+    (void)handler;
+
+    return false;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,514 @@
+/******************************************************************************
+* File Name:   cy_pdl.h
+*
+* Description: Minimal PDL subset for the QEMU benchmark build: the RTC types,
+*              constants and register fields used by the calendar and formatting
+*              code, without the device headers. For the host tests, it also
+*              models the RTC registers, a DataWire block, a TCPWM counter
+*              and the interrupts.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_UNUSED_PARAMETER(x) ((void)(x))
+#define CY_ASSERT(x) ((void)0)
+#define CY_ALIGN(align) __attribute__((aligned(align)))
+
+#define _VAL2FLD(field, value) \
+    (((uint32_t)(value) << field##_Pos) & field##_Msk)
+#define _FLD2VAL(field, value) \
+    (((uint32_t)(value) & field##_Msk) >> field##_Pos)
+#define _FLD2BOOL(field, value) (0u != ((value) & field##_Msk))
+
+/* RTC_TIME and RTC_DATE fields, as in the TRAVEO T2G device headers */
+#define BACKUP_RTC_TIME_RTC_SEC_Pos 0u
+#define BACKUP_RTC_TIME_RTC_SEC_Msk 0x0000007FUL
+#define BACKUP_RTC_TIME_RTC_MIN_Pos 8u
+#define BACKUP_RTC_TIME_RTC_MIN_Msk 0x00007F00UL
+#define BACKUP_RTC_TIME_RTC_HOUR_Pos 16u
+#define BACKUP_RTC_TIME_RTC_HOUR_Msk 0x003F0000UL
+#define BACKUP_RTC_TIME_CTRL_12HR_Pos 22u
+#define BACKUP_RTC_TIME_CTRL_12HR_Msk 0x00400000UL
+#define BACKUP_RTC_TIME_RTC_DAY_Pos 24u
+#define BACKUP_RTC_TIME_RTC_DAY_Msk 0x07000000UL
+#define BACKUP_RTC_DATE_RTC_DATE_Pos 0u
+#define BACKUP_RTC_DATE_RTC_DATE_Msk 0x0000003FUL
+#define BACKUP_RTC_DATE_RTC_MON_Pos 8u
+#define BACKUP_RTC_DATE_RTC_MON_Msk 0x00001F00UL
+#define BACKUP_RTC_DATE_RTC_YEAR_Pos 16u
+#define BACKUP_RTC_DATE_RTC_YEAR_Msk 0x00FF0000UL
+
+/* RTC read and write bits of RTC_RW */
+#define BACKUP_RTC_RW_READ_Msk 0x00000001UL
+#define BACKUP_RTC_RW_WRITE_Msk 0x00000002UL
+
+/* RTC registers of the model, see pdl_shim_backup */
+#define BACKUP_RTC_RW (pdl_shim_backup.RTC_RW)
+#define BACKUP_RTC_TIME (pdl_shim_backup.RTC_TIME)
+#define BACKUP_RTC_DATE (pdl_shim_backup.RTC_DATE)
+
+#define CY_RTC_AVAILABLE (0u)
+#define CY_RTC_BUSY (1u)
+
+#define CY_RTC_SUNDAY (1u)
+#define CY_RTC_SATURDAY (7u)
+#define CY_RTC_JANUARY (1u)
+#define CY_RTC_MARCH (3u)
+#define CY_RTC_OCTOBER (10u)
+#define CY_RTC_DECEMBER (12u)
+#define CY_RTC_LAST_WEEK_OF_MONTH (6u)
+
+/* DataWire model: block DW0 with PDL_SHIM_DW_CHANNELS channels, driven by
+   software trigger lines that are the channel numbers */
+#define PDL_SHIM_DW_CHANNELS (16u)
+#define CY_DMA_INTR_MASK (0x01UL)
+#define CY_TRIGGER_TWO_CYCLES (2u)
+#define DW0 (&pdl_shim_dw0)
+
+/* Counter model: TCPWM0 with one counter, in ticks of virtual time that
+   pass in pdl_shim_advance() and in each register access */
+#define TCPWM0 (&pdl_shim_tcpwm0)
+#define CY_TCPWM_SUCCESS (0u)
+#define CY_TCPWM_PRESCALER_DIVBY_1 (0u)
+#define CY_TCPWM_COUNTER_CONTINUOUS (0u)
+#define CY_TCPWM_COUNTER_COUNT_UP (0u)
+#define CY_TCPWM_COUNTER_MODE_COMPARE (0u)
+#define CY_TCPWM_INT_ON_TC (1u)
+#define CY_TCPWM_INT_ON_CC0 (2u)
+#define CY_TCPWM_INPUT_LEVEL (3u)
+#define CY_TCPWM_INPUT_0 (0u)
+#define CY_TCPWM_INPUT_1 (1u)
+
+/* Interrupt model: each system interrupt is its own CPU interrupt, all of
+   one priority, so a handler is never preempted */
+#define PDL_SHIM_IRQS (8u)
+
+/* Core cycle counter; it does not count, the benchmarks count instructions */
+#define DWT (&pdl_shim_dwt)
+#define DWT_CTRL_CYCCNTENA_Msk (0x01UL)
+#define CoreDebug (&pdl_shim_core_debug)
+#define CoreDebug_DEMCR_TRCENA_Msk (0x01000000UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    CY_RTC_DST_RELATIVE,
+    CY_RTC_DST_FIXED
+} cy_en_rtc_dst_format_t;
+
+typedef enum
+{
+    CY_RTC_AM,
+    CY_RTC_PM
+} cy_en_rtc_am_pm_t;
+
+typedef enum
+{
+    CY_RTC_24_HOURS,
+    CY_RTC_12_HOURS
+} cy_en_rtc_hours_format_t;
+
+/* RTC date and time and DST rule, as in the PDL */
+typedef struct
+{
+    uint32_t sec;
+    uint32_t min;
+    uint32_t hour;
+    cy_en_rtc_am_pm_t amPm;
+    cy_en_rtc_hours_format_t hrFormat;
+    uint32_t dayOfWeek;
+    uint32_t date;
+    uint32_t month;
+    uint32_t year;
+} cy_stc_rtc_config_t;
+
+typedef struct
+{
+    cy_en_rtc_dst_format_t format;
+    uint32_t hour;
+    uint32_t dayOfMonth;
+    uint32_t weekOfMonth;
+    uint32_t dayOfWeek;
+    uint32_t month;
+} cy_stc_rtc_dst_format_t;
+
+typedef struct
+{
+    cy_stc_rtc_dst_format_t startDst;
+    cy_stc_rtc_dst_format_t stopDst;
+} cy_stc_rtc_dst_t;
+
+typedef enum
+{
+    CY_DMA_RETRIG_IM,
+    CY_DMA_RETRIG_4CYC,
+    CY_DMA_RETRIG_16CYC,
+    CY_DMA_WAIT_FOR_REACT
+} cy_en_dma_retrigger_t;
+
+typedef enum
+{
+    CY_DMA_1ELEMENT,
+    CY_DMA_X_LOOP,
+    CY_DMA_DESCR,
+    CY_DMA_DESCR_CHAIN
+} cy_en_dma_trigger_type_t;
+
+typedef enum
+{
+    CY_DMA_CHANNEL_ENABLED,
+    CY_DMA_CHANNEL_DISABLED
+} cy_en_dma_channel_state_t;
+
+typedef enum
+{
+    CY_DMA_BYTE,
+    CY_DMA_HALFWORD,
+    CY_DMA_WORD
+} cy_en_dma_data_size_t;
+
+typedef enum
+{
+    CY_DMA_TRANSFER_SIZE_DATA,
+    CY_DMA_TRANSFER_SIZE_WORD
+} cy_en_dma_transfer_size_t;
+
+typedef enum
+{
+    CY_DMA_SINGLE_TRANSFER,
+    CY_DMA_1D_TRANSFER,
+    CY_DMA_2D_TRANSFER
+} cy_en_dma_descriptor_type_t;
+
+typedef enum
+{
+    CY_DMA_SUCCESS,
+    CY_DMA_BAD_PARAM
+} cy_en_dma_status_t;
+
+typedef enum
+{
+    CY_TRIGMUX_SUCCESS,
+    CY_TRIGMUX_BAD_PARAM
+} cy_en_trigmux_status_t;
+
+typedef enum
+{
+    NvicMux3_IRQn = 3,
+    NvicMux4_IRQn = 4,
+    tcpwm_0_interrupts_512_IRQn = 512
+} IRQn_Type;
+
+typedef void (*cy_israddress)(void);
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS,
+    CY_SYSINT_BAD_PARAM
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+    uint32_t intrSrc;       /* CPU interrupt << 16 | system interrupt */
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+/* SCB block, only named by the UART interfaces of the firmware headers */
+typedef struct
+{
+    volatile uint32_t CTRL;
+} CySCB_Type;
+
+typedef struct cy_stc_dma_descriptor cy_stc_dma_descriptor_t;
+
+typedef struct
+{
+    cy_en_dma_retrigger_t retrigger;
+    cy_en_dma_trigger_type_t interruptType;
+    cy_en_dma_trigger_type_t triggerOutType;
+    cy_en_dma_channel_state_t channelState;
+    cy_en_dma_trigger_type_t triggerInType;
+    cy_en_dma_data_size_t dataSize;
+    cy_en_dma_transfer_size_t srcTransferSize;
+    cy_en_dma_transfer_size_t dstTransferSize;
+    cy_en_dma_descriptor_type_t descriptorType;
+    void *srcAddress;
+    void *dstAddress;
+    int32_t srcXincrement;
+    int32_t dstXincrement;
+    uint32_t xCount;
+    int32_t srcYincrement;
+    int32_t dstYincrement;
+    uint32_t yCount;
+    cy_stc_dma_descriptor_t *nextDescriptor;
+} cy_stc_dma_descriptor_config_t;
+
+/* The model keeps the configuration instead of the register encoding */
+struct cy_stc_dma_descriptor
+{
+    cy_stc_dma_descriptor_config_t config;
+};
+
+typedef struct
+{
+    cy_stc_dma_descriptor_t *descriptor;
+    bool preemptable;
+    uint32_t priority;
+    bool enable;
+    bool bufferable;
+} cy_stc_dma_channel_config_t;
+
+typedef struct
+{
+    cy_stc_dma_descriptor_t *current;   /* CH_CURR_PTR */
+    bool enabled;
+    bool pending;                       /* Triggered, chain not run yet */
+    uint32_t intr;                      /* INTR, CY_DMA_INTR_MASK */
+    uint32_t chains;                    /* Chains run to their end */
+    uint32_t descriptors;               /* Descriptors executed */
+    uint32_t lost_triggers;             /* Triggers of a disabled channel */
+    uint32_t faults;                    /* Fetches of a NULL descriptor */
+    uint32_t runaways;                  /* Chains stopped by the model */
+} pdl_shim_dw_channel_t;
+
+typedef struct
+{
+    bool enabled;
+    pdl_shim_dw_channel_t channel[PDL_SHIM_DW_CHANNELS];
+} DW_Type;
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t clockPrescaler;
+    uint32_t runMode;
+    uint32_t countDirection;
+    uint32_t compareOrCapture;
+    uint32_t compare0;
+    uint32_t compare1;
+    bool enableCompareSwap;
+    uint32_t interruptSources;
+    uint32_t captureInputMode;
+    uint32_t captureInput;
+    uint32_t reloadInputMode;
+    uint32_t reloadInput;
+    uint32_t startInputMode;
+    uint32_t startInput;
+    uint32_t stopInputMode;
+    uint32_t stopInput;
+    uint32_t countInputMode;
+    uint32_t countInput;
+} cy_stc_tcpwm_counter_config_t;
+
+typedef struct
+{
+    uint32_t cnt_num;       /* Counter of the model, tcpwm_0_interrupts_N */
+    uint32_t counter;
+    uint32_t period;
+    uint32_t compare0;
+    uint32_t intr;
+    uint32_t intr_mask;
+    bool enabled;
+    bool running;
+    uint32_t access_ticks;  /* Virtual ticks one register access takes */
+    uint64_t elapsed;       /* Virtual ticks since the start of the test */
+    uint32_t sw_sets;       /* Cy_TCPWM_SetInterrupt() calls */
+} TCPWM_Type;
+
+typedef struct
+{
+    IRQn_Type irqn;
+    cy_israddress handler;
+    bool enabled;
+    bool pending;
+} pdl_shim_irq_t;
+
+typedef struct
+{
+    pdl_shim_irq_t irq[PDL_SHIM_IRQS];
+    uint32_t count;
+    bool in_handler;
+    uint32_t sw_pends;      /* NVIC_SetPendingIRQ() calls */
+} pdl_shim_nvic_t;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+    volatile uint32_t LAR;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* RTC_RW, RTC_TIME and RTC_DATE, and the counters the RTC copies to the
+   last two when the read bit is set */
+typedef struct
+{
+    uint32_t RTC_RW;
+    uint32_t RTC_TIME;
+    uint32_t RTC_DATE;
+    uint32_t counter_time;
+    uint32_t counter_date;
+    bool busy;                          /* Write transfer in progress */
+} pdl_shim_backup_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern DW_Type pdl_shim_dw0;
+extern TCPWM_Type pdl_shim_tcpwm0;
+extern pdl_shim_nvic_t pdl_shim_nvic;
+extern pdl_shim_backup_t pdl_shim_backup;
+extern DWT_Type pdl_shim_dwt;
+extern CoreDebug_Type pdl_shim_core_debug;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t Cy_RTC_ConvertDayOfWeek(uint32_t day, uint32_t month, uint32_t year);
+bool Cy_RTC_IsLeapYear(uint32_t year);
+uint32_t Cy_RTC_DaysInMonth(uint32_t month, uint32_t year);
+uint32_t Cy_RTC_GetSyncStatus(void);
+
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(
+    cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_config_t *config);
+cy_en_dma_status_t Cy_DMA_Channel_Init(
+    DW_Type *base, uint32_t channel,
+    const cy_stc_dma_channel_config_t *config);
+void Cy_DMA_Enable(DW_Type *base);
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel,
+                                  const cy_stc_dma_descriptor_t *descriptor);
+uint32_t Cy_DMA_Channel_GetInterruptStatus(const DW_Type *base,
+                                           uint32_t channel);
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel);
+cy_en_trigmux_status_t Cy_TrigMux_SwTrigger(uint32_t trigLine,
+                                            uint32_t cycles);
+void pdl_shim_dw_run(DW_Type *base);
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config,
+                                     cy_israddress userIsr);
+IRQn_Type Cy_SysInt_GetNvicConnection(IRQn_Type devIntrSrc);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void pdl_shim_run_handler(cy_israddress handler);
+
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum,
+                               const cy_stc_tcpwm_counter_config_t *config);
+void Cy_TCPWM_Counter_Enable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_TriggerStart_Single(TCPWM_Type *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum,
+                                 uint32_t count);
+void Cy_TCPWM_Counter_SetCompare0Val(TCPWM_Type *base, uint32_t cntNum,
+                                     uint32_t compare0);
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum,
+                             uint32_t source);
+void Cy_TCPWM_SetInterrupt(TCPWM_Type *base, uint32_t cntNum,
+                           uint32_t source);
+void pdl_shim_advance(uint32_t ticks);
+
+/* CMSIS intrinsics; the single instructions on the Cortex-M7 */
+static inline uint32_t __CLZ(uint32_t value)
+{
+    return (0u == value) ? 32u : (uint32_t)__builtin_clz(value);
+}
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+#if defined(__ARM_ARCH_7EM__)
+    uint32_t result;
+    __asm volatile ("rbit %0, %1" : "=r" (result) : "r" (value));
+    return result;
+#else
+    uint32_t result = 0u;
+    for (uint32_t i = 0u; i < 32u; i++)
+    {
+        result = (result << 1u) | ((value >> i) & 1u);
+    }
+    return result;
+#endif
+}
+
+/* Barriers; the model runs the DataWire from the same thread */
+static inline void __DSB(void)
+{
+    __sync_synchronize();
+}
+
+static inline void __DMB(void)
+{
+    __sync_synchronize();
+}
+
+/* Single core, no interrupts: the critical sections are empty */
+static inline uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return 0u;
+}
+
+static inline void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    CY_UNUSED_PARAMETER(savedIntrStatus);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,1008 @@
+/******************************************************************************
+* File Name:   pdl_shim.c
+*
+* Description: RTC calendar functions of the PDL for the QEMU benchmark
+*              build. They return the same results as the PDL, with days
+*              of the week counted from CY_RTC_SUNDAY = 1. The host tests
+*              also use its models of the RTC registers and of a DataWire
+*              block, which runs a triggered descriptor chain when the test
+*              calls pdl_shim_dw_run(), and of a TCPWM counter and the
+*              interrupts in virtual time.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Descriptors one trigger may run before the model calls the chain endless */
+#define DW_RUNAWAY_LIMIT (256u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+DW_Type pdl_shim_dw0;
+TCPWM_Type pdl_shim_tcpwm0;
+pdl_shim_nvic_t pdl_shim_nvic;
+pdl_shim_backup_t pdl_shim_backup;
+DWT_Type pdl_shim_dwt;
+CoreDebug_Type pdl_shim_core_debug;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void dw_execute(const cy_stc_dma_descriptor_config_t *config);
+static pdl_shim_irq_t *find_irq(IRQn_Type irqn);
+static void dispatch_pending(void);
+static void tcpwm_tick(uint32_t ticks);
+static void tcpwm_raise(uint32_t raised);
+static void tcpwm_access(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: Cy_RTC_ConvertDayOfWeek
+********************************************************************************
+* Summary:
+*  Returns the day of the week of a date.
+*
+* Parameters:
+*  uint32_t day   : The day of the month
+*  uint32_t month : The month
+*  uint32_t year  : The full year
+*
+* Return:
+*  CY_RTC_SUNDAY (1) .. CY_RTC_SATURDAY (7)
+*
+*******************************************************************************/
+uint32_t Cy_RTC_ConvertDayOfWeek(uint32_t day, uint32_t month, uint32_t year)
+{
+    static const uint8_t month_offset[12] =
+    {
+        0u, 3u, 2u, 5u, 0u, 3u, 5u, 1u, 4u, 6u, 2u, 4u
+    };
+
+    if (month < 3u)
+    {
+        year--;
+    }
+
+    return ((year + (year / 4u) - (year / 100u) + (year / 400u) +
+             month_offset[month - 1u] + day) % 7u) + CY_RTC_SUNDAY;
+}
+
+/*******************************************************************************
+* Function Name: Cy_RTC_IsLeapYear
+********************************************************************************
+* Summary:
+*  Checks whether a year is a leap year.
+*
+* Parameters:
+*  uint32_t year : The full year
+*
+* Return:
+*  bool : true for a leap year
+*
+*******************************************************************************/
+bool Cy_RTC_IsLeapYear(uint32_t year)
+{
+    return ((0u == (year % 4u)) && (0u != (year % 100u))) ||
+           (0u == (year % 400u));
+}
+
+/*******************************************************************************
+* Function Name: Cy_RTC_DaysInMonth
+********************************************************************************
+* Summary:
+*  Returns the number of days of a month.
+*
+* Parameters:
+*  uint32_t month : The month
+*  uint32_t year  : The full year
+*
+* Return:
+*  Days of the month, 28..31
+*
+*******************************************************************************/
+uint32_t Cy_RTC_DaysInMonth(uint32_t month, uint32_t year)
+{
+    static const uint8_t days[12] =
+    {
+        31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u
+    };
+
+    return days[month - 1u] +
+           (((2u == month) && Cy_RTC_IsLeapYear(year)) ? 1u : 0u);
+}
+
+/*******************************************************************************
+* Function Name: Cy_RTC_GetSyncStatus
+********************************************************************************
+* Summary:
+*  Returns whether the RTC model is busy with a write transfer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  CY_RTC_BUSY or CY_RTC_AVAILABLE
+*
+*******************************************************************************/
+uint32_t Cy_RTC_GetSyncStatus(void)
+{
+    return pdl_shim_backup.busy ? CY_RTC_BUSY : CY_RTC_AVAILABLE;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Descriptor_Init
+********************************************************************************
+* Summary:
+*  Stores a descriptor configuration. Only the word-wide single and 1D
+*  transfers the firmware uses are modelled.
+*
+* Parameters:
+*  cy_stc_dma_descriptor_t *descriptor          : Descriptor to initialize
+*  const cy_stc_dma_descriptor_config_t *config : Its configuration
+*
+* Return:
+*  CY_DMA_BAD_PARAM for a configuration the model does not support
+*
+*******************************************************************************/
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(
+    cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_config_t *config)
+{
+    if ((NULL == descriptor) || (NULL == config) ||
+        (CY_DMA_WORD != config->dataSize) ||
+        (CY_DMA_2D_TRANSFER == config->descriptorType) ||
+        ((CY_DMA_1D_TRANSFER == config->descriptorType) &&
+         (0u == config->xCount)))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+
+    descriptor->config = *config;
+
+    return CY_DMA_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_Init
+********************************************************************************
+* Summary:
+*  Sets the current descriptor of a channel, and enables it if requested.
+*
+* Parameters:
+*  DW_Type *base                             : DataWire block
+*  uint32_t channel                          : Channel number
+*  const cy_stc_dma_channel_config_t *config : Channel configuration
+*
+* Return:
+*  CY_DMA_BAD_PARAM for an invalid channel or descriptor
+*
+*******************************************************************************/
+cy_en_dma_status_t Cy_DMA_Channel_Init(
+    DW_Type *base, uint32_t channel,
+    const cy_stc_dma_channel_config_t *config)
+{
+    if ((channel >= PDL_SHIM_DW_CHANNELS) || (NULL == config) ||
+        (NULL == config->descriptor))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+
+    base->channel[channel].current = config->descriptor;
+    base->channel[channel].enabled = config->enable;
+
+    return CY_DMA_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Enable
+********************************************************************************
+* Summary:
+*  Enables a DataWire block.
+*
+* Parameters:
+*  DW_Type *base : DataWire block
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_DMA_Enable(DW_Type *base)
+{
+    base->enabled = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_Enable
+********************************************************************************
+* Summary:
+*  Enables a channel.
+*
+* Parameters:
+*  DW_Type *base    : DataWire block
+*  uint32_t channel : Channel number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].enabled = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_Disable
+********************************************************************************
+* Summary:
+*  Disables a channel.
+*
+* Parameters:
+*  DW_Type *base    : DataWire block
+*  uint32_t channel : Channel number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].enabled = false;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_SetDescriptor
+********************************************************************************
+* Summary:
+*  Sets the current descriptor of a channel. As on the device, this is only
+*  allowed while the channel is disabled; otherwise the model counts a fault.
+*
+* Parameters:
+*  DW_Type *base                             : DataWire block
+*  uint32_t channel                          : Channel number
+*  const cy_stc_dma_descriptor_t *descriptor : First descriptor to run
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel,
+                                  const cy_stc_dma_descriptor_t *descriptor)
+{
+    pdl_shim_dw_channel_t *ch = &base->channel[channel];
+
+    if (ch->enabled)
+    {
+        ch->faults++;
+        return;
+    }
+
+    ch->current = (cy_stc_dma_descriptor_t *)(uintptr_t)descriptor;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_GetInterruptStatus
+********************************************************************************
+* Summary:
+*  Returns the interrupt cause of a channel, set when a descriptor or a chain
+*  completes as its interruptType asks.
+*
+* Parameters:
+*  const DW_Type *base : DataWire block
+*  uint32_t channel    : Channel number
+*
+* Return:
+*  CY_DMA_INTR_MASK if the cause is set, else 0
+*
+*******************************************************************************/
+uint32_t Cy_DMA_Channel_GetInterruptStatus(const DW_Type *base,
+                                           uint32_t channel)
+{
+    return base->channel[channel].intr;
+}
+
+/*******************************************************************************
+* Function Name: Cy_DMA_Channel_ClearInterrupt
+********************************************************************************
+* Summary:
+*  Clears the interrupt cause of a channel.
+*
+* Parameters:
+*  DW_Type *base    : DataWire block
+*  uint32_t channel : Channel number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].intr = 0u;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TrigMux_SwTrigger
+********************************************************************************
+* Summary:
+*  Triggers a channel of DW0; the trigger line is the channel number. The
+*  trigger of a disabled channel is lost. The chain runs in the next
+*  pdl_shim_dw_run().
+*
+* Parameters:
+*  uint32_t trigLine : Channel number
+*  uint32_t cycles   : Trigger length, unused
+*
+* Return:
+*  CY_TRIGMUX_BAD_PARAM for an invalid line
+*
+*******************************************************************************/
+cy_en_trigmux_status_t Cy_TrigMux_SwTrigger(uint32_t trigLine,
+                                            uint32_t cycles)
+{
+    CY_UNUSED_PARAMETER(cycles);
+
+    if (trigLine >= PDL_SHIM_DW_CHANNELS)
+    {
+        return CY_TRIGMUX_BAD_PARAM;
+    }
+
+    pdl_shim_dw_channel_t *ch = &pdl_shim_dw0.channel[trigLine];
+
+    if (pdl_shim_dw0.enabled && ch->enabled)
+    {
+        ch->pending = true;
+    }
+    else
+    {
+        ch->lost_triggers++;
+    }
+
+    return CY_TRIGMUX_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: pdl_shim_dw_run
+********************************************************************************
+* Summary:
+*  Runs the triggered channels of a DataWire block. A channel executes its
+*  current descriptor and moves to the next one. The chain continues while
+*  the descriptors take their trigger from the chain and the channel stays
+*  enabled. A descriptor with CY_DMA_CHANNEL_DISABLED disables the channel.
+*  An enabled channel that reaches a NULL descriptor faults, as the device
+*  would fetch it from address 0. A chain longer than DW_RUNAWAY_LIMIT
+*  descriptors is stopped as endless.
+*
+* Parameters:
+*  DW_Type *base : DataWire block
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pdl_shim_dw_run(DW_Type *base)
+{
+    for (uint32_t i = 0u; i < PDL_SHIM_DW_CHANNELS; i++)
+    {
+        pdl_shim_dw_channel_t *ch = &base->channel[i];
+        uint32_t executed = 0u;
+
+        while (ch->pending && ch->enabled)
+        {
+            if (NULL == ch->current)
+            {
+                ch->faults++;
+                ch->enabled = false;
+                break;
+            }
+
+            if (executed == DW_RUNAWAY_LIMIT)
+            {
+                ch->runaways++;
+                break;
+            }
+
+            const cy_stc_dma_descriptor_config_t *config =
+                &ch->current->config;
+
+            dw_execute(config);
+            executed++;
+            ch->descriptors++;
+            ch->current = config->nextDescriptor;
+
+            if ((CY_DMA_DESCR == config->interruptType) ||
+                ((CY_DMA_DESCR_CHAIN == config->interruptType) &&
+                 (NULL == config->nextDescriptor)))
+            {
+                ch->intr = CY_DMA_INTR_MASK;
+            }
+            if (NULL == config->nextDescriptor)
+            {
+                ch->chains++;
+            }
+            if (CY_DMA_CHANNEL_DISABLED == config->channelState)
+            {
+                ch->enabled = false;
+            }
+            if ((CY_DMA_DESCR_CHAIN != config->triggerInType) ||
+                (NULL == config->nextDescriptor))
+            {
+                break;
+            }
+        }
+
+        ch->pending = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: dw_execute
+********************************************************************************
+* Summary:
+*  Executes the word transfers of one descriptor. A write of the read bit to
+*  RTC_RW copies the RTC counters to RTC_TIME and RTC_DATE, as the RTC does.
+*
+* Parameters:
+*  const cy_stc_dma_descriptor_config_t *config : The descriptor
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dw_execute(const cy_stc_dma_descriptor_config_t *config)
+{
+    volatile uint32_t *src = (volatile uint32_t *)config->srcAddress;
+    volatile uint32_t *dst = (volatile uint32_t *)config->dstAddress;
+    uint32_t count = (CY_DMA_1D_TRANSFER == config->descriptorType) ?
+                     config->xCount : 1u;
+
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        *dst = *src;
+
+        if ((dst == &pdl_shim_backup.RTC_RW) &&
+            (0u != (*dst & BACKUP_RTC_RW_READ_Msk)))
+        {
+            pdl_shim_backup.RTC_TIME = pdl_shim_backup.counter_time;
+            pdl_shim_backup.RTC_DATE = pdl_shim_backup.counter_date;
+        }
+
+        src += config->srcXincrement;
+        dst += config->dstXincrement;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysInt_Init
+********************************************************************************
+* Summary:
+*  Registers the handler of a system interrupt.
+*
+* Parameters:
+*  const cy_stc_sysint_t *config : System interrupt in the low 16 bits
+*  cy_israddress userIsr         : Handler
+*
+* Return:
+*  CY_SYSINT_BAD_PARAM if the model has no free interrupt
+*
+*******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config,
+                                     cy_israddress userIsr)
+{
+    IRQn_Type irqn = (IRQn_Type)(config->intrSrc & 0xFFFFu);
+    pdl_shim_irq_t *irq = find_irq(irqn);
+
+    if (NULL == irq)
+    {
+        if (pdl_shim_nvic.count == PDL_SHIM_IRQS)
+        {
+            return CY_SYSINT_BAD_PARAM;
+        }
+        irq = &pdl_shim_nvic.irq[pdl_shim_nvic.count++];
+        irq->irqn = irqn;
+    }
+    irq->handler = userIsr;
+
+    return CY_SYSINT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysInt_GetNvicConnection
+********************************************************************************
+* Summary:
+*  Returns the CPU interrupt of a system interrupt, the same number in the
+*  model.
+*
+* Parameters:
+*  IRQn_Type devIntrSrc : System interrupt
+*
+* Return:
+*  CPU interrupt
+*
+*******************************************************************************/
+IRQn_Type Cy_SysInt_GetNvicConnection(IRQn_Type devIntrSrc)
+{
+    return devIntrSrc;
+}
+
+/*******************************************************************************
+* Function Name: NVIC_EnableIRQ
+********************************************************************************
+* Summary:
+*  Enables an interrupt; a pending one runs unless a handler is running.
+*
+* Parameters:
+*  IRQn_Type IRQn : Interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    pdl_shim_irq_t *irq = find_irq(IRQn);
+
+    if (NULL != irq)
+    {
+        irq->enabled = true;
+        dispatch_pending();
+    }
+}
+
+/*******************************************************************************
+* Function Name: NVIC_SetPendingIRQ
+********************************************************************************
+* Summary:
+*  Sets a CPU interrupt pending by software, and counts the calls. On the
+*  CM7 the CPU interrupt is shared by system interrupts, and its dispatcher
+*  only runs the handlers of the active ones; with no cause raised, nothing
+*  runs, as in the model.
+*
+* Parameters:
+*  IRQn_Type IRQn : Interrupt
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    CY_UNUSED_PARAMETER(IRQn);
+    pdl_shim_nvic.sw_pends++;
+}
+
+/*******************************************************************************
+* Function Name: pdl_shim_run_handler
+********************************************************************************
+* Summary:
+*  Runs a function as an interrupt handler of the common priority, for an
+*  interrupt the test raises itself (the RTC second), then the interrupts
+*  that became pending meanwhile.
+*
+* Parameters:
+*  cy_israddress handler : The handler
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pdl_shim_run_handler(cy_israddress handler)
+{
+    pdl_shim_nvic.in_handler = true;
+    handler();
+    pdl_shim_nvic.in_handler = false;
+    dispatch_pending();
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_Init
+********************************************************************************
+* Summary:
+*  Configures the counter of the model, stopped at 0.
+*
+* Parameters:
+*  TCPWM_Type *base                            : TCPWM0
+*  uint32_t cntNum                             : Counter number
+*  const cy_stc_tcpwm_counter_config_t *config : Period, compare, interrupts
+*
+* Return:
+*  CY_TCPWM_SUCCESS
+*
+*******************************************************************************/
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum,
+                               const cy_stc_tcpwm_counter_config_t *config)
+{
+    base->cnt_num = cntNum;
+    base->counter = 0u;
+    base->period = config->period;
+    base->compare0 = config->compare0;
+    base->intr = 0u;
+    base->intr_mask = config->interruptSources;
+    base->enabled = false;
+    base->running = false;
+
+    return CY_TCPWM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_Enable
+********************************************************************************
+* Summary:
+*  Enables the counter.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_Counter_Enable(TCPWM_Type *base, uint32_t cntNum)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    base->enabled = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_TriggerStart_Single
+********************************************************************************
+* Summary:
+*  Starts an enabled counter.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_TriggerStart_Single(TCPWM_Type *base, uint32_t cntNum)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    base->running = base->enabled;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_GetCounter
+********************************************************************************
+* Summary:
+*  Reads the counter, after the access time.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*
+* Return:
+*  Counter value
+*
+*******************************************************************************/
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type *base, uint32_t cntNum)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    tcpwm_access();
+
+    return base->counter;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_SetCounter
+********************************************************************************
+* Summary:
+*  Writes the counter, after the access time. Writing does not raise a
+*  compare match.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*  uint32_t count   : New counter value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum,
+                                 uint32_t count)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    tcpwm_access();
+    base->counter = count;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_SetCompare0Val
+********************************************************************************
+* Summary:
+*  Writes the compare value, after the access time. As on the device, a
+*  match is raised when the counter counts to the value, not when the value
+*  is set at or below the counter.
+*
+* Parameters:
+*  TCPWM_Type *base  : TCPWM0
+*  uint32_t cntNum   : Counter number
+*  uint32_t compare0 : Compare value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_Counter_SetCompare0Val(TCPWM_Type *base, uint32_t cntNum,
+                                     uint32_t compare0)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    tcpwm_access();
+    base->compare0 = compare0;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_ClearInterrupt
+********************************************************************************
+* Summary:
+*  Clears interrupt causes of the counter, after the access time.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*  uint32_t source  : CY_TCPWM_INT_ON_* causes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum,
+                             uint32_t source)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    tcpwm_access();
+    base->intr &= ~source;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_SetInterrupt
+********************************************************************************
+* Summary:
+*  Sets interrupt causes of the counter by software, after the access time,
+*  and counts the calls. An enabled cause sets the counter interrupt pending.
+*
+* Parameters:
+*  TCPWM_Type *base : TCPWM0
+*  uint32_t cntNum  : Counter number
+*  uint32_t source  : CY_TCPWM_INT_ON_* causes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_SetInterrupt(TCPWM_Type *base, uint32_t cntNum,
+                           uint32_t source)
+{
+    CY_UNUSED_PARAMETER(cntNum);
+    tcpwm_access();
+    base->sw_sets++;
+    tcpwm_raise(source);
+    dispatch_pending();
+}
+
+/*******************************************************************************
+* Function Name: pdl_shim_advance
+********************************************************************************
+* Summary:
+*  Lets virtual time pass. Called by the test, the CPU is idle, and the
+*  interrupts run when the counter raises them; their time counts towards
+*  the ticks. Called by a task in a handler, the task runs for the ticks and
+*  the interrupts it raises wait for the handler to return.
+*
+* Parameters:
+*  uint32_t ticks : Counter ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pdl_shim_advance(uint32_t ticks)
+{
+    uint64_t end = pdl_shim_tcpwm0.elapsed + ticks;
+
+    while (pdl_shim_tcpwm0.elapsed < end)
+    {
+        tcpwm_tick(1u);
+        dispatch_pending();
+    }
+}
+
+/*******************************************************************************
+* Function Name: find_irq
+********************************************************************************
+* Summary:
+*  Finds the model entry of an interrupt.
+*
+* Parameters:
+*  IRQn_Type irqn : Interrupt
+*
+* Return:
+*  The entry, NULL if no handler was registered
+*
+*******************************************************************************/
+static pdl_shim_irq_t *find_irq(IRQn_Type irqn)
+{
+    for (uint32_t i = 0u; i < pdl_shim_nvic.count; i++)
+    {
+        if (pdl_shim_nvic.irq[i].irqn == irqn)
+        {
+            return &pdl_shim_nvic.irq[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: dispatch_pending
+********************************************************************************
+* Summary:
+*  Runs the enabled pending interrupts, unless a handler is running; all
+*  interrupts have one priority and do not preempt each other.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dispatch_pending(void)
+{
+    bool ran = true;
+
+    while ((!pdl_shim_nvic.in_handler) && ran)
+    {
+        ran = false;
+        for (uint32_t i = 0u; i < pdl_shim_nvic.count; i++)
+        {
+            pdl_shim_irq_t *irq = &pdl_shim_nvic.irq[i];
+
+            if (irq->pending && irq->enabled && (NULL != irq->handler))
+            {
+                irq->pending = false;
+                pdl_shim_run_handler(irq->handler);
+                ran = true;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: tcpwm_tick
+********************************************************************************
+* Summary:
+*  Counts the counter up. A compare match or a wrap sets its interrupt cause,
+*  and an enabled cause sets the counter interrupt pending.
+*
+* Parameters:
+*  uint32_t ticks : Counter ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tcpwm_tick(uint32_t ticks)
+{
+    TCPWM_Type *base = &pdl_shim_tcpwm0;
+
+    for (uint32_t i = 0u; i < ticks; i++)
+    {
+        uint32_t raised = 0u;
+
+        base->elapsed++;
+        if (!base->running)
+        {
+            continue;
+        }
+
+        base->counter = (base->counter == base->period) ? 0u :
+                                                          (base->counter + 1u);
+        if (0u == base->counter)
+        {
+            raised |= CY_TCPWM_INT_ON_TC;
+        }
+        if (base->counter == base->compare0)
+        {
+            raised |= CY_TCPWM_INT_ON_CC0;
+        }
+        tcpwm_raise(raised);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tcpwm_raise
+********************************************************************************
+* Summary:
+*  Sets interrupt causes of the counter; an enabled cause sets the counter
+*  interrupt pending.
+*
+* Parameters:
+*  uint32_t raised : CY_TCPWM_INT_ON_* causes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tcpwm_raise(uint32_t raised)
+{
+    TCPWM_Type *base = &pdl_shim_tcpwm0;
+
+    base->intr |= raised;
+
+    if (0u != (raised & base->intr_mask))
+    {
+        pdl_shim_irq_t *irq = find_irq((IRQn_Type)(
+            (uint32_t)tcpwm_0_interrupts_512_IRQn - 512u + base->cnt_num));
+
+        if (NULL != irq)
+        {
+            irq->pending = true;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: tcpwm_access
+********************************************************************************
+* Summary:
+*  Lets the access time of a counter register pass before the access.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tcpwm_access(void)
+{
+    tcpwm_tick(pdl_shim_tcpwm0.access_ticks);
+    dispatch_pending();
+}
+
+/* [] END OF FILE */
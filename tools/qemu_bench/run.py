@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""Runs the Cortex-M7 benchmark suite under QEMU and reports instructions per
+call and code size per function.
+
+Each benchmark runs twice in the mps2-an500 machine, once with the requested
+iterations and once with none, with the insn plugin of QEMU counting the
+executed instructions. The difference divided by the iterations is the cost
+of one call, without the start-up and exit of the image. The code size of
+each function of the given firmware objects is taken from the symbol table
+of the linked image, so functions removed by --gc-sections are not listed.
+
+  run.py --elf build/bench.elf --plugin libinsn.so build/calendar.o ...
+  run.py ... --json bench.json
+  run.py ... --baseline bench.json --tolerance 2
+
+With --baseline, the exit status is 1 if any instruction count or function
+size grew by more than the tolerance, in percent. --report lists every
+change against the baseline instead, as the before/after report of the
+profile-guided build, and marks the regressions. There the code may grow
+where the profile says it pays, so only the per-call costs count; the
+exit status is 1 if one regressed, or if --build-log, the compiler output
+of the profiled build, has a missing-profile or coverage-mismatch warning.
+With --warn-only, these are reported and the exit status is 0.
+
+With --host, the image is an executable of the build host, and each
+benchmark is timed in nanoseconds per call, the best of HOST_REPEATS runs.
+With --workloads, the given benchmarks are only run, a comma-separated list
+of NAME:ITERATIONS, or all:ITERATIONS for every benchmark, to record the
+profiles of an instrumented build.
+
+Usage: run.py --elf <image> [options] <firmware objects>
+"""
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+import time
+
+HOST_REPEATS = 5
+
+INSNS = re.compile(r"insns: (\d+)")
+NM_LINE = re.compile(r"^([0-9a-fA-F]+) ([0-9a-fA-F]+) ([tTwW]) (.+)$")
+PROFILE_WARNING = re.compile(r"warning: .*(-Wmissing-profile"
+                             r"|-Wcoverage-mismatch|Missing counts"
+                             r"|coverage mismatch)")
+
+
+def run_image(args, *bench_args):
+    """Runs the image with the given arguments; returns stdout and the
+    instruction count under QEMU, or the nanoseconds taken on the host."""
+    if args.host:
+        command = [args.elf] + [str(arg) for arg in bench_args]
+    else:
+        config = "enable=on,target=native,arg=bench"
+        for arg in bench_args:
+            config += ",arg=" + str(arg)
+        command = [args.qemu, "-M", "mps2-an500", "-cpu", "cortex-m7",
+                   "-nographic", "-monitor", "none", "-serial", "none",
+                   "-semihosting-config", config, "-kernel", args.elf,
+                   "-plugin", args.plugin, "-d", "plugin"]
+    start = time.perf_counter_ns()
+    result = subprocess.run(command, capture_output=True, text=True,
+                            timeout=args.timeout, check=False)
+    elapsed = time.perf_counter_ns() - start
+    if result.returncode != 0:
+        sys.exit("%s failed for %s:\n%s" % (command[0],
+                                             " ".join(map(str, bench_args)),
+                                             result.stderr))
+    if args.host:
+        return result.stdout, elapsed
+    match = INSNS.search(result.stderr) or INSNS.search(result.stdout)
+    if match is None:
+        sys.exit("no instruction count, is %s the insn plugin?" % args.plugin)
+    return result.stdout, int(match.group(1))
+
+
+def measure(args, name, iterations):
+    """Returns the count of one run, the best of HOST_REPEATS on the host,
+    where the time varies from run to run."""
+    repeats = HOST_REPEATS if args.host else 1
+    return min(run_image(args, name, iterations)[1] for _ in range(repeats))
+
+
+def per_call(args):
+    """Returns {benchmark: instructions or nanoseconds per call}."""
+    names, _ = run_image(args)
+    results = {}
+    for name in names.split():
+        base = measure(args, name, 0)
+        total = measure(args, name, args.iterations)
+        results[name] = (total - base) / args.iterations
+    return results
+
+
+def run_workloads(args):
+    """Runs the workloads, NAME:ITERATIONS or all:ITERATIONS, without
+    measuring them."""
+    names, _ = run_image(args)
+    for workload in args.workloads.split(","):
+        name, _, iterations = workload.partition(":")
+        for bench in (names.split() if name == "all" else [name]):
+            print("%s %s" % (bench, iterations))
+            run_image(args, bench, iterations)
+
+
+def function_sizes(args):
+    """Returns {function: bytes} for the functions of the firmware objects
+    that are linked into the image."""
+    wanted = set()
+    for obj in args.objects:
+        output = subprocess.run([args.nm, "--defined-only", "-C", obj],
+                                capture_output=True, text=True,
+                                check=True).stdout
+        for line in output.splitlines():
+            fields = line.split(" ", 2)
+            if len(fields) == 3 and fields[1] in "tTwW":
+                wanted.add(fields[2])
+
+    output = subprocess.run([args.nm, "-S", "-C", "--size-sort", args.elf],
+                            capture_output=True, text=True, check=True).stdout
+    sizes = {}
+    for line in output.splitlines():
+        match = NM_LINE.match(line)
+        if match and match.group(4) in wanted:
+            sizes[match.group(4)] = int(match.group(2), 16)
+    return sizes
+
+
+def compare(kind, current, baseline, tolerance, report):
+    """Prints the entries that grew beyond the tolerance, or every entry for
+    a report with the regressions marked; returns the number that grew
+    beyond the tolerance."""
+    regressions = 0
+    for name, value in sorted(current.items()):
+        old = baseline.get(name)
+        if not old:
+            continue
+        change = (value / old - 1.0) * 100.0
+        regressed = value > old * (1.0 + tolerance / 100.0)
+        if report:
+            print("%-6s %-40s %10.1f -> %10.1f %+7.1f%%%s"
+                  % (kind, name, old, value, change,
+                     "  REGRESSION" if regressed else ""))
+        elif regressed:
+            print("REGRESSION %s %s: %.1f -> %.1f (%+.1f%%)"
+                  % (kind, name, old, value, change))
+        regressions += 1 if regressed else 0
+    return regressions
+
+
+def profile_warnings(path):
+    """Prints and returns the number of the profile warnings in a compiler
+    log."""
+    with open(path, encoding="utf-8", errors="replace") as log:
+        warnings = [line.rstrip() for line in log
+                    if PROFILE_WARNING.search(line)]
+    if warnings:
+        print()
+        print("Profile warnings of the profiled build:")
+        for line in warnings:
+            print("  " + line)
+    return len(warnings)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Cortex-M7 instruction counts and code sizes under QEMU")
+    parser.add_argument("objects", nargs="+",
+                        help="firmware objects whose functions are sized")
+    parser.add_argument("--elf", required=True, help="benchmark image")
+    parser.add_argument("--qemu", default="qemu-system-arm")
+    parser.add_argument("--plugin", default="libinsn.so",
+                        help="path of the QEMU insn plugin")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--iterations", type=int, default=1000)
+    parser.add_argument("--timeout", type=int, default=120,
+                        help="seconds per QEMU run")
+    parser.add_argument("--json", help="write the results to this file")
+    parser.add_argument("--baseline", help="results to compare against")
+    parser.add_argument("--tolerance", type=float, default=2.0,
+                        help="allowed growth in percent")
+    parser.add_argument("--report", action="store_true",
+                        help="list every change against the baseline")
+    parser.add_argument("--build-log",
+                        help="compiler output checked by --report")
+    parser.add_argument("--warn-only", action="store_true",
+                        help="a report exits with 0 despite regressions")
+    parser.add_argument("--host", action="store_true",
+                        help="the image is a host executable, timed")
+    parser.add_argument("--workloads",
+                        help="only run NAME:ITERATIONS,... (all: every one)")
+    args = parser.parse_args()
+
+    if args.workloads:
+        run_workloads(args)
+        return 0
+
+    metric = "nanoseconds" if args.host else "instructions"
+    results = {metric: per_call(args), "sizes": function_sizes(args)}
+
+    print("%-24s %12s" % ("Benchmark",
+                          "ns/call" if args.host else "insns/call"))
+    for name, value in results[metric].items():
+        print("%-24s %12.1f" % (name, value))
+    print()
+    print("%-40s %8s" % ("Function", "bytes"))
+    for name, value in sorted(results["sizes"].items(),
+                              key=lambda item: -item[1]):
+        print("%-40s %8d" % (name, value))
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as output:
+            json.dump(results, output, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as baseline_file:
+            baseline = json.load(baseline_file)
+        print()
+        regressions = compare("ns" if args.host else "insns",
+                              results[metric], baseline.get(metric, {}),
+                              args.tolerance, args.report)
+        grown = compare("bytes", results["sizes"], baseline.get("sizes", {}),
+                        args.tolerance, args.report)
+        if not args.report:
+            return 1 if regressions + grown else 0
+        warnings = profile_warnings(args.build_log) if args.build_log else 0
+        print()
+        print("%d per-call regressions beyond %.1f%%, %d functions grew, "
+              "%d profile warnings" % (regressions, args.tolerance, grown,
+                                       warnings))
+        if regressions or warnings:
+            print("WARNING: the profiles made the build worse or did not "
+                  "apply" if args.warn_only else
+                  "FAILED: the profiles made the build worse or did not apply")
+            return 0 if args.warn_only else 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,256 @@
+/******************************************************************************
+* File Name:   startup.c
+*
+* Description: Start-up code of the QEMU benchmark build for the mps2-an500
+*              machine (Cortex-M7): vector table, FPU enable, C run-time
+*              initialisation and the command line from semihosting.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Coprocessor access control, CP10 and CP11 give access to the FPU */
+#define SCB_CPACR (*(volatile uint32_t *)0xE000ED88UL)
+#define CPACR_FPU_FULL_ACCESS (0xFUL << 20u)
+
+/* Semihosting operations */
+#define SYS_GET_CMDLINE (0x15u)
+#define SYS_EXIT (0x18u)
+#define ADP_STOPPED_RUN_TIME_ERROR (0x20023UL)
+
+#define CMDLINE_SIZE (256u)
+#define MAX_ARGS (8u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern uint32_t __bss_start__;
+extern uint32_t __bss_end__;
+extern uint32_t __stack_top;
+
+static char cmdline[CMDLINE_SIZE];
+static char *arguments[MAX_ARGS + 1u];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+extern int main(int argc, char *argv[]);
+extern void __libc_init_array(void);
+extern void __libc_fini_array(void);
+extern void initialise_monitor_handles(void);
+void Reset_Handler(void);
+void _init(void);
+void _fini(void);
+static void Fault_Handler(void);
+static uint32_t semihosting_call(uint32_t operation, void *parameter);
+static int read_arguments(void);
+
+/* Core exceptions only; the benchmarks do not use interrupts */
+__attribute__((section(".vectors"), used))
+static void (*const vectors[16])(void) =
+{
+    (void (*)(void))&__stack_top,
+    Reset_Handler,
+    Fault_Handler,  /* NMI */
+    Fault_Handler,  /* HardFault */
+    Fault_Handler,  /* MemManage */
+    Fault_Handler,  /* BusFault */
+    Fault_Handler,  /* UsageFault */
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: Reset_Handler
+********************************************************************************
+* Summary:
+*  Enables the FPU, clears .bss (QEMU loads .data in place), initializes
+*  the C library and semihosting, and exits with the result of main().
+*  The destructors run at exit, which writes the profiles of the
+*  instrumented build.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Reset_Handler(void)
+{
+    SCB_CPACR |= CPACR_FPU_FULL_ACCESS;
+    __asm volatile ("dsb\n\tisb" ::: "memory");
+
+    memset(&__bss_start__, 0,
+           (size_t)((uintptr_t)&__bss_end__ - (uintptr_t)&__bss_start__));
+
+    __libc_init_array();
+    (void)atexit(__libc_fini_array);
+    initialise_monitor_handles();
+
+    int argc = read_arguments();
+    exit(main(argc, arguments));
+}
+
+/*******************************************************************************
+* Function Name: _init
+********************************************************************************
+* Summary:
+*  Called by __libc_init_array(); the constructors are in .init_array.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void _init(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: _fini
+********************************************************************************
+* Summary:
+*  Counterpart of _init(), nothing to do.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void _fini(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: Fault_Handler
+********************************************************************************
+* Summary:
+*  Stops QEMU with a run-time error, so that a fault fails the benchmark
+*  instead of hanging it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void Fault_Handler(void)
+{
+    for (;;)
+    {
+        (void)semihosting_call(SYS_EXIT, (void *)ADP_STOPPED_RUN_TIME_ERROR);
+    }
+}
+
+/*******************************************************************************
+* Function Name: semihosting_call
+********************************************************************************
+* Summary:
+*  Issues a semihosting operation.
+*
+* Parameters:
+*  uint32_t operation : SYS_* operation
+*  void *parameter    : Operation parameter
+*
+* Return:
+*  uint32_t : Result of the operation
+*
+*******************************************************************************/
+static uint32_t semihosting_call(uint32_t operation, void *parameter)
+{
+    register uint32_t r0 __asm("r0") = operation;
+    register void *r1 __asm("r1") = parameter;
+
+    __asm volatile ("bkpt 0xAB" : "+r" (r0) : "r" (r1) : "memory");
+
+    return r0;
+}
+
+/*******************************************************************************
+* Function Name: read_arguments
+********************************************************************************
+* Summary:
+*  Reads the command line given to QEMU with
+*  -semihosting-config arg=... and splits it at spaces into arguments[].
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int : Number of arguments, 0 if there is no command line
+*
+*******************************************************************************/
+static int read_arguments(void)
+{
+    struct
+    {
+        char *buffer;
+        uint32_t length;
+    } block = { cmdline, CMDLINE_SIZE - 1u };
+    int argc = 0;
+
+    if (0u != semihosting_call(SYS_GET_CMDLINE, &block))
+    {
+        return 0;
+    }
+    cmdline[block.length] = '\0';
+
+    for (char *token = strtok(cmdline, " "); (NULL != token) &&
+         ((uint32_t)argc < MAX_ARGS); token = strtok(NULL, " "))
+    {
+        arguments[argc++] = token;
+    }
+    arguments[argc] = NULL;
+
+    return argc;
+}
+
+/* [] END OF FILE */
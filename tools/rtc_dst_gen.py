@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Generates source/rtc_dst_config.h from the RTC personality in design.modus.
+
+The RTC personality stores the DST rule selected in the Device Configurator
+(dstFormat, dstStartMonth, dstStartWeek, ...). This script turns those
+parameters into a const initialiser for cy_stc_rtc_dst_t and into the
+CALENDAR_DST_* macros consumed by source/calendar.cpp, which resolves the
+per-year transition table at compile time. The personality's dst setting
+becomes RTC_DST_BOOT_ENABLE, which decides whether main() arms the rule at
+boot.
+
+Usage: rtc_dst_gen.py <design.modus> <output header>
+
+The output file is only rewritten when its content changes, so running this
+as a PREBUILD step does not trigger needless rebuilds.
+"""
+
+import sys
+import xml.etree.ElementTree as ET
+
+EDGES = (
+    ("START", "dstStart"),
+    ("STOP", "dstStop"),
+)
+
+# design.modus parameter suffix -> (macro suffix, cy_stc_rtc_dst_format_t field)
+FIELDS = (
+    ("Hour", "HOUR", "hour"),
+    ("Day", "DAY_OF_MONTH", "dayOfMonth"),
+    ("Week", "WEEK", "weekOfMonth"),
+    ("DayOfWeek", "DAY_OF_WEEK", "dayOfWeek"),
+    ("Month", "MONTH", "month"),
+)
+
+HEADER = """/******************************************************************************
+* File Name:   rtc_dst_config.h
+*
+* Description: DST rule of the RTC personality in design.modus.
+*              Generated by tools/rtc_dst_gen.py during PREBUILD. Do not edit.
+*
+* Related Document: See README.md
+*
+*******************************************************************************/
+
+#ifndef RTC_DST_CONFIG_H
+#define RTC_DST_CONFIG_H
+
+"""
+
+FOOTER = """
+#endif /* RTC_DST_CONFIG_H */
+
+/* [] END OF FILE */
+"""
+
+
+def rtc_parameters(path):
+    """Returns the parameter dictionary of the rtc personality."""
+    root = ET.parse(path).getroot()
+    for personality in root.iter():
+        if personality.tag.endswith("Personality") and \
+                personality.get("template") == "rtc":
+            params = {}
+            for param in personality.iter():
+                if param.tag.endswith("Param"):
+                    params[param.get("id")] = param.get("value")
+            return params
+    raise SystemExit("%s: no rtc personality found" % path)
+
+
+def generate(params):
+    """Returns the header text for the given personality parameters."""
+    fmt = params["dstFormat"]
+    enable = params.get("dst", "false").lower() == "true"
+    lines = [
+        "/* 1: apply the rule at boot so DST does not need to be keyed in",
+        "   again; from the dst setting of the personality */",
+        "#define RTC_DST_BOOT_ENABLE (%su)" % ("1" if enable else "0"),
+        "",
+    ]
+    init = ["#define RTC_DST_CONFIG_INIT \\", "{ \\"]
+
+    for macro, prefix in EDGES:
+        lines.append("#define CALENDAR_DST_%s_FORMAT (%s)" % (macro, fmt))
+        init.append("    .%sDst = \\" % macro.lower())
+        init.append("    { \\")
+        init.append("        .format = CALENDAR_DST_%s_FORMAT, \\" % macro)
+        for suffix, name, field in FIELDS:
+            value = params[prefix + suffix]
+            lines.append("#define CALENDAR_DST_%s_%s (%s)" %
+                         (macro, name, value if not value.isdigit()
+                          else value + "u"))
+            init.append("        .%s = CALENDAR_DST_%s_%s, \\" %
+                        (field, macro, name))
+        init.append("    }, \\")
+        lines.append("")
+
+    init.append("}")
+    return HEADER + "\n".join(lines) + "\n" + "\n".join(init) + "\n" + FOOTER
+
+
+def main(argv):
+    if len(argv) != 3:
+        raise SystemExit(__doc__)
+
+    text = generate(rtc_parameters(argv[1]))
+
+    try:
+        with open(argv[2], "r", newline="") as existing:
+            if existing.read() == text:
+                return 0
+    except OSError:
+        pass
+
+    with open(argv[2], "w", newline="\n") as output:
+        output.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
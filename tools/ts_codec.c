@@ -0,0 +1,654 @@
+/******************************************************************************
+* File Name:   ts_codec.c
+*
+* Description: Host tool of the delta-of-delta timestamp codec: decodes the
+*              streams of source/timestamp_codec.c, and encodes timestamp
+*              logs with the device encoder to measure bits per timestamp.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Usage
+********************************************************************************
+*  cc -O2 -Isource -Itools/qemu_bench/pdl_shim -o ts_codec tools/ts_codec.c \
+*     source/timestamp_codec.c
+*  ts_codec [-o timestamps.txt] stream.bin
+*  ts_codec -e [-o stream.bin] unit001.core0.log ...
+*
+*  Without -e, decodes a stream read from the device, or a file written by
+*  -e, and writes one decimal timestamp per line. The stream is decoded
+*  while it is read, in blocks of READ_BLOCK bytes, so the memory used does
+*  not depend on its length. A stream copied while the device still appends
+*  has no end marker; decoding stops at its last complete code.
+*
+*  With -e, reads the decimal timestamp at the start of each line of each
+*  input, as log_merge takes them, encodes them with the device encoder,
+*  checks that they decode back, and prints the bits per timestamp, the
+*  share of each code class and the encode time per sample on this host.
+*  -o writes the stream of the last input.
+*
+*  The statistics are printed on stderr.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "timestamp_codec.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define READ_BLOCK (64u << 10)
+
+/* Code classes: dod 0, the three short fields, raw, in stream order */
+#define CLASS_COUNT (5u)
+#define CLASS_END (CLASS_COUNT)
+
+#define NS_PER_S (1000000000.0)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Reads a stream most significant bit first */
+typedef struct
+{
+    FILE *file;
+    uint8_t block[READ_BLOCK];
+    size_t length;
+    size_t pos;
+    uint64_t bits;          /* Unread bits, low bits_left bits */
+    uint32_t bits_left;
+    uint64_t total_bits;    /* Bits consumed */
+} bit_reader_t;
+
+typedef struct
+{
+    uint64_t timestamps;
+    uint64_t classes[CLASS_COUNT];
+    uint64_t bits;
+    bool ended;             /* End marker seen */
+} decode_stats_t;
+
+/* Receives each decoded timestamp */
+typedef bool (*timestamp_sink_t)(void *context, uint64_t timestamp);
+
+typedef struct
+{
+    const uint64_t *expected;
+    uint64_t count;
+    uint64_t index;
+} verify_context_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t class_prefix_bits[CLASS_COUNT] = {1u, 2u, 3u, 4u, 5u};
+static const uint32_t class_bits[CLASS_COUNT] =
+{
+    0u, TIMESTAMP_CODEC_BITS_1, TIMESTAMP_CODEC_BITS_2,
+    TIMESTAMP_CODEC_BITS_3, TIMESTAMP_CODEC_BITS_RAW
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool read_bits(bit_reader_t *reader, uint32_t count, uint64_t *value);
+static bool decode(bit_reader_t *reader, timestamp_sink_t sink,
+                   void *context, decode_stats_t *stats);
+static bool print_timestamp(void *context, uint64_t timestamp);
+static bool verify_timestamp(void *context, uint64_t timestamp);
+static uint64_t *read_timestamps(const char *path, uint64_t *count);
+static void print_stats(const char *name, const decode_stats_t *stats);
+static int decode_file(const char *path, FILE *out);
+static int encode_file(const char *path, const char *out_path);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Decodes the stream files to one output, or encodes each log with -e.
+*
+* Parameters:
+*  int argc    : Argument count
+*  char **argv : Options and input files
+*
+* Return:
+*  0 on success, 1 on an error
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    const char *out_path = NULL;
+    bool encode = false;
+    int result = 0;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "eo:")))
+    {
+        switch (opt)
+        {
+            case 'e':
+                encode = true;
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-o output] stream.bin\n"
+                        "       %s -e [-o stream.bin] log...\n",
+                        argv[0], argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        fprintf(stderr, "%s: no inputs\n", argv[0]);
+        return 1;
+    }
+
+    if (encode)
+    {
+        for (int i = optind; (i < argc) && (0 == result); i++)
+        {
+            result = encode_file(argv[i], (i == (argc - 1)) ? out_path : NULL);
+        }
+        return result;
+    }
+
+    FILE *out = (NULL == out_path) ? stdout : fopen(out_path, "w");
+    if (NULL == out)
+    {
+        fprintf(stderr, "%s: %s: %s\n", argv[0], out_path, strerror(errno));
+        return 1;
+    }
+
+    for (int i = optind; (i < argc) && (0 == result); i++)
+    {
+        result = decode_file(argv[i], out);
+    }
+
+    if ((0 != fclose(out)) && (0 == result))
+    {
+        fprintf(stderr, "%s: write error\n", argv[0]);
+        result = 1;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: read_bits
+********************************************************************************
+* Summary:
+*  Reads the next bits of the stream, refilling the block from the file.
+*
+* Parameters:
+*  bit_reader_t *reader : Reader
+*  uint32_t count       : Bits to read, at most 32
+*  uint64_t *value      : Receives the bits, right-aligned
+*
+* Return:
+*  false at the end of the file
+*
+*******************************************************************************/
+static bool read_bits(bit_reader_t *reader, uint32_t count, uint64_t *value)
+{
+    while (reader->bits_left < count)
+    {
+        if (reader->pos == reader->length)
+        {
+            reader->length = fread(reader->block, 1u, READ_BLOCK,
+                                   reader->file);
+            reader->pos = 0u;
+            if (0u == reader->length)
+            {
+                return false;
+            }
+        }
+        reader->bits = (reader->bits << 8u) | reader->block[reader->pos++];
+        reader->bits_left += 8u;
+    }
+
+    reader->bits_left -= count;
+    *value = (reader->bits >> reader->bits_left) & ((1ULL << count) - 1u);
+    reader->total_bits += count;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: decode
+********************************************************************************
+* Summary:
+*  Decodes a stream up to its end marker, or its last complete code if it
+*  has none, and passes each timestamp to the sink.
+*
+* Parameters:
+*  bit_reader_t *reader   : Reader at the start of the stream
+*  timestamp_sink_t sink  : Receives the timestamps
+*  void *context          : Passed to the sink
+*  decode_stats_t *stats  : Receives the counts
+*
+* Return:
+*  false if the sink failed
+*
+*******************************************************************************/
+static bool decode(bit_reader_t *reader, timestamp_sink_t sink,
+                   void *context, decode_stats_t *stats)
+{
+    uint64_t high;
+    uint64_t low;
+    uint64_t timestamp;
+    /* Modulo 2^64, as the encoder computes them */
+    uint64_t delta = 0u;
+
+    memset(stats, 0, sizeof(*stats));
+    if ((!read_bits(reader, 32u, &high)) || (!read_bits(reader, 32u, &low)))
+    {
+        return true;
+    }
+    timestamp = (high << 32u) | low;
+    stats->timestamps = 1u;
+    if (!sink(context, timestamp))
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        uint32_t class = 0u;
+        uint64_t bit = 1u;
+        uint64_t field = 0u;
+        uint64_t dod;
+
+        /* The class is the number of 1 bits before the first 0, 5 at most */
+        while (class < CLASS_END)
+        {
+            if (!read_bits(reader, 1u, &bit))
+            {
+                stats->bits = reader->total_bits;
+                return true;
+            }
+            if (0u == bit)
+            {
+                break;
+            }
+            class++;
+        }
+        if ((CLASS_END == class) && (0u != bit))
+        {
+            /* '11111': end marker */
+            stats->ended = true;
+            break;
+        }
+
+        if (TIMESTAMP_CODEC_BITS_RAW == class_bits[class])
+        {
+            if ((!read_bits(reader, 32u, &high)) ||
+                (!read_bits(reader, 32u, &low)))
+            {
+                break;
+            }
+            dod = (high << 32u) | low;
+        }
+        else if (0u != class_bits[class])
+        {
+            uint32_t bits = class_bits[class];
+
+            if (!read_bits(reader, bits, &field))
+            {
+                break;
+            }
+            /* Sign-extend the two's complement field */
+            dod = (field ^ (1ULL << (bits - 1u))) - (1ULL << (bits - 1u));
+        }
+        else
+        {
+            dod = 0u;
+        }
+
+        delta += dod;
+        timestamp += delta;
+        stats->timestamps++;
+        stats->classes[class]++;
+        if (!sink(context, timestamp))
+        {
+            return false;
+        }
+    }
+
+    stats->bits = reader->total_bits;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: print_timestamp
+********************************************************************************
+* Summary:
+*  Sink that writes one timestamp per line.
+*
+* Parameters:
+*  void *context      : Output FILE
+*  uint64_t timestamp : Decoded timestamp
+*
+* Return:
+*  false on a write error
+*
+*******************************************************************************/
+static bool print_timestamp(void *context, uint64_t timestamp)
+{
+    return fprintf((FILE *)context, "%" PRIu64 "\n", timestamp) > 0;
+}
+
+/*******************************************************************************
+* Function Name: verify_timestamp
+********************************************************************************
+* Summary:
+*  Sink that compares each timestamp with the encoded one.
+*
+* Parameters:
+*  void *context      : verify_context_t
+*  uint64_t timestamp : Decoded timestamp
+*
+* Return:
+*  false on a difference
+*
+*******************************************************************************/
+static bool verify_timestamp(void *context, uint64_t timestamp)
+{
+    verify_context_t *verify = (verify_context_t *)context;
+
+    if ((verify->index >= verify->count) ||
+        (verify->expected[verify->index] != timestamp))
+    {
+        return false;
+    }
+    verify->index++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: read_timestamps
+********************************************************************************
+* Summary:
+*  Reads the decimal timestamp at the start of each line of a log; lines
+*  that do not start with one are skipped.
+*
+* Parameters:
+*  const char *path : Log file
+*  uint64_t *count  : Receives the number of timestamps
+*
+* Return:
+*  Timestamps, to be freed, or NULL on an error or if there are none
+*
+*******************************************************************************/
+static uint64_t *read_timestamps(const char *path, uint64_t *count)
+{
+    FILE *in = fopen(path, "r");
+    uint64_t *timestamps = NULL;
+    uint64_t capacity = 0u;
+    char *line = NULL;
+    size_t line_size = 0u;
+
+    *count = 0u;
+    if (NULL == in)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    while (getline(&line, &line_size, in) > 0)
+    {
+        uint64_t timestamp;
+
+        if ((line[0] < '0') || (line[0] > '9'))
+        {
+            continue;
+        }
+        timestamp = strtoull(line, NULL, 10);
+        if (*count == capacity)
+        {
+            capacity = (0u == capacity) ? 4096u : (capacity * 2u);
+            uint64_t *grown = realloc(timestamps,
+                                      capacity * sizeof(*timestamps));
+            if (NULL == grown)
+            {
+                fprintf(stderr, "%s: out of memory\n", path);
+                free(timestamps);
+                timestamps = NULL;
+                break;
+            }
+            timestamps = grown;
+        }
+        timestamps[(*count)++] = timestamp;
+    }
+
+    free(line);
+    fclose(in);
+
+    return timestamps;
+}
+
+/*******************************************************************************
+* Function Name: print_stats
+********************************************************************************
+* Summary:
+*  Prints the bits per timestamp and the share of each code class.
+*
+* Parameters:
+*  const char *name             : Stream name
+*  const decode_stats_t *stats  : Counts of the stream
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_stats(const char *name, const decode_stats_t *stats)
+{
+    uint64_t codes = (stats->timestamps > 0u) ? (stats->timestamps - 1u) : 0u;
+
+    fprintf(stderr, "%s: %" PRIu64 " timestamps, %" PRIu64 " bytes, "
+            "%.2f bits/timestamp%s\n", name, stats->timestamps,
+            (stats->bits + 7u) / 8u,
+            (stats->timestamps > 0u) ?
+            ((double)stats->bits / (double)stats->timestamps) : 0.0,
+            stats->ended ? "" : ", no end marker");
+    for (uint32_t i = 0u; (i < CLASS_COUNT) && (codes > 0u); i++)
+    {
+        fprintf(stderr, "  %2" PRIu32 "-bit codes: %6.2f%%\n",
+                class_prefix_bits[i] + class_bits[i],
+                (100.0 * (double)stats->classes[i]) / (double)codes);
+    }
+}
+
+/*******************************************************************************
+* Function Name: decode_file
+********************************************************************************
+* Summary:
+*  Decodes a stream file to one timestamp per line.
+*
+* Parameters:
+*  const char *path : Stream file
+*  FILE *out        : Output
+*
+* Return:
+*  0 on success
+*
+*******************************************************************************/
+static int decode_file(const char *path, FILE *out)
+{
+    static bit_reader_t reader;
+    decode_stats_t stats;
+
+    memset(&reader, 0, sizeof(reader));
+    reader.file = fopen(path, "rb");
+    if (NULL == reader.file)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    bool written = decode(&reader, print_timestamp, out, &stats);
+    fclose(reader.file);
+    if (!written)
+    {
+        fprintf(stderr, "%s: write error\n", path);
+        return 1;
+    }
+
+    print_stats(path, &stats);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: encode_file
+********************************************************************************
+* Summary:
+*  Encodes the timestamps of a log with the device encoder, checks that the
+*  stream decodes back to them, and prints its statistics.
+*
+* Parameters:
+*  const char *path     : Log file
+*  const char *out_path : Receives the stream if not NULL
+*
+* Return:
+*  0 on success
+*
+*******************************************************************************/
+static int encode_file(const char *path, const char *out_path)
+{
+    static bit_reader_t reader;
+    timestamp_codec_t codec;
+    decode_stats_t stats;
+    verify_context_t verify;
+    struct timespec start;
+    struct timespec end;
+    uint64_t count;
+    uint64_t *timestamps = read_timestamps(path, &count);
+
+    if (NULL == timestamps)
+    {
+        if (0u == count)
+        {
+            fprintf(stderr, "%s: no timestamps\n", path);
+        }
+        return 1;
+    }
+
+    /* The largest code is 9 bytes; the header and end marker fit in 16 */
+    size_t capacity = (size_t)(count * 9u) + 16u;
+    uint8_t *buffer = malloc(capacity);
+    if ((NULL == buffer) || (capacity > UINT32_MAX))
+    {
+        fprintf(stderr, "%s: too many timestamps\n", path);
+        free(timestamps);
+        free(buffer);
+        return 1;
+    }
+
+    timestamp_codec_init(&codec, buffer, (uint32_t)capacity);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0u; i < count; i++)
+    {
+        (void)timestamp_codec_append(&codec, timestamps[i]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint32_t size = timestamp_codec_finish(&codec);
+
+    memset(&reader, 0, sizeof(reader));
+    reader.file = fmemopen(buffer, size, "rb");
+    verify.expected = timestamps;
+    verify.count = count;
+    verify.index = 0u;
+    bool verified = (NULL != reader.file) &&
+                    decode(&reader, verify_timestamp, &verify, &stats) &&
+                    (verify.index == count) && stats.ended;
+    if (NULL != reader.file)
+    {
+        fclose(reader.file);
+    }
+
+    int result = 0;
+    if (!verified)
+    {
+        fprintf(stderr, "%s: stream does not decode back, timestamp %" PRIu64
+                "\n", path, verify.index);
+        result = 1;
+    }
+    else
+    {
+        double seconds = (double)(end.tv_sec - start.tv_sec) +
+                         ((double)(end.tv_nsec - start.tv_nsec) / NS_PER_S);
+
+        print_stats(path, &stats);
+        fprintf(stderr, "  encode: %.1f ns/timestamp on this host\n",
+                (count > 0u) ? ((seconds * NS_PER_S) / (double)count) : 0.0);
+    }
+
+    if ((0 == result) && (NULL != out_path))
+    {
+        FILE *out = fopen(out_path, "wb");
+
+        if ((NULL == out) || (size != fwrite(buffer, 1u, size, out)) ||
+            (0 != fclose(out)))
+        {
+            fprintf(stderr, "%s: %s\n", out_path, strerror(errno));
+            result = 1;
+        }
+    }
+
+    free(buffer);
+    free(timestamps);
+
+    return result;
+}
+
+/* [] END OF FILE */